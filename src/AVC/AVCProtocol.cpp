@@ -1,15 +1,32 @@
 #include "AVCProtocol.hpp"
+#include <array>
 
 namespace RocketLink {
 namespace AVC {
 
 AVCProtocol::AVCProtocol(std::shared_ptr<SCALPEL::Communicator> comm)
-    : communicator(comm), running(false) {
+    : communicator(comm),
+      parser([this](const SCALPEL::PacketView& packet, uint64_t) {
+          receivedPayload.resize(SCALPEL::Packet::MAX_PAYLOAD_LENGTH);
+          receivedPayload.resize(packet.decodePayload(
+              SCALPEL::Span<uint8_t>(receivedPayload.data(), receivedPayload.size())));
+          handleIncomingPacket(receivedPayload);
+      }),
+      reassembler(maxReassemblyMessages, maxReassemblyLength, reassemblyTimeout,
+                  [this](SCALPEL::Span<const uint8_t> message, uint8_t) { dispatchReassembled(message); }),
+      running(false) {
     registerPayloadDescriptors();
+
+    // Everything the Communicator receives comes here
+    communicator->setReceiveCallback([this](const std::vector<uint8_t>& data) { onDataReceived(data); });
 }
 
 AVCProtocol::~AVCProtocol() {
     stop();
+
+    // The Communicator may outlive this protocol, so it must not call back into it
+    communicator->stop();
+    communicator->setReceiveCallback(nullptr);
 }
 
 void AVCProtocol::start() {
@@ -21,7 +38,7 @@ void AVCProtocol::start() {
     // Start the retransmission handler thread
     retransThread = std::thread(&AVCProtocol::retransmissionHandler, this);
 
-    // Register the data received callback
+    // Received data reaches onDataReceived on the Communicator's I/O thread
     communicator->start();
 }
 
@@ -43,25 +60,9 @@ void AVCProtocol::sendCommand(const Command& command) {
     if (!command.isValid()) {
         throw std::invalid_argument("Attempting to send an invalid command");
     }
-    std::vector<uint8_t> encoded = command.encode();
-
-    // Calculate checksum
-    uint8_t crc = SCALPEL::Checksum::calculateCRC8(encoded.data(), encoded.size());
-
-    // Assemble packet
-    SCALPEL::Packet packet(encoded);
-
-    // Add checksum
-    std::vector<uint8_t> packetData = packet.assemble();
-    packetData.push_back(crc);
-
-    // Encode with COBS
-    SCALPEL::COBS::COBSResult cobsResult = cobsEncoder.encode(packetData);
-    std::vector<uint8_t> finalPacket = cobsResult.encodedPayload;
 
-    sendRawPacket(finalPacket);
-
-    // Store the command for acknowledgment tracking
+    // Store the command for acknowledgment tracking before it goes out, so
+    // an acknowledgment that arrives at once finds it
     {
         std::lock_guard<std::mutex> lock(pendingMutex);
         PendingCommand pending;
@@ -70,63 +71,47 @@ void AVCProtocol::sendCommand(const Command& command) {
         // retryCount is already initialized to 0 in the default constructor
         pendingCommands[static_cast<uint8_t>(command.getCommandNumber())] = pending;
     }
+    sendPayload(command.encode());
 }
 
-void AVCProtocol::sendTelemetry(const Telemetry& telemetry) {
-    std::vector<uint8_t> encoded = telemetry.encode();
-
-    // Calculate checksum
-    uint8_t crc = SCALPEL::Checksum::calculateCRC8(encoded.data(), encoded.size());
-
-    // Assemble packet
-    SCALPEL::Packet packet(encoded);
+void AVCProtocol::setAcknowledgmentCallback(AcknowledgmentCallback callback) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    acknowledgmentCallback = std::move(callback);
+}
 
-    // Add checksum
-    std::vector<uint8_t> packetData = packet.assemble();
-    packetData.push_back(crc);
+void AVCProtocol::sendTelemetry(const Telemetry& telemetry) {
+    sendPayload(telemetry.encode(), SCALPEL::Communicator::FrameClass::Telemetry);
+}
 
-    // Encode with COBS
-    SCALPEL::COBS::COBSResult cobsResult = cobsEncoder.encode(packetData);
-    std::vector<uint8_t> finalPacket = cobsResult.encodedPayload;
+void AVCProtocol::sendPayload(const std::vector<uint8_t>& encoded, SCALPEL::Communicator::FrameClass frameClass) {
+    if (encoded.size() <= SCALPEL::Packet::MAX_PAYLOAD_LENGTH) {
+        sendPacket(SCALPEL::Packet(encoded), frameClass);
+        return;
+    }
 
-    sendRawPacket(finalPacket);
+    // Too large for one packet: send it as fragments carrying the same header
+    std::vector<SCALPEL::Packet> fragments;
+    {
+        std::lock_guard<std::mutex> lock(fragmenterMutex);
+        fragments = fragmenter.fragment(encoded[0], encoded);
+    }
+    for (const SCALPEL::Packet& fragment : fragments) {
+        sendPacket(fragment, frameClass);
+    }
 }
 
-void AVCProtocol::sendRawPacket(const std::vector<uint8_t>& data) {
-    // SCALPEL::COBS handles framing, but Communicator manages raw data
-    communicator->send(data);
+void AVCProtocol::sendPacket(const SCALPEL::Packet& packet, SCALPEL::Communicator::FrameClass frameClass) {
+    // The packet carries its own COBS encoding and CRC, and starts with the
+    // START_BYTE the receiver's parser looks for, so it goes out as it is
+    std::array<uint8_t, SCALPEL::Packet::MAX_PACKET_LENGTH> packetData;
+    size_t packetLength = packet.assembleInto(packetData.data(), packetData.size());
+    communicator->send(SCALPEL::Span<const uint8_t>(packetData.data(), packetLength), frameClass);
 }
 
 void AVCProtocol::onDataReceived(const std::vector<uint8_t>& data) {
-    // Decode with COBS
-    try {
-        std::vector<uint8_t> decodedData = cobsDecoder.decode(data, 0); // Index managed internally
-
-        // Verify checksum
-        if (decodedData.size() < 1) {
-            std::cerr << "Received data too short after decoding." << std::endl;
-            return;
-        }
-        uint8_t receivedCrc = decodedData.back();
-        decodedData.pop_back();
-
-        // Calculate CRC
-        uint8_t calculatedCrc = SCALPEL::Checksum::calculateCRC8(decodedData.data(), decodedData.size());
-
-        // Explicitly compare the calculated CRC with the received CRC
-        if (calculatedCrc != receivedCrc) {
-            std::cerr << "Checksum validation failed. Received CRC: " << static_cast<int>(receivedCrc)
-                      << ", Calculated CRC: " << static_cast<int>(calculatedCrc) << std::endl;
-            return;
-        }
-
-        // Disassemble packet
-        SCALPEL::Packet packet = SCALPEL::Packet::disassemble(decodedData);
-
-        handleIncomingPacket(packet.getPayload());
-    } catch (const std::exception& e) {
-        std::cerr << "Error decoding received packet: " << e.what() << std::endl;
-    }
+    // The parser checks each packet and drops what fails, resyncing on the
+    // next START_BYTE
+    parser.feed(SCALPEL::Span<const uint8_t>(data.data(), data.size()));
 }
 
 void AVCProtocol::handleIncomingPacket(const std::vector<uint8_t>& data) {
@@ -146,20 +131,62 @@ void AVCProtocol::handleIncomingPacket(const std::vector<uint8_t>& data) {
     }
 }
 
+void AVCProtocol::dispatchReassembled(SCALPEL::Span<const uint8_t> message) {
+    if (message.size() < 2 || message[1] == static_cast<uint8_t>(PayloadDescriptor::FRAGMENT)) {
+        std::cerr << "Invalid reassembled message." << std::endl;
+        return;
+    }
+
+    auto it = descriptorHandlers.find(message[1]);
+    if (it != descriptorHandlers.end()) {
+        it->second(std::vector<uint8_t>(message.begin(), message.end()));
+    } else {
+        std::cerr << "Unknown payload descriptor: " << static_cast<int>(message[1]) << std::endl;
+    }
+}
+
 void AVCProtocol::handleAcknowledgment(uint8_t ackCommandNumber) {
     std::lock_guard<std::mutex> lock(pendingMutex);
     auto it = pendingCommands.find(ackCommandNumber);
     if (it != pendingCommands.end()) {
         // Command acknowledged, remove from pending
         pendingCommands.erase(it);
-        std::cout << "Command " << static_cast<int>(ackCommandNumber) << " acknowledged." << std::endl;
+        if (acknowledgmentCallback) {
+            acknowledgmentCallback(ackCommandNumber);
+        }
     } else {
         std::cerr << "Received acknowledgment for unknown command: " << static_cast<int>(ackCommandNumber) << std::endl;
     }
 }
 
+void AVCProtocol::queueAcknowledgment(const Command& command) {
+    {
+        std::lock_guard<std::mutex> lock(cvMutex);
+        acknowledgments.push_back(command);
+    }
+    cv.notify_one();
+}
+
+void AVCProtocol::sendAcknowledgment(const Command& command) {
+    // Header (1) + Descriptor (1) + Acknowledged Command Number (1), addressed back to the sender
+    CommandHeader header{command.getReceiverID(), command.getSenderID()};
+    std::vector<uint8_t> acknowledgment = {header.pack(), static_cast<uint8_t>(PayloadDescriptor::ACKNOWLEDGMENT),
+                                           static_cast<uint8_t>(command.getCommandNumber())};
+    sendPayload(acknowledgment);
+}
+
 void AVCProtocol::retransmissionHandler() {
     while (running) {
+        // Acknowledge the commands received since the last pass
+        std::vector<Command> toAcknowledge;
+        {
+            std::lock_guard<std::mutex> lock(cvMutex);
+            toAcknowledge.swap(acknowledgments);
+        }
+        for (const Command& command : toAcknowledge) {
+            sendAcknowledgment(command);
+        }
+
         auto now = std::chrono::steady_clock::now();
         std::vector<PendingCommand> toResend;
 
@@ -188,23 +215,28 @@ void AVCProtocol::retransmissionHandler() {
         for (const auto& pending : toResend) {
             std::cout << "Resending Command " << static_cast<int>(pending.command.getCommandNumber())
                       << " (Retry " << pending.retryCount << ")" << std::endl;
-            sendRawPacket(pending.command.encode());
+            sendPayload(pending.command.encode());
+        }
+
+        // Drop partial messages whose missing fragments never arrived
+        {
+            std::lock_guard<std::mutex> lock(protocolMutex);
+            reassembler.expire(now);
         }
 
-        // Wait for the next interval or stop signal
+        // Wait for the next interval, a command to acknowledge or stop signal
         std::unique_lock<std::mutex> lock(cvMutex);
-        cv.wait_for(lock, retryInterval, [this]() { return !running.load(); });
+        cv.wait_for(lock, retryInterval, [this]() { return !running.load() || !acknowledgments.empty(); });
     }
 }
 
 void AVCProtocol::registerPayloadDescriptors() {
     // Register Command Descriptor
     descriptorHandlers[static_cast<uint8_t>(PayloadDescriptor::COMMAND)] = 
-        [](const std::vector<uint8_t>& data) {
+        [this](const std::vector<uint8_t>& data) {
             try {
                 Command cmd = Command::decode(data);
-                std::cout << "Received Command from " << static_cast<int>(cmd.getSenderID()) 
-                          << " to " << static_cast<int>(cmd.getReceiverID()) << std::endl;
+                this->queueAcknowledgment(cmd);
                 // Process the command as needed
                 // For example, execute the command actions
             } catch (const std::exception& e) {
@@ -250,26 +282,25 @@ void AVCProtocol::registerPayloadDescriptors() {
             this->handleAcknowledgment(ackCmdNum);
         };
 
+    // Register Fragment Descriptor; completed messages go to their own handler
+    descriptorHandlers[static_cast<uint8_t>(PayloadDescriptor::FRAGMENT)] =
+        [this](const std::vector<uint8_t>& data) {
+            if (!reassembler.accept(data)) {
+                std::cerr << "Invalid fragment." << std::endl;
+            }
+        };
+
     // Add more descriptors and handlers as needed
 }
 
-std::vector<uint8_t> AVCProtocol::encodeCommand(const Command& /* command */) {
-    // Implement the encoding logic here
-    // This is a placeholder implementation
-    std::vector<uint8_t> encodedData;
-    // ... encoding logic ...
-    return encodedData;
+std::vector<uint8_t> AVCProtocol::encodeCommand(const Command& command) {
+    return command.encode();
 }
 
 Telemetry AVCProtocol::decodeTelemetry(const SCALPEL::Packet& packet) {
     // Get the payload from the packet
     std::vector<uint8_t> data = packet.getPayloadVector();
-
-    // Implement the decoding logic here
-    // This is a placeholder implementation
-    Telemetry decodedTelemetry;
-    // ... decoding logic ...
-    return decodedTelemetry;
+    return Telemetry::decode(data);
 }
 
 } // namespace AVC
@@ -3,8 +3,9 @@
 
 #include "Command.hpp"
 #include "Telemetry.hpp"
+#include "Fragmentation.hpp"
 #include "SCALPEL/Communicator.hpp"
-#include "SCALPEL/COBS.hpp"
+#include "SCALPEL/FrameParser.hpp"
 #include "SCALPEL/Packet.hpp"
 #include <cstdint>
 #include <vector>
@@ -23,12 +24,25 @@ namespace AVC {
 
 /**
  * @brief Class implementing the AVC protocol logic.
+ *
+ * Messages go out as SCALPEL packets on the Communicator, and the packets
+ * found in what it receives are dispatched by payload descriptor. Received
+ * commands are acknowledged, and commands sent that are not acknowledged in
+ * time are sent again.
  */
 class AVCProtocol {
 public:
+    /**
+     * @brief Type alias for the acknowledgment callback function.
+     */
+    using AcknowledgmentCallback = std::function<void(uint8_t commandNumber)>;
+
     /**
      * @brief Constructs the AVCProtocol with dependencies.
+     *        Takes over the Communicator's receive callback, so the Communicator
+     *        must be stopped.
      * @param communicator Pointer to the SCALPEL Communicator interface.
+     * @throws std::logic_error if the Communicator is running.
      */
     AVCProtocol(std::shared_ptr<SCALPEL::Communicator> communicator);
 
@@ -59,6 +73,12 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Sets the function called when a command sent is acknowledged; set it before start().
+     * @param callback Called on the Communicator's I/O thread with the acknowledged command number.
+     */
+    void setAcknowledgmentCallback(AcknowledgmentCallback callback);
+
     /**
      * @brief Encodes a Command.
      * @param command The Command to encode.
@@ -87,18 +107,47 @@ private:
     void handleAcknowledgment(uint8_t ackCommandNumber);
 
     /**
-     * @brief Manages retransmission of unacknowledged commands.
+     * @brief Sends queued acknowledgments and manages retransmission of unacknowledged commands.
      */
     void retransmissionHandler();
 
     /**
-     * @brief Sends a raw packet via the SCALPEL layer.
-     * @param data The raw packet data.
+     * @brief Queues an acknowledgment of a received command for the retransmission thread.
+     * @param command The command received.
+     */
+    void queueAcknowledgment(const Command& command);
+
+    /**
+     * @brief Sends the acknowledgment of a received command back to its sender.
+     * @param command The command received.
      */
-    void sendRawPacket(const std::vector<uint8_t>& data);
+    void sendAcknowledgment(const Command& command);
+
+    /**
+     * @brief Sends an encoded AVC message, fragmenting it if it does not fit one packet.
+     * @param encoded The encoded message.
+     * @param frameClass Telemetry may be dropped when the send queue is full.
+     */
+    void sendPayload(const std::vector<uint8_t>& encoded,
+                     SCALPEL::Communicator::FrameClass frameClass = SCALPEL::Communicator::FrameClass::Command);
+
+    /**
+     * @brief Assembles a SCALPEL packet and sends it via the Communicator.
+     * @param packet The packet to send.
+     * @param frameClass Traffic class passed on to the Communicator.
+     */
+    void sendPacket(const SCALPEL::Packet& packet, SCALPEL::Communicator::FrameClass frameClass);
+
+    /**
+     * @brief Passes a reassembled message to the handler for its descriptor.
+     *        Called with protocolMutex held.
+     * @param message The reassembled message.
+     */
+    void dispatchReassembled(SCALPEL::Span<const uint8_t> message);
 
     /**
      * @brief Processes received data from the Communicator.
+     *        Called on its I/O thread; packets may be split across calls.
      * @param data The received raw data.
      */
     void onDataReceived(const std::vector<uint8_t>& data);
@@ -110,8 +159,13 @@ private:
 
     // Dependency on SCALPEL Communicator
     std::shared_ptr<SCALPEL::Communicator> communicator;
-    SCALPEL::COBS cobsEncoder;
-    SCALPEL::COBS cobsDecoder;
+
+    // Finds packets in the received byte stream; only used on the I/O thread
+    SCALPEL::FrameParser parser;
+    std::vector<uint8_t> receivedPayload;
+
+    // Called when a pending command is acknowledged
+    AcknowledgmentCallback acknowledgmentCallback;
 
     // Mapping of payload descriptors to handler functions
     std::unordered_map<uint8_t, std::function<void(const std::vector<uint8_t>&)>> descriptorHandlers;
@@ -135,12 +189,25 @@ private:
     const int maxRetries = 5;
     const std::chrono::milliseconds retryInterval = std::chrono::milliseconds(500);
 
+    // Fragmentation of messages larger than one packet
+    const size_t maxReassemblyMessages = 8;
+    const size_t maxReassemblyLength = 4096;
+    const std::chrono::milliseconds reassemblyTimeout = std::chrono::milliseconds(5000);
+    Fragmenter fragmenter;
+    std::mutex fragmenterMutex;
+    Reassembler reassembler; // Guarded by protocolMutex
+
     // Thread management
     std::thread retransThread;
     std::atomic<bool> running;
     std::condition_variable cv;
     std::mutex cvMutex;
 
+    // Received commands to acknowledge, guarded by cvMutex. Sent from the
+    // retransmission thread, since the I/O thread would wait on itself if it
+    // found the send queue full
+    std::vector<Command> acknowledgments;
+
     /**
      * @brief Calculates the CRC-8 checksum for the given data.
      * 
@@ -49,7 +49,7 @@ Command Command::decode(const std::vector<uint8_t>& data) {
     CommandNumber cmdNumber = static_cast<CommandNumber>(data[2]);
 
     uint8_t payloadLength = data[3];
-    if (data.size() < 4 + payloadLength) {
+    if (data.size() < 4u + payloadLength) {
         throw std::invalid_argument("Data does not contain full payload.");
     }
 
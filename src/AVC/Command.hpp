@@ -25,6 +25,7 @@ enum class CommandNumber : uint8_t {
 enum class PayloadDescriptor : uint8_t {
     COMMAND = 0x01,
     ACKNOWLEDGMENT = 0x02,
+    FRAGMENT = 0x03,       ///< Part of a message too large for one packet.
     // Add other descriptors here
 };
 
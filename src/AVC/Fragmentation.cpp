@@ -0,0 +1,161 @@
+#include "Fragmentation.hpp"
+#include "Command.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace RocketLink {
+namespace AVC {
+
+std::vector<SCALPEL::Packet> Fragmenter::fragment(uint8_t header, SCALPEL::Span<const uint8_t> message) {
+    if (message.empty() || message.size() > FragmentFormat::MAX_MESSAGE_LENGTH) {
+        throw std::length_error("Message length out of range for fragmentation.");
+    }
+
+    uint8_t messageID = nextMessageID++;
+    std::vector<SCALPEL::Packet> fragments;
+    fragments.reserve(fragmentCount(message.size()));
+
+    uint8_t payload[SCALPEL::Packet::MAX_PAYLOAD_LENGTH];
+    payload[0] = header;
+    payload[1] = static_cast<uint8_t>(PayloadDescriptor::FRAGMENT);
+    payload[2] = messageID;
+    payload[5] = static_cast<uint8_t>(message.size() >> 8);
+    payload[6] = static_cast<uint8_t>(message.size() & 0xFF);
+
+    for (size_t offset = 0; offset < message.size(); offset += FragmentFormat::DATA_LENGTH) {
+        size_t length = std::min(FragmentFormat::DATA_LENGTH, message.size() - offset);
+        payload[3] = static_cast<uint8_t>(offset >> 8);
+        payload[4] = static_cast<uint8_t>(offset & 0xFF);
+        std::copy_n(message.data() + offset, length, payload + FragmentFormat::HEADER_LENGTH);
+        fragments.emplace_back(SCALPEL::Span<const uint8_t>(payload, FragmentFormat::HEADER_LENGTH + length));
+    }
+
+    return fragments;
+}
+
+Reassembler::Reassembler(size_t maxMessages, size_t maxMessageLength, Clock::duration timeout, MessageCallback onMessage)
+    : maxMessageLength(maxMessageLength),
+      maxFragments(Fragmenter::fragmentCount(maxMessageLength)),
+      timeout(timeout),
+      onMessage(std::move(onMessage)) {
+    if (maxMessages == 0) {
+        throw std::invalid_argument("Reassembler needs at least one slot.");
+    }
+    if (maxMessageLength == 0 || maxMessageLength > FragmentFormat::MAX_MESSAGE_LENGTH) {
+        throw std::invalid_argument("Reassembler message length out of range.");
+    }
+    slots.resize(maxMessages);
+    data.resize(maxMessages * maxMessageLength);
+    received.resize(maxMessages * maxFragments);
+}
+
+bool Reassembler::accept(SCALPEL::Span<const uint8_t> fragment, Clock::time_point now) {
+    if (fragment.size() <= FragmentFormat::HEADER_LENGTH ||
+        fragment[1] != static_cast<uint8_t>(PayloadDescriptor::FRAGMENT)) {
+        stats.fragmentsRejected++;
+        return false;
+    }
+
+    uint8_t header = fragment[0];
+    uint8_t messageID = fragment[2];
+    size_t offset = static_cast<size_t>(fragment[3]) << 8 | fragment[4];
+    size_t totalLength = static_cast<size_t>(fragment[5]) << 8 | fragment[6];
+    size_t length = fragment.size() - FragmentFormat::HEADER_LENGTH;
+
+    // Fragments are cut at fixed boundaries; anything else is corrupt
+    if (totalLength == 0 || totalLength > maxMessageLength || offset >= totalLength ||
+        offset % FragmentFormat::DATA_LENGTH != 0 ||
+        length != std::min(FragmentFormat::DATA_LENGTH, totalLength - offset)) {
+        stats.fragmentsRejected++;
+        return false;
+    }
+
+    Slot* slot = findSlot(header, messageID);
+    if (slot != nullptr && slot->totalLength != totalLength) {
+        // A new message reusing the ID of a stale one
+        release(*slot);
+        stats.messagesEvicted++;
+        slot = nullptr;
+    }
+    if (slot == nullptr) {
+        slot = claimSlot(now);
+        slot->active = true;
+        slot->header = header;
+        slot->messageID = messageID;
+        slot->totalLength = static_cast<uint16_t>(totalLength);
+        slot->firstSeen = now;
+    }
+
+    size_t index = static_cast<size_t>(slot - slots.data());
+    size_t fragmentIndex = offset / FragmentFormat::DATA_LENGTH;
+    uint8_t& seen = received[index * maxFragments + fragmentIndex];
+    if (seen) {
+        stats.fragmentsDuplicate++;
+        return true;
+    }
+    seen = 1;
+    stats.fragmentsAccepted++;
+
+    uint8_t* message = data.data() + index * maxMessageLength;
+    std::copy_n(fragment.data() + FragmentFormat::HEADER_LENGTH, length, message + offset);
+
+    if (++slot->fragmentsReceived == Fragmenter::fragmentCount(totalLength)) {
+        // Release first so a throwing callback cannot wedge the slot; its
+        // data stays intact until the slot is claimed again
+        release(*slot);
+        stats.messagesCompleted++;
+        if (onMessage) {
+            onMessage(SCALPEL::Span<const uint8_t>(message, totalLength), header);
+        }
+    }
+    return true;
+}
+
+void Reassembler::expire(Clock::time_point now) {
+    for (Slot& slot : slots) {
+        if (slot.active && now - slot.firstSeen >= timeout) {
+            release(slot);
+            stats.messagesTimedOut++;
+        }
+    }
+}
+
+size_t Reassembler::pending() const {
+    return static_cast<size_t>(std::count_if(slots.begin(), slots.end(), [](const Slot& slot) { return slot.active; }));
+}
+
+Reassembler::Slot* Reassembler::findSlot(uint8_t header, uint8_t messageID) {
+    for (Slot& slot : slots) {
+        if (slot.active && slot.header == header && slot.messageID == messageID) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+Reassembler::Slot* Reassembler::claimSlot(Clock::time_point now) {
+    expire(now);
+
+    Slot* oldest = &slots.front();
+    for (Slot& slot : slots) {
+        if (!slot.active) {
+            return &slot;
+        }
+        if (slot.firstSeen < oldest->firstSeen) {
+            oldest = &slot;
+        }
+    }
+    release(*oldest);
+    stats.messagesEvicted++;
+    return oldest;
+}
+
+void Reassembler::release(Slot& slot) {
+    size_t index = static_cast<size_t>(&slot - slots.data());
+    std::fill_n(received.begin() + static_cast<std::ptrdiff_t>(index * maxFragments), maxFragments, uint8_t{0});
+    slot.active = false;
+    slot.fragmentsReceived = 0;
+}
+
+} // namespace AVC
+} // namespace RocketLink
@@ -0,0 +1,148 @@
+#ifndef ROCKETLINK_AVC_FRAGMENTATION_HPP
+#define ROCKETLINK_AVC_FRAGMENTATION_HPP
+
+#include "SCALPEL/Packet.hpp"
+#include "SCALPEL/Span.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace RocketLink {
+namespace AVC {
+
+/**
+ * @brief Layout of a fragment, carried as the payload of one SCALPEL packet.
+ *
+ * | Header (1) | FRAGMENT descriptor (1) | Message ID (1) | Offset (2) | Total length (2) | Data (up to 21) |
+ *
+ * Offset and total length are big-endian byte counts into the original
+ * message, which is itself an encoded AVC message (a Command with a long
+ * payload, a config blob, a log dump, ...). Every fragment but the last
+ * carries exactly DATA_LENGTH bytes.
+ */
+struct FragmentFormat {
+    static constexpr size_t HEADER_LENGTH = 7;
+    static constexpr size_t DATA_LENGTH = SCALPEL::Packet::MAX_PAYLOAD_LENGTH - HEADER_LENGTH;
+    static constexpr size_t MAX_MESSAGE_LENGTH = 0xFFFF;
+};
+
+/**
+ * @brief Splits messages too large for one SCALPEL packet into fragments.
+ */
+class Fragmenter {
+public:
+    /**
+     * @brief Splits a message into fragment packets.
+     *
+     * Each call uses the next message ID, so the receiver can tell
+     * consecutive messages from the same sender apart.
+     *
+     * @param header Packed sender and receiver IDs, copied into every fragment.
+     * @param message The message to split, 1 to FragmentFormat::MAX_MESSAGE_LENGTH bytes.
+     * @return The fragments, in offset order.
+     * @throws std::length_error if the message is empty or too long.
+     */
+    std::vector<SCALPEL::Packet> fragment(uint8_t header, SCALPEL::Span<const uint8_t> message);
+
+    /**
+     * @brief Number of fragments a message of the given length needs.
+     */
+    static size_t fragmentCount(size_t messageLength) {
+        return (messageLength + FragmentFormat::DATA_LENGTH - 1) / FragmentFormat::DATA_LENGTH;
+    }
+
+private:
+    uint8_t nextMessageID = 0;
+};
+
+/**
+ * @brief Reassembles fragmented messages in a fixed amount of memory.
+ *
+ * Holds at most maxMessages partial messages of at most maxMessageLength
+ * bytes each, all allocated up front. Fragments may arrive in any order
+ * and more than once. A partial message is evicted when it has not
+ * completed within the timeout, or, when every slot is busy, to make room
+ * for a new message (oldest first).
+ */
+class Reassembler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Called with each completed message and the header of its fragments.
+     *        The message view is only valid for the duration of the call.
+     */
+    using MessageCallback = std::function<void(SCALPEL::Span<const uint8_t> message, uint8_t header)>;
+
+    /**
+     * @brief Counters describing what happened to received fragments.
+     */
+    struct Stats {
+        uint64_t fragmentsAccepted = 0;  ///< Fragments stored in a partial message.
+        uint64_t fragmentsDuplicate = 0; ///< Fragments already received.
+        uint64_t fragmentsRejected = 0;  ///< Malformed or oversized fragments.
+        uint64_t messagesCompleted = 0;  ///< Messages passed to the callback.
+        uint64_t messagesTimedOut = 0;   ///< Partial messages evicted by expire().
+        uint64_t messagesEvicted = 0;    ///< Partial messages evicted to free a slot.
+    };
+
+    /**
+     * @brief Allocates the reassembly table.
+     * @param maxMessages Partial messages held at once.
+     * @param maxMessageLength Longest message accepted, at most FragmentFormat::MAX_MESSAGE_LENGTH.
+     * @param timeout How long a partial message may wait for its missing fragments.
+     * @param onMessage Callback for completed messages.
+     * @throws std::invalid_argument if maxMessages or maxMessageLength is out of range.
+     */
+    Reassembler(size_t maxMessages, size_t maxMessageLength, Clock::duration timeout, MessageCallback onMessage);
+
+    /**
+     * @brief Stores one fragment, invoking the callback if it completes its message.
+     * @param fragment Payload of a SCALPEL packet with the FRAGMENT descriptor.
+     * @param now Arrival time, used for timeouts.
+     * @return false if the fragment was rejected as malformed or oversized.
+     */
+    bool accept(SCALPEL::Span<const uint8_t> fragment, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Evicts partial messages that have waited longer than the timeout.
+     * @param now Current time.
+     */
+    void expire(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Number of partial messages currently held.
+     */
+    size_t pending() const;
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Slot {
+        bool active = false;
+        uint8_t header = 0;
+        uint8_t messageID = 0;
+        uint16_t totalLength = 0;
+        size_t fragmentsReceived = 0;
+        Clock::time_point firstSeen;
+    };
+
+    Slot* findSlot(uint8_t header, uint8_t messageID);
+    Slot* claimSlot(Clock::time_point now);
+    void release(Slot& slot);
+
+    size_t maxMessageLength;
+    size_t maxFragments;
+    Clock::duration timeout;
+    MessageCallback onMessage;
+    std::vector<Slot> slots;
+    std::vector<uint8_t> data;     ///< maxMessageLength bytes per slot.
+    std::vector<uint8_t> received; ///< One flag per fragment per slot.
+    Stats stats;
+};
+
+} // namespace AVC
+} // namespace RocketLink
+
+#endif // ROCKETLINK_AVC_FRAGMENTATION_HPP
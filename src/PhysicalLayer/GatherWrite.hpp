@@ -0,0 +1,42 @@
+#ifndef ROCKETLINK_RADIO_GATHERWRITE_HPP
+#define ROCKETLINK_RADIO_GATHERWRITE_HPP
+
+#include "SCALPEL/GatherFrame.hpp"
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/write.hpp>
+#include <array>
+
+namespace RocketLink {
+namespace Radio {
+
+/**
+ * @brief Writes a gather frame to an Asio stream as one buffer sequence, so the
+ *        segments go out without being copied into a contiguous buffer first.
+ * @param stream The stream to write to, such as a serial port.
+ * @param frame The frame to write.
+ * @return Number of bytes written.
+ * @throws boost::system::system_error if the write fails.
+ */
+template <typename SyncWriteStream>
+size_t writeGatherFrame(SyncWriteStream& stream, const SCALPEL::GatherFrame& frame) {
+    // Minimal buffer sequence over the first segmentCount() buffers
+    struct Buffers {
+        const boost::asio::const_buffer* first;
+        const boost::asio::const_buffer* last;
+        const boost::asio::const_buffer* begin() const { return first; }
+        const boost::asio::const_buffer* end() const { return last; }
+    };
+
+    std::array<boost::asio::const_buffer, SCALPEL::GatherFrame::MAX_SEGMENTS> buffers;
+    const size_t count = frame.segmentCount();
+    for (size_t i = 0; i < count; ++i) {
+        SCALPEL::Span<const uint8_t> segment = frame.segment(i);
+        buffers[i] = boost::asio::const_buffer(segment.data(), segment.size());
+    }
+    return boost::asio::write(stream, Buffers{buffers.data(), buffers.data() + count});
+}
+
+} // namespace Radio
+} // namespace RocketLink
+
+#endif // ROCKETLINK_RADIO_GATHERWRITE_HPP
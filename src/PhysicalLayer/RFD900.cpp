@@ -1,5 +1,9 @@
 #include "RFD900.hpp"
 #include "SCALPEL/Packet.hpp"
+#include "SCALPEL/PacketView.hpp"
+#include "SCALPEL/FrameParser.hpp"
+#include "SCALPEL/GatherFrame.hpp"
+#include "GatherWrite.hpp"
 #include <boost/asio/read_until.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/bind.hpp>
@@ -7,10 +11,42 @@
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <array>
 
 namespace RocketLink {
 namespace Radio {
 
+namespace {
+
+// Frame CRC over bytes, continuing from crc
+uint16_t crcUpdate(uint16_t crc, SCALPEL::Span<const uint8_t> bytes) {
+    for (uint8_t byte : bytes) {
+        crc ^= byte << 8;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// Append the MAVLink v1 header for a payload of dataLength bytes, returning
+// the frame CRC over it
+uint16_t appendHeader(SCALPEL::GatherFrame& frame, size_t dataLength) {
+    SCALPEL::Span<uint8_t> header = frame.reserve(6);
+    header[0] = 0xFE; // MAVLink v1 start byte
+    header[1] = static_cast<uint8_t>(dataLength);
+    header[2] = 0; // Sequence number (not used in this context)
+    header[3] = 1; // System ID (arbitrary)
+    header[4] = 1; // Component ID (arbitrary)
+    header[5] = 0; // Message ID (0 for custom data)
+
+    // Calculate CRC (simplified version, replace with actual MAVLink CRC if
+    // needed), accumulated as each segment is added
+    return crcUpdate(0xFFFF, header);
+}
+
+} // namespace
+
 RFD900::RFD900(const std::string& port, unsigned int baudRate)
     : serialPort(ioService), running(false), netID(25), 
       frequencyMin(915000), frequencyMax(928000), numChannels(20), dutyCycle(100) {
@@ -122,33 +158,65 @@ void RFD900::getStatus(RadioStatus& status) {
 }
 
 void RFD900::sendPacket(const SCALPEL::Packet& packet) {
-    std::vector<uint8_t> data = packet.assemble();
-    
-    // Add MAVLink framing
-    std::vector<uint8_t> framedData;
-    framedData.push_back(0xFE); // MAVLink v1 start byte
-    framedData.push_back(data.size());
-    framedData.push_back(0); // Sequence number (not used in this context)
-    framedData.push_back(1); // System ID (arbitrary)
-    framedData.push_back(1); // Component ID (arbitrary)
-    framedData.push_back(0); // Message ID (0 for custom data)
-    framedData.insert(framedData.end(), data.begin(), data.end());
-
-    // Calculate CRC (simplified version, replace with actual MAVLink CRC if needed)
-    uint16_t crc = 0xFFFF;
-    for (const auto& byte : framedData) {
-        crc ^= byte << 8;
-        for (int i = 0; i < 8; ++i) {
-            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
-        }
+    sendPackets(SCALPEL::Span<const SCALPEL::Packet>(&packet, 1));
+}
+
+void RFD900::sendPackets(SCALPEL::Span<const SCALPEL::Packet> packets) {
+    if (interleavePackets(packets)) {
+        std::lock_guard<std::mutex> lock(statusMutex);
+        currentStatus.packetsSent += static_cast<uint32_t>(packets.size());
+        return;
+    }
+    while (!packets.empty()) {
+        size_t count = packetsThatFit(packets, MAX_FRAME_PAYLOAD_LENGTH);
+        sendFrame(packets.first(count));
+        packets = packets.subspan(count);
+    }
+}
+
+void RFD900::sendFrame(SCALPEL::Span<const SCALPEL::Packet> packets) {
+    // MAVLink header, one segment per SCALPEL packet and a 2-byte CRC,
+    // written with a single gather write
+    size_t dataLength = 0;
+    for (const SCALPEL::Packet& packet : packets) {
+        dataLength += packet.getAssembledLength();
+    }
+    if (dataLength > MAX_FRAME_PAYLOAD_LENGTH) {
+        throw std::length_error("Packets exceed the MAVLink payload capacity.");
+    }
+
+    SCALPEL::GatherFrame frame;
+    uint16_t crc = appendHeader(frame, dataLength);
+    for (const SCALPEL::Packet& packet : packets) {
+        crc = crcUpdate(crc, frame.appendPacket(packet));
     }
-    framedData.push_back(crc & 0xFF);
-    framedData.push_back((crc >> 8) & 0xFF);
+    writeFrame(frame, crc);
+
+    std::lock_guard<std::mutex> lock(statusMutex);
+    currentStatus.packetsSent += static_cast<uint32_t>(packets.size());
+}
+
+void RFD900::sendPayload(const SCALPEL::GatherFrame& payload) {
+    if (payload.size() > MAX_FRAME_PAYLOAD_LENGTH) {
+        throw std::length_error("Payload exceeds the MAVLink payload capacity.");
+    }
+
+    // The payload's segments are referenced, not copied
+    SCALPEL::GatherFrame frame;
+    uint16_t crc = appendHeader(frame, payload.size());
+    for (size_t i = 0; i < payload.segmentCount(); ++i) {
+        frame.appendReference(payload.segment(i));
+        crc = crcUpdate(crc, payload.segment(i));
+    }
+    writeFrame(frame, crc);
+}
+
+void RFD900::writeFrame(SCALPEL::GatherFrame& frame, uint16_t crc) {
+    uint8_t trailer[2] = {static_cast<uint8_t>(crc & 0xFF), static_cast<uint8_t>((crc >> 8) & 0xFF)};
+    frame.append(trailer);
 
     try {
-        boost::asio::write(serialPort, boost::asio::buffer(framedData));
-        std::lock_guard<std::mutex> lock(statusMutex);
-        currentStatus.packetsSent++;
+        writeGatherFrame(serialPort, frame);
     } catch (const boost::system::system_error& e) {
         std::lock_guard<std::mutex> lock(statusMutex);
         currentStatus.transmissionErrors++;
@@ -181,10 +249,12 @@ void RFD900::readLoop() {
     while (running) {
         try {
             size_t bytesRead = serialPort.read_some(boost::asio::buffer(buffer));
-            if (bytesRead > 0) {
-                std::vector<uint8_t> data(buffer.begin(), buffer.begin() + bytesRead);
-                processFrame(data);
-            }
+
+            // A frame may span reads, so bytes after the last complete frame
+            // stay in readBuffer and the next read is appended to them
+            readBuffer.insert(readBuffer.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(bytesRead));
+            size_t consumed = processFrames(SCALPEL::Span<const uint8_t>(readBuffer.data(), readBuffer.size()));
+            readBuffer.erase(readBuffer.begin(), readBuffer.begin() + static_cast<std::ptrdiff_t>(consumed));
         } catch (const boost::system::system_error& e) {
             if (running) {
                 std::lock_guard<std::mutex> lock(statusMutex);
@@ -194,32 +264,65 @@ void RFD900::readLoop() {
     }
 }
 
-void RFD900::processFrame(const std::vector<uint8_t>& data) {
+size_t RFD900::processFrames(SCALPEL::Span<const uint8_t> data) {
     // Simple MAVLink frame parsing (replace with full MAVLink parser if needed)
-    if (data.size() < 8) return; // Minimum MAVLink frame size
-
-    for (size_t i = 0; i < data.size() - 8; ++i) {
-        if (data[i] == 0xFE) { // MAVLink v1 start byte
-            size_t length = data[i + 1];
-            if (i + length + 8 <= data.size()) {
-                // Extract payload
-                std::vector<uint8_t> payload(data.begin() + i + 6, data.begin() + i + 6 + length);
-
-                try {
-                    SCALPEL::Packet packet = SCALPEL::Packet::disassemble(payload);
-                    
-                    std::lock_guard<std::mutex> lock(queueMutex);
-                    packetQueue.push(packet);
-                    queueCondVar.notify_one();
-                } catch (const std::exception& e) {
-                    std::lock_guard<std::mutex> lock(statusMutex);
-                    currentStatus.receptionErrors++;
-                }
-
-                i += length + 7; // Skip to end of frame
-            }
+    size_t i = 0;
+    while (i < data.size()) {
+        if (data[i] != 0xFE) { // MAVLink v1 start byte
+            ++i;
+            continue;
+        }
+        if (data.size() - i < 2) {
+            break; // Length byte not read yet
+        }
+        size_t length = data[i + 1];
+        size_t frameLength = length + 8; // Header, payload and CRC
+        if (data.size() - i < frameLength) {
+            break; // Rest of the frame not read yet
+        }
+
+        // A start byte inside other data, or a damaged frame, fails the CRC;
+        // scanning resumes after it so a real frame there is still found
+        SCALPEL::Span<const uint8_t> frame = data.subspan(i, frameLength);
+        uint16_t crc = crcUpdate(0xFFFF, frame.first(6 + length));
+        if (frame[6 + length] != (crc & 0xFF) || frame[7 + length] != ((crc >> 8) & 0xFF)) {
+            std::lock_guard<std::mutex> lock(statusMutex);
+            currentStatus.receptionErrors++;
+            ++i;
+            continue;
+        }
+
+        if (!receivePayload(frame.subspan(6, length))) {
+            std::lock_guard<std::mutex> lock(statusMutex);
+            currentStatus.receptionErrors++;
         }
+        i += frameLength;
+    }
+    return i;
+}
+
+bool RFD900::receivePayload(SCALPEL::Span<const uint8_t> payload) {
+    // The payload holds one or more packets back to back, or a chunk of an
+    // interleaved block, which need not complete one
+    size_t received = 0;
+    bool accepted = deinterleave(payload, [this, &received](SCALPEL::Span<const uint8_t> data) {
+        received += queuePackets(data);
+    });
+    return accepted && (received != 0 || getInterleaveDepth() > 1);
+}
+
+size_t RFD900::queuePackets(SCALPEL::Span<const uint8_t> payload) {
+    size_t received = 0;
+    SCALPEL::FrameParser parser([this, &received](const SCALPEL::PacketView& view, uint64_t) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        packetQueue.push(view.toPacket());
+        received++;
+    }, getHeaderProtection());
+    parser.feed(payload);
+    if (received != 0) {
+        queueCondVar.notify_all();
     }
+    return received;
 }
 
 void RFD900::sendCommand(const std::string& command, std::string& response) {
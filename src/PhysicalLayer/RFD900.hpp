@@ -2,6 +2,7 @@
 #define ROCKETLINK_RADIO_RFD900_HPP
 
 #include "RadioInterface.hpp"
+#include "SCALPEL/GatherFrame.hpp"
 #include <boost/asio.hpp>
 #include <thread>
 #include <atomic>
@@ -43,6 +44,23 @@ public:
      */
     void sendPacket(const SCALPEL::Packet& packet) override;
 
+    /**
+     * @brief Sends SCALPEL packets, packing as many as fit into each MAVLink frame.
+     *
+     * With interleaving on they go into the interleaver instead, and are counted as
+     * sent once they are in it.
+     *
+     * @param packets The packets to send, in order.
+     * @throws RadioException if sending fails.
+     */
+    void sendPackets(SCALPEL::Span<const SCALPEL::Packet> packets) override;
+
+    /**
+     * @brief Payload capacity of one MAVLink frame.
+     * @return MAX_FRAME_PAYLOAD_LENGTH.
+     */
+    size_t getMaxBatchLength() const override { return MAX_FRAME_PAYLOAD_LENGTH; }
+
     /**
      * @brief Receives a SCALPEL packet from the RFD900 radio.
      * @param packet The SCALPEL packet received.
@@ -65,17 +83,62 @@ public:
      */
     void getStatus(RadioStatus& status) override;
 
+protected:
+    /**
+     * @brief Sends one MAVLink frame carrying payload, such as a chunk of an interleaved block.
+     * @param payload At most MAX_FRAME_PAYLOAD_LENGTH bytes.
+     * @throws std::length_error if the payload is too long.
+     * @throws RadioException if sending fails.
+     */
+    void sendPayload(const SCALPEL::GatherFrame& payload) override;
+
 private:
+    /// MAVLink v1 carries at most 255 payload bytes per frame.
+    static constexpr size_t MAX_FRAME_PAYLOAD_LENGTH = 255;
+
+    /**
+     * @brief Sends packets back to back in a single MAVLink frame.
+     * @param packets Packets whose assembled sizes fit in MAX_FRAME_PAYLOAD_LENGTH.
+     * @throws RadioException if sending fails.
+     */
+    void sendFrame(SCALPEL::Span<const SCALPEL::Packet> packets);
+
+    /**
+     * @brief Appends the CRC to a frame holding a MAVLink header and payload and writes it.
+     * @param frame The frame to complete and send.
+     * @param crc Frame CRC over the header and payload.
+     * @throws RadioException if sending fails.
+     */
+    void writeFrame(SCALPEL::GatherFrame& frame, uint16_t crc);
+
     /**
      * @brief Reads data asynchronously from the serial port.
      */
     void readLoop();
 
     /**
-     * @brief Processes incoming data frames.
-     * @param data The raw data received.
+     * @brief Processes every complete frame at the front of the received data.
+     *
+     * Frames whose CRC does not match are counted as reception errors and skipped.
+     *
+     * @param data Bytes received and not yet processed, viewed in place in readBuffer.
+     * @return Bytes processed; the rest start an incomplete frame, to be completed by the next read.
+     */
+    size_t processFrames(SCALPEL::Span<const uint8_t> data);
+
+    /**
+     * @brief Passes a frame payload through the deinterleaver and queues the packets it yields.
+     * @param payload The MAVLink payload.
+     * @return false if the payload held no packet and was not part of an interleaved block.
+     */
+    bool receivePayload(SCALPEL::Span<const uint8_t> payload);
+
+    /**
+     * @brief Queues every valid SCALPEL packet in a frame payload.
+     * @param payload The MAVLink payload, which may hold several packets.
+     * @return Number of packets queued.
      */
-    void processFrame(const std::vector<uint8_t>& data);
+    size_t queuePackets(SCALPEL::Span<const uint8_t> payload);
 
     /**
      * @brief Sends a command to the RFD900 module.
@@ -96,7 +159,7 @@ private:
     boost::asio::serial_port serialPort;
     std::thread ioThread;
 
-    // Buffer for incoming data
+    // Received bytes not yet processed, holding a frame split across reads
     std::vector<uint8_t> readBuffer;
     std::mutex readMutex;
 
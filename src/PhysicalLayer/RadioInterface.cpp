@@ -1,8 +1,126 @@
 #include "RadioInterface.hpp"
+#include <algorithm>
+#include <stdexcept>
 
 namespace RocketLink {
+namespace Radio {
 
-// Since RadioInterface is an abstract class with no implementation details,
-// the .cpp file remains empty unless you need to define non-pure virtual methods.
+void RadioInterface::sendPackets(SCALPEL::Span<const SCALPEL::Packet> packets) {
+    for (const SCALPEL::Packet& packet : packets) {
+        sendPacket(packet);
+    }
+}
 
+size_t RadioInterface::getMaxBatchLength() const {
+    return SCALPEL::Packet::MAX_PACKET_LENGTH;
+}
+
+size_t RadioInterface::packetsThatFit(SCALPEL::Span<const SCALPEL::Packet> packets, size_t capacity) {
+    size_t count = 0;
+    size_t length = 0;
+    while (count < packets.size()) {
+        length += packets[count].getAssembledLength();
+        if (count != 0 && length > capacity) {
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+void RadioInterface::setInterleaveDepth(size_t depth, size_t slotLength) {
+    // Chunk offsets are 16 bits
+    if (depth != 0 && slotLength > 0xFFFF / depth) {
+        throw std::invalid_argument("Interleaver block too long for a chunk offset.");
+    }
+    SCALPEL::Interleaver nextInterleaver = makeInterleaver(depth, slotLength);
+    SCALPEL::Deinterleaver nextDeinterleaver = makeDeinterleaver(depth, slotLength);
+    {
+        std::lock_guard<std::mutex> lock(interleaverMutex);
+        interleaver.flush();
+        interleaver = std::move(nextInterleaver);
+    }
+    {
+        std::lock_guard<std::mutex> lock(deinterleaverMutex);
+        deinterleaver = std::move(nextDeinterleaver);
+        rxBlockStarted = false;
+    }
+    interleaveDepth.store(depth, std::memory_order_relaxed);
+}
+
+void RadioInterface::flushInterleaver() {
+    std::lock_guard<std::mutex> lock(interleaverMutex);
+    interleaver.flush();
+}
+
+bool RadioInterface::interleavePackets(SCALPEL::Span<const SCALPEL::Packet> packets) {
+    std::lock_guard<std::mutex> lock(interleaverMutex);
+    if (interleaver.getDepth() == 1) {
+        return false;
+    }
+    uint8_t assembled[SCALPEL::Packet::MAX_PACKET_LENGTH];
+    for (const SCALPEL::Packet& packet : packets) {
+        size_t length = packet.assembleInto(assembled, sizeof(assembled));
+        interleaver.push(SCALPEL::Span<const uint8_t>(assembled, length));
+    }
+    return true;
+}
+
+void RadioInterface::sendPayload(const SCALPEL::GatherFrame&) {
+    throw RadioException("This radio cannot send interleaved blocks.");
+}
+
+bool RadioInterface::deinterleave(SCALPEL::Span<const uint8_t> payload,
+                                  const std::function<void(SCALPEL::Span<const uint8_t>)>& onData) {
+    std::lock_guard<std::mutex> lock(deinterleaverMutex);
+    if (deinterleaver.getDepth() == 1) {
+        onData(payload);
+        return true;
+    }
+    if (payload.size() < BLOCK_HEADER_LENGTH) {
+        return false;
+    }
+
+    uint8_t sequence = payload[0];
+    size_t offset = static_cast<size_t>(payload[1]) | static_cast<size_t>(payload[2]) << 8;
+    bool newBlock = !rxBlockStarted || sequence != rxBlockSequence;
+    rxData = &onData;
+    bool accepted = deinterleaver.feedAt(offset, payload.subspan(BLOCK_HEADER_LENGTH), newBlock);
+    rxData = nullptr;
+    if (accepted) {
+        rxBlockSequence = sequence;
+        rxBlockStarted = true;
+    }
+    return accepted;
+}
+
+SCALPEL::Interleaver RadioInterface::makeInterleaver(size_t depth, size_t slotLength) {
+    return SCALPEL::Interleaver(depth, slotLength, [this](SCALPEL::Span<const uint8_t> block) {
+        sendBlock(block);
+    });
+}
+
+SCALPEL::Deinterleaver RadioInterface::makeDeinterleaver(size_t depth, size_t slotLength) {
+    return SCALPEL::Deinterleaver(depth, slotLength, [this](SCALPEL::Span<const uint8_t> data) {
+        if (rxData) {
+            (*rxData)(data);
+        }
+    });
+}
+
+void RadioInterface::sendBlock(SCALPEL::Span<const uint8_t> block) {
+    const size_t chunkLength = getMaxBatchLength() - BLOCK_HEADER_LENGTH;
+    for (size_t offset = 0; offset < block.size(); offset += chunkLength) {
+        SCALPEL::GatherFrame payload;
+        SCALPEL::Span<uint8_t> header = payload.reserve(BLOCK_HEADER_LENGTH);
+        header[0] = txBlockSequence;
+        header[1] = static_cast<uint8_t>(offset & 0xFF);
+        header[2] = static_cast<uint8_t>(offset >> 8);
+        payload.appendReference(block.subspan(offset, std::min(chunkLength, block.size() - offset)));
+        sendPayload(payload);
+    }
+    txBlockSequence++;
+}
+
+} // namespace Radio
 } // namespace RocketLink
@@ -2,7 +2,11 @@
 #define ROCKETLINK_RADIO_RADIOINTERFACE_HPP
 
 #include "SCALPEL/Packet.hpp"
+#include "SCALPEL/GatherFrame.hpp"
+#include "SCALPEL/Interleaver.hpp"
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <mutex>
 #include <exception>
@@ -85,6 +89,22 @@ public:
      */
     virtual void sendPacket(const SCALPEL::Packet& packet) = 0;
 
+    /**
+     * @brief Sends several SCALPEL packets, packing as many as fit into each radio frame.
+     *
+     * The default implementation sends each packet in its own frame.
+     *
+     * @param packets The packets to send, in order.
+     * @throws RadioException if sending fails.
+     */
+    virtual void sendPackets(SCALPEL::Span<const SCALPEL::Packet> packets);
+
+    /**
+     * @brief Largest assembled size of the packets sendPackets fits into one radio frame.
+     * @return Capacity in bytes; at least SCALPEL::Packet::MAX_PACKET_LENGTH.
+     */
+    virtual size_t getMaxBatchLength() const;
+
     /**
      * @brief Receives a SCALPEL packet from the radio.
      * @param packet The packet received.
@@ -107,12 +127,134 @@ public:
      */
     virtual void getStatus(RadioStatus& status) = 0;
 
+    /**
+     * @brief Sets how received packets' length and COBS bytes are protected.
+     *
+     * Not signalled on the wire; it must match the format the far end sends with.
+     *
+     * @param protection The link's header protection.
+     */
+    void setHeaderProtection(SCALPEL::PacketFormat::HeaderProtection protection) {
+        headerProtection.store(protection, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Header protection used to parse received packets.
+     */
+    SCALPEL::PacketFormat::HeaderProtection getHeaderProtection() const {
+        return headerProtection.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the depth of the block interleaver between packet assembly and the radio.
+     *
+     * At depth 1, the default, packets are sent as they are. At a higher depth each packet
+     * is padded to slotLength bytes and depth of them are sent interleaved as one block,
+     * split over as many radio frames as it needs, so a fade that wipes out consecutive
+     * bytes damages only a few bytes of each packet. Each of those frames starts with a
+     * block header, the block's sequence number and the offset of the frame's bytes in it,
+     * which the receiver uses to realign after a lost frame. Packets wait until their
+     * block is full or flushInterleaver() is called.
+     *
+     * Not signalled on the wire; it must match the far end. A partial block is flushed at
+     * the old depth first, and a partially received one is discarded.
+     *
+     * @param depth Packets per block, 1 to SCALPEL::Interleaver::MAX_DEPTH.
+     * @param slotLength Bytes each packet is padded to; at least the longest packet sent.
+     * @throws std::invalid_argument if depth or slotLength is out of range.
+     * @throws RadioException if sending the partial block fails.
+     */
+    void setInterleaveDepth(size_t depth, size_t slotLength = SCALPEL::Packet::MAX_PACKET_LENGTH);
+
+    /**
+     * @brief Packets per interleaved block; 1 when interleaving is off.
+     */
+    size_t getInterleaveDepth() const { return interleaveDepth.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Sends the partial interleaver block padded with fill instead of waiting for it to fill up.
+     * @throws RadioException if sending fails.
+     */
+    void flushInterleaver();
+
     // Prevent copying and assignment
     RadioInterface(const RadioInterface&) = delete;
     RadioInterface& operator=(const RadioInterface&) = delete;
 
 protected:
     RadioInterface() = default;
+
+    /**
+     * @brief Counts the leading packets whose assembled sizes fit in one radio frame.
+     * @param packets The packets waiting to be sent.
+     * @param capacity Radio frame payload capacity in bytes.
+     * @return Number of packets for the next frame; at least one if packets is not empty.
+     */
+    static size_t packetsThatFit(SCALPEL::Span<const SCALPEL::Packet> packets, size_t capacity);
+
+    /// Block header before each chunk of an interleaved block: sequence number and 16-bit offset.
+    static constexpr size_t BLOCK_HEADER_LENGTH = 3;
+
+    /**
+     * @brief Interleaves packets into blocks sent with sendPayload() when the depth is above 1.
+     * @param packets The packets to send, in order.
+     * @return false at depth 1, leaving the packets for the radio to send itself.
+     * @throws std::length_error if a packet is longer than the slot length.
+     * @throws RadioException if sending a completed block fails.
+     */
+    bool interleavePackets(SCALPEL::Span<const SCALPEL::Packet> packets);
+
+    /**
+     * @brief Sends one radio frame carrying payload as its data.
+     *
+     * Used for the chunks of interleaved blocks, each at most getMaxBatchLength() bytes.
+     * The default implementation throws, so a radio that does not override it cannot
+     * interleave.
+     *
+     * @param payload The frame payload as gather segments.
+     * @throws RadioException if sending fails.
+     */
+    virtual void sendPayload(const SCALPEL::GatherFrame& payload);
+
+    /**
+     * @brief Passes the payload of a received radio frame on as packet data.
+     *
+     * At depth 1 onData gets the payload itself. Otherwise the payload is a chunk of an
+     * interleaved block and onData gets each block it completes, with the bytes of lost
+     * chunks filled in.
+     *
+     * @param payload The radio frame payload.
+     * @param onData Called on the calling thread with the packet data.
+     * @return false if the payload is not a valid chunk and was dropped.
+     */
+    bool deinterleave(SCALPEL::Span<const uint8_t> payload,
+                      const std::function<void(SCALPEL::Span<const uint8_t>)>& onData);
+
+private:
+    SCALPEL::Interleaver makeInterleaver(size_t depth, size_t slotLength);
+    SCALPEL::Deinterleaver makeDeinterleaver(size_t depth, size_t slotLength);
+
+    /**
+     * @brief Sends an interleaved block as chunks of at most getMaxBatchLength() bytes, block header included.
+     */
+    void sendBlock(SCALPEL::Span<const uint8_t> block);
+
+    std::atomic<SCALPEL::PacketFormat::HeaderProtection> headerProtection{
+        SCALPEL::PacketFormat::HeaderProtection::Checksum};
+
+    std::atomic<size_t> interleaveDepth{1};
+
+    // Transmit side, serialized so blocks and their chunks go out whole
+    std::mutex interleaverMutex;
+    SCALPEL::Interleaver interleaver = makeInterleaver(1, SCALPEL::Packet::MAX_PACKET_LENGTH);
+    uint8_t txBlockSequence = 0;
+
+    // Receive side; rxData is the onData of the deinterleave() call in progress
+    std::mutex deinterleaverMutex;
+    SCALPEL::Deinterleaver deinterleaver = makeDeinterleaver(1, SCALPEL::Packet::MAX_PACKET_LENGTH);
+    const std::function<void(SCALPEL::Span<const uint8_t>)>* rxData = nullptr;
+    uint8_t rxBlockSequence = 0;
+    bool rxBlockStarted = false;
 };
 
 } // namespace Radio
@@ -0,0 +1,111 @@
+#include "TransportRadio.hpp"
+#include "SCALPEL/PacketView.hpp"
+#include <array>
+#include <chrono>
+
+namespace RocketLink {
+namespace Radio {
+
+TransportRadio::TransportRadio(std::unique_ptr<SCALPEL::Transport> transport)
+    : parserProtection(getHeaderProtection()),
+      parser(makeParser(parserProtection)),
+      communicator([this](const std::vector<uint8_t>& data) { onDataReceived(data); }, std::move(transport)) {}
+
+TransportRadio::~TransportRadio() {
+    communicator.stop();
+}
+
+void TransportRadio::initialize() {
+    communicator.start();
+    std::lock_guard<std::mutex> lock(statusMutex);
+    currentStatus.isInitialized = true;
+}
+
+void TransportRadio::configure(const RadioConfig& config) {
+    std::lock_guard<std::mutex> lock(statusMutex);
+    currentConfig = config;
+}
+
+void TransportRadio::getStatus(RadioStatus& status) {
+    std::lock_guard<std::mutex> lock(statusMutex);
+    status = currentStatus;
+}
+
+size_t TransportRadio::getQueueDepth() const {
+    return communicator.getQueueDepth();
+}
+
+void TransportRadio::sendPacket(const SCALPEL::Packet& packet) {
+    sendPackets(SCALPEL::Span<const SCALPEL::Packet>(&packet, 1));
+}
+
+void TransportRadio::sendPackets(SCALPEL::Span<const SCALPEL::Packet> packets) {
+    if (getInterleaveDepth() > 1) {
+        throw RadioException("A transport does not keep the frame boundaries interleaving needs.");
+    }
+    while (!packets.empty()) {
+        size_t count = packetsThatFit(packets, SCALPEL::Communicator::MAX_FRAME_LENGTH);
+        sendFrame(packets.first(count));
+        packets = packets.subspan(count);
+    }
+}
+
+void TransportRadio::sendFrame(SCALPEL::Span<const SCALPEL::Packet> packets) {
+    // Assemble every packet straight into the frame handed to the Communicator
+    std::array<uint8_t, SCALPEL::Communicator::MAX_FRAME_LENGTH> frame;
+    size_t length = 0;
+    for (const SCALPEL::Packet& packet : packets) {
+        length += packet.assembleInto(frame.data() + length, frame.size() - length);
+    }
+
+    SCALPEL::Communicator::SendResult result =
+        communicator.send(SCALPEL::Span<const uint8_t>(frame.data(), length));
+    std::lock_guard<std::mutex> lock(statusMutex);
+    if (result != SCALPEL::Communicator::SendResult::Queued) {
+        currentStatus.transmissionErrors++;
+        throw RadioException("Failed to queue frame on the transport.");
+    }
+    currentStatus.packetsSent += static_cast<uint32_t>(packets.size());
+}
+
+bool TransportRadio::receivePacket(SCALPEL::Packet& packet) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    if (!queueCondVar.wait_for(lock, std::chrono::milliseconds(100), [this]() { return !packetQueue.empty(); })) {
+        return false;
+    }
+    packet = packetQueue.front();
+    packetQueue.pop();
+    return true;
+}
+
+void TransportRadio::onDataReceived(const std::vector<uint8_t>& data) {
+    SCALPEL::PacketFormat::HeaderProtection protection = getHeaderProtection();
+    if (protection != parserProtection) {
+        parserProtection = protection;
+        parser = makeParser(protection);
+    }
+
+    uint64_t resyncs = parser.getStats().resyncs;
+    parser.feed(SCALPEL::Span<const uint8_t>(data.data(), data.size()));
+    if (parser.getStats().resyncs != resyncs) {
+        std::lock_guard<std::mutex> lock(statusMutex);
+        currentStatus.receptionErrors += static_cast<uint32_t>(parser.getStats().resyncs - resyncs);
+    }
+}
+
+SCALPEL::FrameParser TransportRadio::makeParser(SCALPEL::PacketFormat::HeaderProtection protection) {
+    return SCALPEL::FrameParser([this](const SCALPEL::PacketView& view, uint64_t) {
+        {
+            std::lock_guard<std::mutex> lock(statusMutex);
+            currentStatus.packetsReceived++;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            packetQueue.push(view.toPacket());
+        }
+        queueCondVar.notify_all();
+    }, protection);
+}
+
+} // namespace Radio
+} // namespace RocketLink
@@ -0,0 +1,140 @@
+#ifndef ROCKETLINK_RADIO_TRANSPORTRADIO_HPP
+#define ROCKETLINK_RADIO_TRANSPORTRADIO_HPP
+
+#include "RadioInterface.hpp"
+#include "SCALPEL/Communicator.hpp"
+#include "SCALPEL/FrameParser.hpp"
+#include "SCALPEL/Transport.hpp"
+#include <memory>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+
+namespace RocketLink {
+namespace Radio {
+
+/**
+ * @brief Radio whose link is a SCALPEL::Transport rather than radio hardware.
+ *
+ * Packets are assembled back to back into frames of up to
+ * SCALPEL::Communicator::MAX_FRAME_LENGTH bytes and queued on a Communicator
+ * running the transport, and every valid packet found in what it receives is
+ * queued for receivePacket(). Over a SCALPEL::LoopbackTransport pair, two
+ * complete stacks can run against each other without hardware.
+ *
+ * A transport carries a byte stream that does not keep frame boundaries, so
+ * interleaving is not supported.
+ */
+class TransportRadio : public RadioInterface {
+public:
+    /**
+     * @brief Constructs the radio over a transport.
+     * @param transport The link, such as one end of a LoopbackTransport pair.
+     */
+    explicit TransportRadio(std::unique_ptr<SCALPEL::Transport> transport);
+
+    /**
+     * @brief Destructor; stops the transport's loop.
+     */
+    ~TransportRadio() override;
+
+    /**
+     * @brief Starts the transport's loop.
+     */
+    void initialize() override;
+
+    /**
+     * @brief Sends a SCALPEL packet in a frame of its own.
+     * @param packet The packet to send.
+     * @throws RadioException if the frame cannot be queued.
+     */
+    void sendPacket(const SCALPEL::Packet& packet) override;
+
+    /**
+     * @brief Sends SCALPEL packets, packing as many as fit into each frame.
+     * @param packets The packets to send, in order.
+     * @throws RadioException if a frame cannot be queued or interleaving is on.
+     */
+    void sendPackets(SCALPEL::Span<const SCALPEL::Packet> packets) override;
+
+    /**
+     * @brief Longest frame the Communicator accepts.
+     * @return SCALPEL::Communicator::MAX_FRAME_LENGTH.
+     */
+    size_t getMaxBatchLength() const override { return SCALPEL::Communicator::MAX_FRAME_LENGTH; }
+
+    /**
+     * @brief Receives a SCALPEL packet, waiting up to 100 ms for one to arrive.
+     * @param packet The SCALPEL packet received.
+     * @return true if a packet was received, false otherwise.
+     */
+    bool receivePacket(SCALPEL::Packet& packet) override;
+
+    /**
+     * @brief Records the configuration; a transport has nothing to tune.
+     * @param config The configuration parameters.
+     */
+    void configure(const RadioConfig& config) override;
+
+    /**
+     * @brief Retrieves radio status metrics.
+     *
+     * Packets count as received once they arrive, before receivePacket() takes
+     * them, and packets the parser rejects as reception errors.
+     *
+     * @param status The structure to populate with status metrics.
+     */
+    void getStatus(RadioStatus& status) override;
+
+    /**
+     * @brief Frames queued for the transport and not yet fully written.
+     */
+    size_t getQueueDepth() const;
+
+private:
+    /**
+     * @brief Queues one frame of assembled packets on the Communicator.
+     * @param packets Packets whose assembled sizes fit in one frame.
+     * @throws RadioException if the frame cannot be queued.
+     */
+    void sendFrame(SCALPEL::Span<const SCALPEL::Packet> packets);
+
+    /**
+     * @brief Parses received bytes and queues the packets they complete.
+     *        Called on the Communicator's I/O thread.
+     * @param data Bytes received.
+     */
+    void onDataReceived(const std::vector<uint8_t>& data);
+
+    /**
+     * @brief Makes a parser that queues every packet it finds.
+     * @param protection Header protection the far end sends with.
+     */
+    SCALPEL::FrameParser makeParser(SCALPEL::PacketFormat::HeaderProtection protection);
+
+    // Received packets, filled on the I/O thread
+    std::queue<SCALPEL::Packet> packetQueue;
+    std::mutex queueMutex;
+    std::condition_variable queueCondVar;
+
+    // Finds packets in the received byte stream; only used on the I/O thread,
+    // and replaced when the header protection changes
+    SCALPEL::PacketFormat::HeaderProtection parserProtection;
+    SCALPEL::FrameParser parser;
+
+    // Configuration parameters
+    RadioConfig currentConfig;
+
+    // Status metrics
+    RadioStatus currentStatus;
+    std::mutex statusMutex;
+
+    // Runs the transport; declared last so it stops before the rest goes
+    SCALPEL::Communicator communicator;
+};
+
+} // namespace Radio
+} // namespace RocketLink
+
+#endif // ROCKETLINK_RADIO_TRANSPORTRADIO_HPP
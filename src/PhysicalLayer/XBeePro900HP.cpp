@@ -1,14 +1,32 @@
 #include "XBeePro900HP.hpp"
 #include "SCALPEL/Packet.hpp"
+#include "SCALPEL/PacketView.hpp"
+#include "SCALPEL/FrameParser.hpp"
+#include "SCALPEL/GatherFrame.hpp"
+#include "GatherWrite.hpp"
 #include <boost/asio/read_until.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/bind.hpp>
 #include <iostream>
 #include <stdexcept>
+#include <array>
 
 namespace RocketLink {
 namespace Radio {
 
+namespace {
+
+// Low byte of the sum of bytes, the basis of the API frame checksum
+uint8_t byteSum(SCALPEL::Span<const uint8_t> bytes) {
+    uint8_t sum = 0;
+    for (uint8_t byte : bytes) {
+        sum = static_cast<uint8_t>(sum + byte);
+    }
+    return sum;
+}
+
+} // namespace
+
 XBeePro900HP::XBeePro900HP(const std::string& port, unsigned int baudRate)
     : serialPort(ioService), running(false) {
     try {
@@ -72,11 +90,51 @@ void XBeePro900HP::getStatus(RadioStatus& status) {
 }
 
 void XBeePro900HP::sendPacket(const SCALPEL::Packet& packet) {
-    std::vector<uint8_t> frame = constructTransmitRequest(packet);
+    sendPackets(SCALPEL::Span<const SCALPEL::Packet>(&packet, 1));
+}
+
+void XBeePro900HP::sendPackets(SCALPEL::Span<const SCALPEL::Packet> packets) {
+    if (interleavePackets(packets)) {
+        std::lock_guard<std::mutex> lock(statusMutex);
+        currentStatus.packetsSent += static_cast<uint32_t>(packets.size());
+        return;
+    }
+
+    SCALPEL::GatherFrame frame;
+    while (!packets.empty()) {
+        SCALPEL::Span<const SCALPEL::Packet> batch = packets.first(packetsThatFit(packets, MAX_RF_DATA_LENGTH));
+        frame.clear();
+        constructTransmitRequest(batch, frame);
+        try {
+            sendFrame(frame);
+            std::lock_guard<std::mutex> lock(statusMutex);
+            currentStatus.packetsSent += static_cast<uint32_t>(batch.size());
+        } catch (const RadioException& e) {
+            std::lock_guard<std::mutex> lock(statusMutex);
+            currentStatus.transmissionErrors++;
+            throw;
+        }
+        packets = packets.subspan(batch.size());
+    }
+}
+
+void XBeePro900HP::sendPayload(const SCALPEL::GatherFrame& payload) {
+    if (payload.size() > MAX_RF_DATA_LENGTH) {
+        throw std::length_error("Payload exceeds the XBee RF data capacity.");
+    }
+
+    // The payload's segments are referenced as RF data, not copied
+    SCALPEL::GatherFrame frame;
+    uint8_t checksum = appendTransmitRequestHeader(frame, payload.size());
+    for (size_t i = 0; i < payload.segmentCount(); ++i) {
+        frame.appendReference(payload.segment(i));
+        checksum = static_cast<uint8_t>(checksum + byteSum(payload.segment(i)));
+    }
+    uint8_t trailer = static_cast<uint8_t>(0xFF - checksum);
+    frame.append(SCALPEL::Span<const uint8_t>(&trailer, 1));
+
     try {
         sendFrame(frame);
-        std::lock_guard<std::mutex> lock(statusMutex);
-        currentStatus.packetsSent++;
     } catch (const RadioException& e) {
         std::lock_guard<std::mutex> lock(statusMutex);
         currentStatus.transmissionErrors++;
@@ -105,6 +163,8 @@ bool XBeePro900HP::receivePacket(SCALPEL::Packet& packet) {
 }
 
 void XBeePro900HP::readLoop() {
+    // Holds delimiter, length, frame data and checksum; reused across frames
+    std::vector<uint8_t> frameBuffer;
     while (running) {
         try {
             // Read until start delimiter 0x7E is found
@@ -119,9 +179,13 @@ void XBeePro900HP::readLoop() {
             boost::asio::read(serialPort, boost::asio::buffer(lengthBytes, 2));
             uint16_t length = (lengthBytes[0] << 8) | lengthBytes[1];
 
-            // Read the frame data and checksum
-            std::vector<uint8_t> frameData(length + 1); // +1 for checksum
-            boost::asio::read(serialPort, boost::asio::buffer(frameData.data(), frameData.size()));
+            // Read the frame data and checksum after the 3 header bytes
+            frameBuffer.resize(3 + length + 1); // +1 for checksum
+            frameBuffer[0] = startByte;
+            frameBuffer[1] = lengthBytes[0];
+            frameBuffer[2] = lengthBytes[1];
+            uint8_t* frameData = frameBuffer.data() + 3;
+            boost::asio::read(serialPort, boost::asio::buffer(frameData, length + 1));
 
             // Verify checksum
             uint8_t calculatedChecksum = 0;
@@ -135,13 +199,8 @@ void XBeePro900HP::readLoop() {
                 continue; // Checksum mismatch
             }
 
-            // Process the frame
-            std::vector<uint8_t> completeFrame;
-            completeFrame.push_back(startByte);
-            completeFrame.push_back(lengthBytes[0]);
-            completeFrame.push_back(lengthBytes[1]);
-            completeFrame.insert(completeFrame.end(), frameData.begin(), frameData.end() - 1); // Exclude checksum
-            processFrame(completeFrame);
+            // Process the frame, excluding the checksum
+            processFrame(SCALPEL::Span<const uint8_t>(frameBuffer.data(), 3 + length));
         } catch (const boost::system::system_error& e) {
             if (running) {
                 std::lock_guard<std::mutex> lock(statusMutex);
@@ -151,7 +210,7 @@ void XBeePro900HP::readLoop() {
     }
 }
 
-void XBeePro900HP::processFrame(const std::vector<uint8_t>& frame) {
+void XBeePro900HP::processFrame(SCALPEL::Span<const uint8_t> frame) {
     if (frame.size() < 4) {
         return; // Frame too short
     }
@@ -159,12 +218,7 @@ void XBeePro900HP::processFrame(const std::vector<uint8_t>& frame) {
     uint8_t frameType = frame[3];
     switch (frameType) {
         case 0x90: { // Receive Packet
-            SCALPEL::Packet packet;
-            if (parseRxPacket(frame, packet)) {
-                std::lock_guard<std::mutex> lock(queueMutex);
-                packetQueue.push(packet);
-                queueCondVar.notify_one();
-            } else {
+            if (!parseRxPackets(frame)) {
                 std::lock_guard<std::mutex> lock(statusMutex);
                 currentStatus.receptionErrors++;
             }
@@ -181,82 +235,111 @@ void XBeePro900HP::processFrame(const std::vector<uint8_t>& frame) {
 }
 
 void XBeePro900HP::sendFrame(const std::vector<uint8_t>& frame) {
+    sendFrame(frame.data(), frame.size());
+}
+
+void XBeePro900HP::sendFrame(const uint8_t* frame, size_t length) {
     boost::system::error_code ec;
-    boost::asio::write(serialPort, boost::asio::buffer(frame), ec);
+    boost::asio::write(serialPort, boost::asio::buffer(frame, length), ec);
     if (ec) {
         throw RadioException("Failed to send frame: " + ec.message());
     }
 }
 
-std::vector<uint8_t> XBeePro900HP::constructTransmitRequest(const SCALPEL::Packet& packet) {
-    std::vector<uint8_t> frame;
+void XBeePro900HP::sendFrame(const SCALPEL::GatherFrame& frame) {
+    try {
+        writeGatherFrame(serialPort, frame);
+    } catch (const boost::system::system_error& e) {
+        throw RadioException("Failed to send frame: " + std::string(e.what()));
+    }
+}
+
+void XBeePro900HP::constructTransmitRequest(SCALPEL::Span<const SCALPEL::Packet> packets, SCALPEL::GatherFrame& frame) {
+    size_t rfDataLength = 0;
+    for (const SCALPEL::Packet& packet : packets) {
+        rfDataLength += packet.getAssembledLength();
+    }
+    if (rfDataLength > MAX_RF_DATA_LENGTH) {
+        throw std::length_error("Packets exceed the XBee RF data capacity.");
+    }
+
+    // RF data (payload), one segment per packet. The checksum is accumulated
+    // as each segment is added rather than in a pass over the finished frame
+    uint8_t checksum = appendTransmitRequestHeader(frame, rfDataLength);
+    for (const SCALPEL::Packet& packet : packets) {
+        checksum = static_cast<uint8_t>(checksum + byteSum(frame.appendPacket(packet)));
+    }
+
+    uint8_t trailer = static_cast<uint8_t>(0xFF - checksum);
+    frame.append(SCALPEL::Span<const uint8_t>(&trailer, 1));
+}
+
+uint8_t XBeePro900HP::appendTransmitRequestHeader(SCALPEL::GatherFrame& frame, size_t rfDataLength) {
+    SCALPEL::Span<uint8_t> header = frame.reserve(17);
 
     // Start delimiter
-    frame.push_back(0x7E);
+    header[0] = 0x7E;
 
-    // Placeholder for length (to be filled later)
-    frame.push_back(0x00);
-    frame.push_back(0x00);
+    // Length, excluding start delimiter, length bytes and checksum
+    uint16_t length = static_cast<uint16_t>(14 + rfDataLength);
+    header[1] = (length >> 8) & 0xFF;
+    header[2] = length & 0xFF;
 
     // Frame type: Transmit Request (0x10)
-    frame.push_back(0x10);
+    header[3] = 0x10;
 
     // Frame ID
-    frame.push_back(0x01); // Arbitrary frame ID
+    header[4] = 0x01; // Arbitrary frame ID
 
     // 64-bit destination address (Assuming broadcast for simplicity)
-    for (int i = 0; i < 8; ++i) {
-        frame.push_back(0xFF);
+    for (size_t i = 5; i < 13; ++i) {
+        header[i] = 0xFF;
     }
 
     // 16-bit destination address (0xFFFE for unknown)
-    frame.push_back(0xFF);
-    frame.push_back(0xFE);
+    header[13] = 0xFF;
+    header[14] = 0xFE;
 
     // Broadcast radius
-    frame.push_back(0x00); // Default
+    header[15] = 0x00; // Default
 
     // Options
-    frame.push_back(0x00); // Default
-
-    // RF data (payload)
-    std::vector<uint8_t> payload = packet.assemble();
-    frame.insert(frame.end(), payload.begin(), payload.end());
-
-    // Calculate length
-    uint16_t length = frame.size() - 3; // Exclude start delimiter and length bytes
-    frame[1] = (length >> 8) & 0xFF;
-    frame[2] = length & 0xFF;
+    header[16] = 0x00; // Default
 
-    // Calculate checksum
-    uint8_t checksum = 0;
-    for (size_t i = 3; i < frame.size(); ++i) {
-        checksum += frame[i];
-    }
-    checksum = 0xFF - checksum;
-    frame.push_back(checksum);
-
-    return frame;
+    // The checksum covers everything after the length bytes
+    return byteSum(header.subspan(3));
 }
 
-bool XBeePro900HP::parseRxPacket(const std::vector<uint8_t>& frame, SCALPEL::Packet& packet) {
+bool XBeePro900HP::parseRxPackets(SCALPEL::Span<const uint8_t> frame) {
     // Example parsing for 0x90 frame type
     // Frame structure:
     // 0x7E | Length (2) | Frame Type (0x90) | 64-bit addr (8) | 16-bit addr (2) | options (1) | RF data
-    if (frame.size() < 15) {
+    size_t rfDataStart = 15; // 0-based index
+    if (frame.size() <= rfDataStart) {
         return false; // Frame too short
     }
 
-    // Extract RF data
-    size_t rfDataStart = 14; // 0-based index
-    std::vector<uint8_t> rfData(frame.begin() + rfDataStart, frame.end());
+    // The RF data holds one or more packets back to back, or a chunk of an
+    // interleaved block, which need not complete one
+    size_t received = 0;
+    bool accepted = deinterleave(frame.subspan(rfDataStart), [this, &received](SCALPEL::Span<const uint8_t> data) {
+        received += queuePackets(data);
+    });
+    return accepted && (received != 0 || getInterleaveDepth() > 1);
+}
 
-    try {
-        packet = SCALPEL::Packet::disassemble(rfData);
-        return true;
-    } catch (const std::exception&) {
-        return false;
+size_t XBeePro900HP::queuePackets(SCALPEL::Span<const uint8_t> rfData) {
+    size_t received = 0;
+    SCALPEL::FrameParser parser([this, &received](const SCALPEL::PacketView& view, uint64_t) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        packetQueue.push(view.toPacket());
+        received++;
+    }, getHeaderProtection());
+    parser.feed(rfData);
+    if (received != 0) {
+        queueCondVar.notify_all();
     }
+    return received;
 }
 
 } // namespace Radio
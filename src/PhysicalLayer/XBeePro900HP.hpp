@@ -3,6 +3,7 @@
 
 #include "RadioInterface.hpp"
 #include "SCALPEL/Packet.hpp"
+#include "SCALPEL/GatherFrame.hpp"
 #include <boost/asio.hpp>
 #include <thread>
 #include <atomic>
@@ -44,6 +45,23 @@ public:
      */
     void sendPacket(const SCALPEL::Packet& packet) override;
 
+    /**
+     * @brief Sends SCALPEL packets, packing as many as fit into each Transmit Request.
+     *
+     * With interleaving on they go into the interleaver instead, and are counted as
+     * sent once they are in it.
+     *
+     * @param packets The packets to send, in order.
+     * @throws RadioException if sending fails.
+     */
+    void sendPackets(SCALPEL::Span<const SCALPEL::Packet> packets) override;
+
+    /**
+     * @brief RF payload capacity of one transmission.
+     * @return MAX_RF_DATA_LENGTH.
+     */
+    size_t getMaxBatchLength() const override { return MAX_RF_DATA_LENGTH; }
+
     /**
      * @brief Receives a SCALPEL packet from the XBee radio.
      * @param packet The SCALPEL packet received.
@@ -66,6 +84,16 @@ public:
      */
     void getStatus(RadioStatus& status) override;
 
+protected:
+    /**
+     * @brief Sends one Transmit Request carrying payload as RF data, such as a chunk of an
+     *        interleaved block.
+     * @param payload At most MAX_RF_DATA_LENGTH bytes.
+     * @throws std::length_error if the payload is too long.
+     * @throws RadioException if sending fails.
+     */
+    void sendPayload(const SCALPEL::GatherFrame& payload) override;
+
 private:
     /**
      * @brief Reads data asynchronously from the serial port.
@@ -74,9 +102,9 @@ private:
 
     /**
      * @brief Processes incoming API frames.
-     * @param data The raw data of the API frame.
+     * @param data The raw data of the API frame, viewed in place in the read buffer.
      */
-    void processFrame(const std::vector<uint8_t>& data);
+    void processFrame(SCALPEL::Span<const uint8_t> data);
 
     /**
      * @brief Sends an API frame to the XBee module.
@@ -86,19 +114,64 @@ private:
     void sendFrame(const std::vector<uint8_t>& frame);
 
     /**
-     * @brief Constructs an API frame for transmission.
-     * @param packet The SCALPEL packet to encapsulate.
-     * @return The constructed API frame.
+     * @brief Sends an API frame held in a caller-owned buffer.
+     * @param frame Pointer to the API frame.
+     * @param length Number of bytes in the frame.
+     * @throws RadioException if sending fails.
+     */
+    void sendFrame(const uint8_t* frame, size_t length);
+
+    /**
+     * @brief Sends an API frame built as segments with a single gather write.
+     * @param frame The API frame to send.
+     * @throws RadioException if sending fails.
      */
-    std::vector<uint8_t> constructTransmitRequest(const SCALPEL::Packet& packet);
+    void sendFrame(const SCALPEL::GatherFrame& frame);
+
+    /// Transmit Request bytes around the RF data: delimiter, length, 14 header bytes and checksum.
+    static constexpr size_t TRANSMIT_REQUEST_OVERHEAD = 18;
+
+    /// Largest RF payload of one transmission (the module's NP value).
+    static constexpr size_t MAX_RF_DATA_LENGTH = 256;
+
+    /// Largest Transmit Request, carrying one or more SCALPEL packets.
+    static constexpr size_t MAX_TRANSMIT_REQUEST_LENGTH =
+        TRANSMIT_REQUEST_OVERHEAD + MAX_RF_DATA_LENGTH;
+
+    static_assert(MAX_TRANSMIT_REQUEST_LENGTH <= SCALPEL::GatherFrame::INLINE_CAPACITY,
+                  "A Transmit Request must fit in a gather frame");
 
     /**
-     * @brief Parses an API frame into a SCALPEL packet.
+     * @brief Appends an API frame to a gather frame: the header, each packet assembled in place
+     *        as RF data and the checksum, accumulated as the segments are added.
+     * @param packets The SCALPEL packets to encapsulate.
+     * @param frame The frame to append to.
+     * @throws std::length_error if the packets exceed MAX_RF_DATA_LENGTH.
+     */
+    void constructTransmitRequest(SCALPEL::Span<const SCALPEL::Packet> packets, SCALPEL::GatherFrame& frame);
+
+    /**
+     * @brief Appends the Transmit Request header for rfDataLength bytes of RF data.
+     * @param frame The frame to append to.
+     * @param rfDataLength Bytes of RF data that will follow.
+     * @return Byte sum of the header bytes the checksum covers.
+     */
+    static uint8_t appendTransmitRequestHeader(SCALPEL::GatherFrame& frame, size_t rfDataLength);
+
+    /**
+     * @brief Passes the RF data of a Receive Packet frame through the deinterleaver and queues
+     *        the packets it yields.
      * @param frame The received API frame.
-     * @param packet The parsed SCALPEL packet.
-     * @return true if parsing is successful, false otherwise.
+     * @return false if the RF data held no packet and was not part of an interleaved block.
+     */
+    bool parseRxPackets(SCALPEL::Span<const uint8_t> frame);
+
+    /**
+     * @brief Queues every valid SCALPEL packet in RF data.
+     * @param rfData Packets back to back, as sent or as restored by the deinterleaver.
+     * @return Number of packets queued.
      */
-    bool parseRxPacket(const std::vector<uint8_t>& frame, SCALPEL::Packet& packet);
+    size_t queuePackets(SCALPEL::Span<const uint8_t> rfData);
 
     // Boost.Asio components
     boost::asio::io_service ioService;
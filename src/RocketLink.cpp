@@ -6,13 +6,12 @@ namespace Core {
 
 RocketLink::RocketLink(std::shared_ptr<Radio::RadioInterface> radioInterface)
     : avcProtocol(std::make_shared<AVC::AVCProtocol>(std::make_shared<SCALPEL::Communicator>(
-          [](const std::vector<uint8_t>& /*data*/) {
-              // Handle received data
-              // This lambda will be called when data is received
-          }
+          nullptr // AVCProtocol installs its own receive callback
       ))),
       packetHandler(), // Initialize packetHandler if necessary
       radio(radioInterface),
+      aggregator(radio->getMaxBatchLength(), std::chrono::microseconds(0),
+                 [this](SCALPEL::Span<const SCALPEL::Packet> packets) { radio->sendPackets(packets); }),
       commandManager(std::make_shared<AVC::CommandManager>(avcProtocol)),
       telemetryBuffer(100), // Example capacity
       diagnostics(), // Default constructor
@@ -104,6 +103,12 @@ void RocketLink::registerCallbacks(API::Callbacks* callbacks) {
     logger.log(LogLevel::INFO, "User callbacks registered.");
 }
 
+void RocketLink::setAggregationBudget(std::chrono::microseconds budget) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    aggregator.setLatencyBudget(budget);
+    sendCondition.notify_one();
+}
+
 AVC::Telemetry RocketLink::getTelemetry() {
     std::lock_guard<std::mutex> lock(telemetryMutex);
     auto telemetryOpt = telemetryBuffer.getLatestTelemetry();
@@ -118,33 +123,39 @@ AVC::Telemetry RocketLink::getTelemetry() {
 
 void RocketLink::sendLoop() {
     logger.log(LogLevel::INFO, "Send thread started.");
+    auto ready = [this]() { return !commandManager->isQueueEmpty() || !isRunning.load(); };
     while (isRunning.load()) {
         std::unique_lock<std::mutex> lock(sendMutex);
-        sendCondition.wait(lock, [this]() { return !commandManager->isQueueEmpty() || !isRunning.load(); });
-
-        if (!isRunning.load()) {
-            break;
+        if (aggregator.pending() == 0) {
+            sendCondition.wait(lock, ready);
+        } else {
+            // Wake up in time to send a batch whose latency budget runs out
+            sendCondition.wait_until(lock, aggregator.deadline(), ready);
         }
 
-        // Retrieve the next command from CommandManager
-        auto commandOpt = commandManager->getNextCommand();
-        if (commandOpt.has_value()) {
-            try {
+        try {
+            if (!isRunning.load()) {
+                // Send what the aggregator still holds instead of dropping it
+                aggregator.flush();
+                break;
+            }
+
+            // Queue every waiting command; the aggregator sends each batch
+            // once it is full or its oldest packet has waited long enough
+            while (auto commandOpt = commandManager->getNextCommand()) {
                 // Encode the command using AVCProtocol
                 auto encodedCommand = avcProtocol->encodeCommand(commandOpt.value());
 
                 // Create a SCALPEL::Packet with the encoded command
-                SCALPEL::Packet packet(encodedCommand);
-
-                // Transmit the packet via RadioInterface
-                radio->sendPacket(packet.assemble());
-
-                logger.log(LogLevel::DEBUG, "Command transmitted successfully.");
-            }
-            catch (const std::exception& ex) {
-                logger.log(LogLevel::ERROR, std::string("Error in sendLoop: ") + ex.what());
-                handleEvent("SendLoopError");
+                aggregator.add(SCALPEL::Packet(encodedCommand));
             }
+            aggregator.poll();
+
+            logger.log(LogLevel::DEBUG, "Commands transmitted successfully.");
+        }
+        catch (const std::exception& ex) {
+            logger.log(LogLevel::ERROR, std::string("Error in sendLoop: ") + ex.what());
+            handleEvent("SendLoopError");
         }
     }
     logger.log(LogLevel::INFO, "Send thread terminated.");
@@ -3,6 +3,7 @@
 
 #include "AVC/AVCProtocol.hpp"
 #include "SCALPEL/Packet.hpp"
+#include "SCALPEL/FrameAggregator.hpp"
 #include "PhysicalLayer/RadioInterface.hpp"
 #include "Management/CommandManager.hpp"
 #include "Management/TelemetryBuffer.hpp"
@@ -56,6 +57,13 @@ public:
      */
     void registerCallbacks(API::Callbacks* callbacks);
 
+    /**
+     * @brief Sets how long outgoing packets may wait to share a radio frame.
+     *        Zero (the default) sends every packet as soon as it is queued.
+     * @param budget Longest time a packet is held back for aggregation.
+     */
+    void setAggregationBudget(std::chrono::microseconds budget);
+
     /**
      * @brief Provides access to the latest telemetry data received from the rocket.
      * @return The most recent Telemetry object.
@@ -86,6 +94,7 @@ private:
     std::shared_ptr<AVC::AVCProtocol> avcProtocol;                                         ///< Manages AVC protocol operations
     SCALPEL::Packet packetHandler;                                                    ///< Handles SCALPEL packet operations
     std::shared_ptr<Radio::RadioInterface> radio;                        ///< Abstracted radio interface
+    SCALPEL::FrameAggregator aggregator;                                 ///< Batches outgoing packets into radio frames
     std::shared_ptr<AVC::CommandManager> commandManager;                           ///< Manages command queue and retransmissions
     AVC::TelemetryBuffer telemetryBuffer;                         ///< Buffers incoming telemetry data
     Diagnostics::Diagnostics diagnostics;                                 ///< Collects diagnostic information
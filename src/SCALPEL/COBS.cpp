@@ -1,58 +1,170 @@
 #include "COBS.hpp"
 #include "Packet.hpp"
 #include "Checksum.hpp"
+#include "Utils/CpuFeatures.hpp"
+#include <algorithm>
+
+#if defined(NOVALINK_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace SCALPEL {
 
+namespace {
+
+size_t findStartByteScalar(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] == Packet::START_BYTE) {
+            return i;
+        }
+    }
+    return length;
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+// Index of the lowest set bit of a nonzero mask
+inline size_t countTrailingZeros(unsigned mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<size_t>(index);
+#else
+    return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+}
+
+// SSE2 is part of the x86-64 baseline, so this path needs no runtime check.
+size_t findStartByteSSE2(const uint8_t* data, size_t length) {
+    const __m128i start = _mm_set1_epi8(static_cast<char>(Packet::START_BYTE));
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, start)));
+        if (mask != 0) {
+            return i + countTrailingZeros(mask);
+        }
+    }
+    return i + findStartByteScalar(data + i, length - i);
+}
+
+NOVALINK_TARGET("avx2")
+size_t findStartByteAVX2(const uint8_t* data, size_t length) {
+    const __m256i start = _mm256_set1_epi8(static_cast<char>(Packet::START_BYTE));
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, start)));
+        if (mask != 0) {
+            return i + countTrailingZeros(mask);
+        }
+    }
+    return i + findStartByteSSE2(data + i, length - i);
+}
+
+#endif // x86-64
+
+// Offset of the first START_BYTE in data, or length if there is none.
+size_t findStartByte(const uint8_t* data, size_t length) {
+#if defined(__x86_64__) || defined(_M_X64)
+    static const bool avx2 = CpuFeatures::get().avx2;
+    if (length < 16) {
+        return findStartByteScalar(data, length);
+    }
+    if (avx2 && length >= 32) {
+        return findStartByteAVX2(data, length);
+    }
+    return findStartByteSSE2(data, length);
+#else
+    return findStartByteScalar(data, length);
+#endif
+}
+
+// Store a code byte. Copied data bytes are never START_BYTE, but a code byte
+// is whenever a block holds START_BYTE - 1 data bytes.
+inline void writeCode(uint8_t* out, size_t position, uint8_t code) {
+    if (code == Packet::START_BYTE) {
+        throw std::runtime_error("COBS encoding failed to eliminate start byte from payload.");
+    }
+    out[position] = code;
+}
+
+} // namespace
+
 COBS::COBSResult COBS::encode(const std::vector<uint8_t>& input) const {
     COBSResult result;
-    std::vector<uint8_t> encoded;
-    encoded.reserve(input.size() + 2); // Estimate extra bytes
+    result.encodedPayload.resize(maxEncodedLength(input.size()));
+
+    EncodeResult encoded = encodeInto(input, result.encodedPayload);
+    result.encodedPayload.resize(encoded.length);
+    result.index = encoded.index;
 
-    size_t code_ptr = 0;
-    encoded.push_back(0x00); // Placeholder for first code
-    code_ptr = encoded.size() - 1;
+    return result;
+}
+
+COBS::EncodeResult COBS::encodeInto(Span<const uint8_t> input, Span<uint8_t> output) const {
+    if (output.size() < maxEncodedLength(input.size())) {
+        throw std::length_error("COBS output buffer too small for encoded payload.");
+    }
+
+    const uint8_t* in = input.data();
+    uint8_t* out = output.data();
+    size_t pos = 0;
+    size_t code_ptr = 0; // Placeholder for first code
+    size_t written = 1;
     uint8_t code = 1;
     uint8_t index = 0;
 
-    for (size_t i = 0; i < input.size(); ++i) {
-        if (input[i] == Packet::START_BYTE) {
-            encoded[code_ptr] = code;
+    while (pos < input.size()) {
+        // Copy up to the next START_BYTE, or until the block is full
+        size_t limit = std::min<size_t>(input.size() - pos, 0xFFu - code);
+        size_t run = findStartByte(in + pos, limit);
+        std::copy_n(in + pos, run, out + written);
+        written += run;
+        pos += run;
+        code = static_cast<uint8_t>(code + run);
+
+        if (run < limit) {
+            // Replace the START_BYTE with the code of the block it ends
+            writeCode(out, code_ptr, code);
             code = 1;
-            encoded.push_back(0x00); // Placeholder for next code
-            code_ptr = encoded.size() - 1;
+            code_ptr = written++; // Placeholder for next code
             index++;
-        } else {
-            encoded.push_back(input[i]);
-            code++;
-            if (code == 0xFF) { // Maximum code value
-                encoded[code_ptr] = code;
-                code = 1;
-                encoded.push_back(0x00); // Placeholder for next code
-                code_ptr = encoded.size() - 1;
-            }
+            pos++;
+        } else if (code == 0xFF) { // Maximum code value
+            writeCode(out, code_ptr, code);
+            code = 1;
+            code_ptr = written++; // Placeholder for next code
         }
     }
 
-    encoded[code_ptr] = code;
-
-    result.encodedPayload = encoded;
-    result.index = index;
+    writeCode(out, code_ptr, code);
 
-    // Verify that no byte in encodedPayload equals START_BYTE
-    for (const auto& byte : result.encodedPayload) {
-        if (byte == Packet::START_BYTE) {
+#ifndef NDEBUG
+    // Data bytes are copied verbatim between START_BYTEs, so only code bytes
+    // can collide; re-check the whole output in debug builds.
+    for (size_t i = 0; i < written; ++i) {
+        if (output[i] == Packet::START_BYTE) {
             throw std::runtime_error("COBS encoding failed to eliminate start byte from payload.");
         }
     }
+#endif
 
-    return result;
+    return EncodeResult{written, index};
 }
 
 std::vector<uint8_t> COBS::decode(const std::vector<uint8_t>& encoded, uint8_t index) const {
-    std::vector<uint8_t> decoded;
-    decoded.reserve(encoded.size());
+    std::vector<uint8_t> decoded(encoded.size());
+    decoded.resize(decodeInto(encoded, index, decoded));
+    return decoded;
+}
 
+size_t COBS::decodeInto(Span<const uint8_t> encoded, uint8_t index, Span<uint8_t> output) const {
+    size_t written = 0;
     size_t i = 0;
 
     while (i < encoded.size()) {
@@ -61,18 +173,26 @@ std::vector<uint8_t> COBS::decode(const std::vector<uint8_t>& encoded, uint8_t i
             throw std::runtime_error("Invalid COBS encoding: code byte is zero.");
         }
         i++;
-        for (uint8_t j = 1; j < code; j++) {
-            if (i >= encoded.size()) {
-                throw std::runtime_error("Invalid COBS encoding: not enough bytes.");
-            }
-            decoded.push_back(encoded[i]);
-            i++;
+
+        size_t run = code - 1u;
+        if (encoded.size() - i < run) {
+            throw std::runtime_error("Invalid COBS encoding: not enough bytes.");
+        }
+        if (output.size() - written < run) {
+            throw std::length_error("COBS output buffer too small for decoded payload.");
         }
+        std::copy_n(encoded.data() + i, run, output.data() + written);
+        written += run;
+        i += run;
+
         if (code < 0xFF && i < encoded.size()) {
-            decoded.push_back(Packet::START_BYTE);
             if (index == 0) {
                 throw std::runtime_error("COBS decode: unexpected start byte.");
             }
+            if (written == output.size()) {
+                throw std::length_error("COBS output buffer too small for decoded payload.");
+            }
+            output[written++] = Packet::START_BYTE;
             index--;
         }
     }
@@ -81,7 +201,7 @@ std::vector<uint8_t> COBS::decode(const std::vector<uint8_t>& encoded, uint8_t i
         throw std::runtime_error("COBS decode: index mismatch.");
     }
 
-    return decoded;
+    return written;
 }
 
 } // namespace SCALPEL
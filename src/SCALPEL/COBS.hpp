@@ -2,8 +2,10 @@
 #define COBS_HPP
 
 #include <cstdint>
+#include <cstddef>
 #include <vector>
 #include <stdexcept>
+#include "Span.hpp"
 
 namespace SCALPEL {
 
@@ -15,13 +17,35 @@ public:
         uint8_t index; // Number of START_BYTE (170) replaced
     };
 
+    // Result of encoding into a caller-provided buffer
+    struct EncodeResult {
+        size_t length; // Number of bytes written to the output
+        uint8_t index; // Number of START_BYTE (170) replaced
+    };
+
+    // Upper bound on the encoded size of an input of the given length:
+    // one leading code byte plus one extra code byte per 254-byte run
+    static constexpr size_t maxEncodedLength(size_t inputLength) {
+        return inputLength + inputLength / 254 + 1;
+    }
+
     // Encode the input data using COBS
     // Returns encoded payload and index
     COBSResult encode(const std::vector<uint8_t>& input) const;
 
+    // Encode the input into a caller-provided buffer without allocating
+    // Output must hold at least maxEncodedLength(input.size()) bytes,
+    // otherwise std::length_error is thrown
+    EncodeResult encodeInto(Span<const uint8_t> input, Span<uint8_t> output) const;
+
     // Decode the input data using COBS
     // Takes encoded payload and index, returns decoded payload
     std::vector<uint8_t> decode(const std::vector<uint8_t>& encoded, uint8_t index) const;
+
+    // Decode into a caller-provided buffer without allocating
+    // Returns the decoded length; the decoded data is never longer than the
+    // encoded data. Throws std::length_error if the output is too small
+    size_t decodeInto(Span<const uint8_t> encoded, uint8_t index, Span<uint8_t> output) const;
 };
 
 } // namespace SCALPEL
@@ -0,0 +1,302 @@
+#include "CaptureDecoder.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <vector>
+#endif
+
+namespace SCALPEL {
+
+namespace {
+
+// Bytes parsed ahead of each chunk. Any packet covering the chunk start
+// begins within one packet length of it; the rest lets a parser that
+// started on a false START_BYTE fall back into step with the stream.
+constexpr uint64_t LOOKBACK_LENGTH = 4 * Packet::MAX_PACKET_LENGTH;
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// Read-only mapping of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open capture " + path + ": " + std::strerror(errno));
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot stat capture " + path + ": " + std::strerror(error));
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length != 0) {
+            void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                throw std::runtime_error("Cannot map capture " + path + ": " + std::strerror(error));
+            }
+            data = static_cast<const uint8_t*>(mapped);
+            // Chunks are read front to back; let the kernel read ahead
+            ::madvise(mapped, length, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data != nullptr) {
+            ::munmap(const_cast<uint8_t*>(data), length);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    Span<const uint8_t> bytes() const { return Span<const uint8_t>(data, length); }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+};
+
+#else
+
+// Whole file read into memory, for systems without mmap
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw std::runtime_error("Cannot open capture " + path + ": " + std::strerror(errno));
+        }
+        std::streamoff size = file.tellg();
+        if (size < 0) {
+            throw std::runtime_error("Cannot size capture " + path);
+        }
+        contents.resize(static_cast<size_t>(size));
+        file.seekg(0);
+        if (!contents.empty() &&
+            !file.read(reinterpret_cast<char*>(contents.data()), static_cast<std::streamsize>(contents.size()))) {
+            throw std::runtime_error("Cannot read capture " + path);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    Span<const uint8_t> bytes() const { return Span<const uint8_t>(contents.data(), contents.size()); }
+
+private:
+    std::vector<uint8_t> contents;
+};
+
+#endif
+
+void accumulate(FrameParser::Stats& total, const FrameParser::Stats& chunk) {
+    total.bytesConsumed += chunk.bytesConsumed;
+    total.framesParsed += chunk.framesParsed;
+    total.bytesDiscarded += chunk.bytesDiscarded;
+    total.resyncs += chunk.resyncs;
+    total.bytesCorrected += chunk.bytesCorrected;
+}
+
+} // namespace
+
+CaptureDecoder::CaptureDecoder() : CaptureDecoder(Options()) {}
+
+CaptureDecoder::CaptureDecoder(Options options)
+    : threads(options.threads),
+      chunkLength(options.chunkLength),
+      maxChunksInFlight(options.maxChunksInFlight),
+      headerProtection(options.headerProtection) {
+    if (chunkLength == 0) {
+        throw std::invalid_argument("Chunk length must be nonzero.");
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (maxChunksInFlight == 0) {
+        maxChunksInFlight = 2 * threads;
+    }
+}
+
+std::vector<uint64_t> CaptureDecoder::chunkBoundaries(Span<const uint8_t> capture) const {
+    std::vector<uint64_t> boundaries{0};
+    if (capture.empty()) {
+        return boundaries;
+    }
+    uint64_t target = chunkLength;
+    while (target < capture.size()) {
+        const void* start = std::memchr(capture.data() + target, Packet::START_BYTE, capture.size() - target);
+        if (start == nullptr) {
+            break;
+        }
+        uint64_t boundary = static_cast<uint64_t>(static_cast<const uint8_t*>(start) - capture.data());
+        boundaries.push_back(boundary);
+        target = boundary + chunkLength;
+    }
+    boundaries.push_back(capture.size());
+    return boundaries;
+}
+
+void CaptureDecoder::decodeChunk(Span<const uint8_t> capture, uint64_t begin, uint64_t end,
+                                 ChunkResult& result) const {
+    uint64_t from = begin > LOOKBACK_LENGTH ? begin - LOOKBACK_LENGTH : 0;
+    uint64_t to = std::min<uint64_t>(end + Packet::MAX_PACKET_LENGTH - 1, capture.size());
+
+    result.offset = begin;
+    result.length = end - begin;
+    result.stats = FrameParser::Stats{};
+    result.stats.bytesConsumed = result.length;
+
+    uint64_t covered = 0;
+    uint64_t correctedBefore = 0;
+    const FrameParser* self = nullptr;
+    FrameParser parser([&](const PacketView& frame, uint64_t offset) {
+        uint64_t start = from + offset;
+        uint64_t stop = start + frame.bytes().size();
+        uint64_t corrected = self->getStats().bytesCorrected - correctedBefore;
+        correctedBefore += corrected;
+        if (stop > begin && start < end) {
+            covered += std::min(stop, end) - std::max(start, begin);
+        }
+        if (start >= begin && start < end) {
+            result.packets.push_back(frame.toPacket());
+            result.packetOffsets.push_back(start);
+            result.stats.bytesCorrected += corrected;
+        }
+    }, headerProtection);
+    self = &parser;
+
+    parser.feed(Span<const uint8_t>(capture.data() + from, begin - from));
+    uint64_t resyncsBefore = parser.getStats().resyncs;
+    parser.feed(Span<const uint8_t>(capture.data() + begin, end - begin));
+    result.stats.resyncs = parser.getStats().resyncs - resyncsBefore;
+    parser.feed(Span<const uint8_t>(capture.data() + end, to - end));
+
+    result.stats.framesParsed = result.packets.size();
+    result.stats.bytesDiscarded = result.length - covered;
+}
+
+FrameParser::Stats CaptureDecoder::decode(Span<const uint8_t> capture, const ChunkCallback& onChunk) const {
+    std::vector<uint64_t> boundaries = chunkBoundaries(capture);
+    size_t count = boundaries.size() - 1;
+    FrameParser::Stats total;
+    if (count == 0) {
+        return total;
+    }
+
+    std::vector<ChunkResult> results(count);
+    std::vector<uint8_t> ready(count, 0);
+    std::mutex mutex;
+    std::condition_variable chunkReady;
+    std::condition_variable windowMoved;
+    size_t next = 0;      // Next chunk a worker takes
+    size_t delivered = 0; // Chunks passed to onChunk
+    bool stopping = false;
+    std::exception_ptr failure;
+
+    auto work = [&] {
+        for (;;) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                windowMoved.wait(lock, [&] {
+                    return stopping || next == count || next < delivered + maxChunksInFlight;
+                });
+                if (stopping || next == count) {
+                    return;
+                }
+                index = next++;
+            }
+            try {
+                results[index].index = index;
+                decodeChunk(capture, boundaries[index], boundaries[index + 1], results[index]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                stopping = true;
+                chunkReady.notify_all();
+                windowMoved.notify_all();
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ready[index] = 1;
+            }
+            chunkReady.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    size_t workers = std::min(threads, count);
+    pool.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        pool.emplace_back(work);
+    }
+
+    // Deliver chunks in order as they complete, freeing each afterwards
+    try {
+        for (size_t i = 0; i < count; ++i) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                chunkReady.wait(lock, [&] { return ready[i] || stopping; });
+                if (!ready[i]) {
+                    break;
+                }
+            }
+            accumulate(total, results[i].stats);
+            if (onChunk) {
+                onChunk(results[i]);
+            }
+            results[i] = ChunkResult();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                delivered = i + 1;
+            }
+            windowMoved.notify_all();
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failure) {
+            failure = std::current_exception();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    windowMoved.notify_all();
+    for (std::thread& worker : pool) {
+        worker.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return total;
+}
+
+FrameParser::Stats CaptureDecoder::decodeFile(const std::string& path, const ChunkCallback& onChunk) const {
+    MappedFile file(path);
+    return decode(file.bytes(), onChunk);
+}
+
+} // namespace SCALPEL
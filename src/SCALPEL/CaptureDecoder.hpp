@@ -0,0 +1,81 @@
+#ifndef CAPTUREDECODER_HPP
+#define CAPTUREDECODER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "FrameParser.hpp"
+#include "Packet.hpp"
+#include "Span.hpp"
+
+namespace SCALPEL {
+
+// Decodes a recorded link byte stream on a pool of threads. The capture is
+// cut into chunks of roughly chunkLength bytes, each starting at a
+// START_BYTE, and every chunk is run through its own FrameParser. A parser
+// starts a little before its chunk so it is already in sync with the
+// stream when the chunk begins, and reads a little past the end to finish
+// the last packet; it keeps exactly the packets whose START_BYTE lies in
+// the chunk. The result matches one FrameParser fed the whole capture.
+//
+// Chunks are delivered in capture order. At most maxChunksInFlight decoded
+// chunks are held at once, so memory stays bounded however long the
+// capture is.
+class CaptureDecoder {
+public:
+    struct Options {
+        size_t threads = 0;                     // 0 uses every hardware thread
+        size_t chunkLength = size_t{4} << 20;   // Target bytes per chunk
+        size_t maxChunksInFlight = 0;           // 0 means twice the thread count
+        PacketFormat::HeaderProtection headerProtection = PacketFormat::HeaderProtection::Checksum;
+    };
+
+    struct ChunkResult {
+        size_t index = 0;            // Position of the chunk in the capture
+        uint64_t offset = 0;         // Capture offset of the first byte
+        uint64_t length = 0;         // Bytes in the chunk
+        std::vector<Packet> packets; // Packets starting in the chunk, in order
+        std::vector<uint64_t> packetOffsets; // Capture offset of each packet
+        // bytesConsumed is the chunk length and bytesDiscarded its bytes not
+        // covered by any packet; resyncs and bytesCorrected are counted
+        // where the parser detected them
+        FrameParser::Stats stats;
+    };
+
+    // Called on the thread that called decode(), in capture order, while
+    // the workers decode the chunks after it. The result may be moved from
+    using ChunkCallback = std::function<void(ChunkResult& chunk)>;
+
+    CaptureDecoder();
+    explicit CaptureDecoder(Options options);
+
+    // Decode capture, returning the statistics summed over all chunks.
+    // An exception thrown by onChunk stops the workers and is rethrown
+    FrameParser::Stats decode(Span<const uint8_t> capture, const ChunkCallback& onChunk) const;
+
+    // Memory-map the file at path (read it into memory where there is no
+    // mmap) and decode it.
+    // Throws std::runtime_error if the file cannot be opened or mapped
+    FrameParser::Stats decodeFile(const std::string& path, const ChunkCallback& onChunk) const;
+
+    // Chunk boundaries decode() uses for a capture: the start offset of each
+    // chunk, followed by the capture length
+    std::vector<uint64_t> chunkBoundaries(Span<const uint8_t> capture) const;
+
+    size_t getThreadCount() const { return threads; }
+
+private:
+    // Decode capture[begin, end), parsing from before begin to stay in sync
+    void decodeChunk(Span<const uint8_t> capture, uint64_t begin, uint64_t end, ChunkResult& result) const;
+
+    size_t threads;
+    size_t chunkLength;
+    size_t maxChunksInFlight;
+    PacketFormat::HeaderProtection headerProtection;
+};
+
+} // namespace SCALPEL
+
+#endif // CAPTUREDECODER_HPP
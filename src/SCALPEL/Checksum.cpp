@@ -1,16 +1,261 @@
 #include "Checksum.hpp"
+#include "ChecksumTables.hpp"
+#include "Utils/CpuFeatures.hpp"
+#include <array>
+#include <cstring>
+
+#if defined(NOVALINK_X86)
+#include <immintrin.h>
+#endif
 
 namespace SCALPEL {
 
+namespace {
+
+using namespace ChecksumTables;
+
+// Inputs shorter than this are cheaper to run through the single byte table
+// than to set up the slice-by-8 loop.
+constexpr size_t CRC8_SLICE_THRESHOLD = 8;
+
+// Shortest input the carry-less multiply kernel accepts (four 128-bit lanes).
+// BM_CalculateCRC8_Crossover_* shows it already beats slice-by-8 at this size.
+constexpr size_t CRC8_CLMUL_THRESHOLD = 64;
+
+inline uint8_t crc8TableUpdate(uint8_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        crc = crc8Update(crc, data[i]);
+    }
+    return crc;
+}
+
+uint8_t crc8SlicedUpdate(uint8_t crc, const uint8_t* data, size_t length) {
+    while (length >= 8) {
+        crc = CRC8_SLICES[7][crc ^ data[0]] ^ CRC8_SLICES[6][data[1]] ^
+              CRC8_SLICES[5][data[2]] ^ CRC8_SLICES[4][data[3]] ^
+              CRC8_SLICES[3][data[4]] ^ CRC8_SLICES[2][data[5]] ^
+              CRC8_SLICES[1][data[6]] ^ CRC8_SLICES[0][data[7]];
+        data += 8;
+        length -= 8;
+    }
+
+    if (length >= 4) {
+        crc = CRC8_SLICES[3][crc ^ data[0]] ^ CRC8_SLICES[2][data[1]] ^
+              CRC8_SLICES[1][data[2]] ^ CRC8_SLICES[0][data[3]];
+        data += 4;
+        length -= 4;
+    }
+
+    return crc8TableUpdate(crc, data, length);
+}
+
+#if defined(NOVALINK_X86)
+
+// x^n mod P(x) for the CRC-8 generator P(x) = x^8 + x^2 + x + 1.
+constexpr uint64_t xPowModCRC8(unsigned n) {
+    uint16_t remainder = 1;
+    for (unsigned i = 0; i < n; ++i) {
+        remainder = static_cast<uint16_t>(remainder << 1);
+        if (remainder & 0x100) {
+            remainder ^= 0x100 | CRC8_POLYNOMIAL;
+        }
+    }
+    return remainder;
+}
+
+// Folding constants. A 128-bit block X = H*x^64 + L moved d bits further
+// along the message is congruent to H*(x^(d+64) mod P) + L*(x^d mod P), and
+// since the constants are below degree 8 the product still fits in 128 bits.
+constexpr uint64_t FOLD_128_HIGH = xPowModCRC8(128 + 64);
+constexpr uint64_t FOLD_128_LOW = xPowModCRC8(128);
+constexpr uint64_t FOLD_512_HIGH = xPowModCRC8(512 + 64);
+constexpr uint64_t FOLD_512_LOW = xPowModCRC8(512);
+
+// The CRC is not reflected, so the first message byte is the most significant.
+NOVALINK_TARGET("ssse3")
+inline __m128i loadBigEndian(const uint8_t* data) {
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), reverse);
+}
+
+NOVALINK_TARGET("pclmul,ssse3")
+inline __m128i foldBlock(__m128i accumulator, __m128i constants, __m128i next) {
+    __m128i high = _mm_clmulepi64_si128(accumulator, constants, 0x11);
+    __m128i low = _mm_clmulepi64_si128(accumulator, constants, 0x00);
+    return _mm_xor_si128(_mm_xor_si128(high, low), next);
+}
+
+// Folds 64 bytes per iteration over four independent accumulators, merges them,
+// and hands the 128-bit remainder plus the unaligned tail to the table engine.
+// Requires length >= CRC8_CLMUL_THRESHOLD.
+NOVALINK_TARGET("pclmul,ssse3")
+uint8_t crc8CarrylessMultiply(const uint8_t* data, size_t length) {
+    const __m128i fold512 = _mm_set_epi64x(static_cast<long long>(FOLD_512_HIGH),
+                                           static_cast<long long>(FOLD_512_LOW));
+    const __m128i fold128 = _mm_set_epi64x(static_cast<long long>(FOLD_128_HIGH),
+                                           static_cast<long long>(FOLD_128_LOW));
+
+    __m128i x0 = loadBigEndian(data);
+    __m128i x1 = loadBigEndian(data + 16);
+    __m128i x2 = loadBigEndian(data + 32);
+    __m128i x3 = loadBigEndian(data + 48);
+    data += 64;
+    length -= 64;
+
+    while (length >= 64) {
+        x0 = foldBlock(x0, fold512, loadBigEndian(data));
+        x1 = foldBlock(x1, fold512, loadBigEndian(data + 16));
+        x2 = foldBlock(x2, fold512, loadBigEndian(data + 32));
+        x3 = foldBlock(x3, fold512, loadBigEndian(data + 48));
+        data += 64;
+        length -= 64;
+    }
+
+    x1 = foldBlock(x0, fold128, x1);
+    x2 = foldBlock(x1, fold128, x2);
+    x3 = foldBlock(x2, fold128, x3);
+
+    while (length >= 16) {
+        x3 = foldBlock(x3, fold128, loadBigEndian(data));
+        data += 16;
+        length -= 16;
+    }
+
+    // The remainder is congruent to everything consumed so far; with a zero
+    // initial value its CRC followed by the tail equals the CRC of the input.
+    alignas(16) uint8_t remainder[16];
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    _mm_store_si128(reinterpret_cast<__m128i*>(remainder), _mm_shuffle_epi8(x3, reverse));
+    uint8_t crc = crc8SlicedUpdate(0x00, remainder, sizeof(remainder));
+    return crc8SlicedUpdate(crc, data, length);
+}
+
+#endif // NOVALINK_X86
+
+// Inputs at least this long use the AVX2 kernel when the CPU supports it.
+constexpr size_t TWO_BIT_AVX2_THRESHOLD = 64;
+
+inline uint64_t loadWord(const uint8_t* data) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+inline uint64_t popcountPortable(uint64_t value) {
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (value * 0x0101010101010101ULL) >> 56;
+}
+
+inline uint64_t twoBitTail(const uint8_t* data, size_t length) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < length; ++i) {
+        total += TWO_BIT_TABLE[data[i]];
+    }
+    return total;
+}
+
+uint8_t twoBitPortable(const uint8_t* data, size_t length) {
+    uint64_t total = 0;
+    for (; length >= 8; data += 8, length -= 8) {
+        total += popcountPortable(loadWord(data));
+    }
+    return static_cast<uint8_t>((total + twoBitTail(data, length)) & 0x03);
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+NOVALINK_TARGET("popcnt")
+uint8_t twoBitPopcnt(const uint8_t* data, size_t length) {
+    uint64_t total = 0;
+    for (; length >= 8; data += 8, length -= 8) {
+        total += static_cast<uint64_t>(_mm_popcnt_u64(loadWord(data)));
+    }
+    return static_cast<uint8_t>((total + twoBitTail(data, length)) & 0x03);
+}
+
+// Nibble lookup popcount (vpshufb). Per-byte counts accumulate in 8-bit lanes;
+// wrapping at 256 is harmless because only the total modulo 4 is needed.
+NOVALINK_TARGET("avx2")
+uint8_t twoBitAVX2(const uint8_t* data, size_t length) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+    __m256i counts = _mm256_setzero_si256();
+
+    for (; length >= 32; data += 32, length -= 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i low = _mm256_and_si256(bytes, lowNibble);
+        __m256i high = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), lowNibble);
+        counts = _mm256_add_epi8(counts, _mm256_shuffle_epi8(lookup, low));
+        counts = _mm256_add_epi8(counts, _mm256_shuffle_epi8(lookup, high));
+    }
+
+    __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+    uint64_t total = static_cast<uint64_t>(_mm256_extract_epi64(sums, 0)) +
+                     static_cast<uint64_t>(_mm256_extract_epi64(sums, 1)) +
+                     static_cast<uint64_t>(_mm256_extract_epi64(sums, 2)) +
+                     static_cast<uint64_t>(_mm256_extract_epi64(sums, 3));
+    return static_cast<uint8_t>((total + twoBitTail(data, length)) & 0x03);
+}
+
+#endif // x86-64
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+// crc32 instruction, eight bytes per step with a byte-wise tail
+NOVALINK_TARGET("sse4.2")
+uint32_t crc32cHardware(uint32_t crc, const uint8_t* data, size_t length) {
+    uint64_t wide = crc;
+    for (; length >= 8; data += 8, length -= 8) {
+        wide = _mm_crc32_u64(wide, loadWord(data));
+    }
+    crc = static_cast<uint32_t>(wide);
+    for (; length != 0; ++data, --length) {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+    return crc;
+}
+
+#endif // x86-64
+
+inline uint32_t crc32cTableUpdate(uint32_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        crc = crc32cUpdate(crc, data[i]);
+    }
+    return crc;
+}
+
+bool carrylessMultiplyAvailable() {
+#if defined(NOVALINK_X86)
+    static const bool available = CpuFeatures::get().pclmul && CpuFeatures::get().ssse3;
+    return available;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
 uint8_t Checksum::calculateCRC8(const uint8_t* data, size_t length) {
+    if (length < CRC8_SLICE_THRESHOLD) {
+        return crc8TableUpdate(0x00, data, length);
+    }
+    if (length >= CRC8_CLMUL_THRESHOLD && carrylessMultiplyAvailable()) {
+        return calculateCRC8CLMUL(data, length);
+    }
+    return crc8SlicedUpdate(0x00, data, length);
+}
+
+uint8_t Checksum::calculateCRC8Bitwise(const uint8_t* data, size_t length) {
     uint8_t crc = 0x00; // Initial value
-    const uint8_t polynomial = 0x07; // CRC-8 polynomial x^8 + x^2 + x + 1
 
     for (size_t i = 0; i < length; ++i) {
         crc ^= data[i];
         for (uint8_t bit = 0; bit < 8; ++bit) {
             if (crc & 0x80) {
-                crc = (crc << 1) ^ polynomial;
+                crc = (crc << 1) ^ CRC8_POLYNOMIAL;
             } else {
                 crc <<= 1;
             }
@@ -19,19 +264,67 @@ uint8_t Checksum::calculateCRC8(const uint8_t* data, size_t length) {
     return crc;
 }
 
+uint8_t Checksum::calculateCRC8Table(const uint8_t* data, size_t length) {
+    return crc8TableUpdate(0x00, data, length);
+}
+
+uint8_t Checksum::calculateCRC8Sliced(const uint8_t* data, size_t length) {
+    return crc8SlicedUpdate(0x00, data, length);
+}
+
+uint8_t Checksum::calculateCRC8CLMUL(const uint8_t* data, size_t length) {
+#if defined(NOVALINK_X86)
+    if (length >= CRC8_CLMUL_THRESHOLD && carrylessMultiplyAvailable()) {
+        return crc8CarrylessMultiply(data, length);
+    }
+#endif
+    return crc8SlicedUpdate(0x00, data, length);
+}
+
 bool Checksum::validateCRC8(uint8_t checksum, const uint8_t* data, size_t length) {
     uint8_t calculated = calculateCRC8(data, length);
     return calculated == checksum;
 }
 
-uint8_t Checksum::calculate2BitChecksum(uint8_t byte) {
-    uint8_t bitCount = 0;
-    for (uint8_t i = 0; i < 8; ++i) {
-        if (byte & (1 << i)) {
-            ++bitCount;
-        }
+uint16_t Checksum::calculateCRC16(const uint8_t* data, size_t length) {
+    return updateCRC16(CRC16_INITIAL, data, length);
+}
+
+uint16_t Checksum::updateCRC16(uint16_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        crc = crc16Update(crc, data[i]);
+    }
+    return crc;
+}
+
+uint32_t Checksum::calculateCRC32C(const uint8_t* data, size_t length) {
+    return ~updateCRC32C(CRC32C_INITIAL, data, length);
+}
+
+uint32_t Checksum::updateCRC32C(uint32_t crc, const uint8_t* data, size_t length) {
+#if defined(__x86_64__) || defined(_M_X64)
+    static const bool sse42 = CpuFeatures::get().sse42;
+    if (sse42) {
+        return crc32cHardware(crc, data, length);
     }
-    return bitCount % 4;
+#endif
+    return crc32cTableUpdate(crc, data, length);
+}
+
+uint32_t Checksum::calculateCRC32CTable(const uint8_t* data, size_t length) {
+    return ~crc32cTableUpdate(CRC32C_INITIAL, data, length);
+}
+
+uint32_t Checksum::calculate(PacketFormat::Integrity integrity, const uint8_t* data, size_t length) {
+    switch (integrity) {
+        case PacketFormat::Integrity::Crc16: return calculateCRC16(data, length);
+        case PacketFormat::Integrity::Crc32c: return calculateCRC32C(data, length);
+        default: return calculateCRC8(data, length);
+    }
+}
+
+uint8_t Checksum::calculate2BitChecksum(uint8_t byte) {
+    return TWO_BIT_TABLE[byte];
 }
 
 bool Checksum::validate2BitChecksum(uint8_t expected, uint8_t byte) {
@@ -40,16 +333,23 @@ bool Checksum::validate2BitChecksum(uint8_t expected, uint8_t byte) {
 }
 
 uint8_t Checksum::calculate2BitChecksum(const uint8_t* data, size_t length) {
-    uint8_t totalBitCount = 0;
-    for (size_t i = 0; i < length; ++i) {
-        uint8_t byte = data[i];
-        for (uint8_t bit = 0; bit < 8; ++bit) {
-            if (byte & (1 << bit)) {
-                ++totalBitCount;
-            }
-        }
+#if defined(__x86_64__) || defined(_M_X64)
+    static const bool avx2 = CpuFeatures::get().avx2;
+    if (length >= TWO_BIT_AVX2_THRESHOLD && avx2) {
+        return twoBitAVX2(data, length);
+    }
+#endif
+    return calculate2BitChecksumScalar(data, length);
+}
+
+uint8_t Checksum::calculate2BitChecksumScalar(const uint8_t* data, size_t length) {
+#if defined(__x86_64__) || defined(_M_X64)
+    static const bool popcnt = CpuFeatures::get().popcnt;
+    if (popcnt) {
+        return twoBitPopcnt(data, length);
     }
-    return totalBitCount % 4;
+#endif
+    return twoBitPortable(data, length);
 }
 
 } // namespace SCALPEL
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include "PacketFormat.hpp"
 
 namespace SCALPEL {
 
@@ -14,13 +15,56 @@ class Checksum {
 public:
     /**
      * @brief Calculate CRC-8 checksum for the given data.
-     * 
+     *
+     * Picks the fastest available engine for the input length. All engines
+     * produce identical results (polynomial 0x07, initial value 0x00).
+     *
      * @param data Pointer to data buffer.
      * @param length Number of bytes in data.
      * @return Calculated CRC-8 checksum.
      */
     static uint8_t calculateCRC8(const uint8_t* data, size_t length);
 
+    /**
+     * @brief Reference CRC-8 that shifts one bit at a time.
+     *
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Calculated CRC-8 checksum.
+     */
+    static uint8_t calculateCRC8Bitwise(const uint8_t* data, size_t length);
+
+    /**
+     * @brief CRC-8 using a 256-entry lookup table, one byte per step.
+     *
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Calculated CRC-8 checksum.
+     */
+    static uint8_t calculateCRC8Table(const uint8_t* data, size_t length);
+
+    /**
+     * @brief CRC-8 using slice-by-8 tables, eight bytes per step with a slice-by-4 tail.
+     *
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Calculated CRC-8 checksum.
+     */
+    static uint8_t calculateCRC8Sliced(const uint8_t* data, size_t length);
+
+    /**
+     * @brief CRC-8 by folding 128-bit blocks with carry-less multiplication (PCLMULQDQ).
+     *
+     * Intended for long buffers such as capture files. Falls back to the
+     * slice-by-8 engine when the CPU lacks PCLMULQDQ or the input is shorter
+     * than 64 bytes.
+     *
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Calculated CRC-8 checksum.
+     */
+    static uint8_t calculateCRC8CLMUL(const uint8_t* data, size_t length);
+
     /**
      * @brief Validate CRC-8 checksum for the given data.
      * 
@@ -31,10 +75,76 @@ public:
      */
     static bool validateCRC8(uint8_t checksum, const uint8_t* data, size_t length);
 
+    /**
+     * @brief Calculate CRC-16/CCITT-FALSE checksum for the given data.
+     *
+     * Table driven (polynomial 0x1021, initial value 0xFFFF, not reflected).
+     *
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Calculated CRC-16 checksum.
+     */
+    static uint16_t calculateCRC16(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Continue a CRC-16 over more data.
+     *
+     * @param crc Register after the preceding data (0xFFFF before any).
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Updated register; the checksum once all data is fed.
+     */
+    static uint16_t updateCRC16(uint16_t crc, const uint8_t* data, size_t length);
+
+    /**
+     * @brief Calculate CRC-32C (Castagnoli) checksum for the given data.
+     *
+     * Uses the SSE4.2 crc32 instruction when available and the lookup
+     * table otherwise; both produce identical results.
+     *
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Calculated CRC-32C checksum.
+     */
+    static uint32_t calculateCRC32C(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Continue a CRC-32C over more data.
+     *
+     * The register is kept uninverted: start from 0xFFFFFFFF and invert the
+     * final value to obtain the checksum.
+     *
+     * @param crc Register after the preceding data.
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Updated register.
+     */
+    static uint32_t updateCRC32C(uint32_t crc, const uint8_t* data, size_t length);
+
+    /**
+     * @brief CRC-32C using a 256-entry lookup table, one byte per step.
+     *
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Calculated CRC-32C checksum.
+     */
+    static uint32_t calculateCRC32CTable(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Calculate the payload check of a packet integrity mode.
+     *
+     * @param integrity The mode.
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return CRC-8, CRC-16 or CRC-32C of the data.
+     */
+    static uint32_t calculate(PacketFormat::Integrity integrity, const uint8_t* data, size_t length);
+
     /**
      * @brief Calculate 2-bit checksum for a single byte.
      * 
-     * The 2-bit checksum is calculated as the number of set bits modulo 4.
+     * The 2-bit checksum is calculated as the number of set bits modulo 4,
+     * read from a compile-time lookup table.
      * 
      * @param byte The input byte.
      * @return Calculated 2-bit checksum.
@@ -54,12 +164,24 @@ public:
      * @brief Calculate 2-bit checksum for multiple bytes.
      * 
      * The 2-bit checksum is the sum of set bits in all bytes modulo 4.
+     * Longer inputs use an AVX2 nibble-lookup popcount when the CPU has it.
      * 
      * @param data Pointer to data buffer.
      * @param length Number of bytes in data.
      * @return Calculated 2-bit checksum.
      */
     static uint8_t calculate2BitChecksum(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Calculate the multi-byte 2-bit checksum one 64-bit word at a time.
+     *
+     * Uses the POPCNT instruction when available and a SWAR bit count otherwise.
+     *
+     * @param data Pointer to data buffer.
+     * @param length Number of bytes in data.
+     * @return Calculated 2-bit checksum.
+     */
+    static uint8_t calculate2BitChecksumScalar(const uint8_t* data, size_t length);
 };
 
 } // namespace SCALPEL
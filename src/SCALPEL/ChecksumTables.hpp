@@ -0,0 +1,129 @@
+#ifndef CHECKSUMTABLES_HPP
+#define CHECKSUMTABLES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace SCALPEL {
+
+// Compile-time lookup tables behind Checksum, shared with code that folds
+// checksum updates into its own byte loops (e.g. Packet::assembleInto).
+namespace ChecksumTables {
+
+constexpr uint8_t CRC8_POLYNOMIAL = 0x07; // CRC-8 polynomial x^8 + x^2 + x + 1
+
+using CRC8Table = std::array<uint8_t, 256>;
+
+// table[i] is the CRC register after shifting the byte i through the polynomial.
+constexpr CRC8Table makeCRC8Table() {
+    CRC8Table table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        uint8_t crc = static_cast<uint8_t>(i);
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ CRC8_POLYNOMIAL)
+                               : static_cast<uint8_t>(crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+// slices[k][i] is the CRC of byte i followed by k zero bytes, so eight input
+// bytes can be folded into the register with eight independent lookups.
+constexpr std::array<CRC8Table, 8> makeCRC8SliceTables() {
+    std::array<CRC8Table, 8> slices{};
+    slices[0] = makeCRC8Table();
+    for (size_t k = 1; k < slices.size(); ++k) {
+        for (size_t i = 0; i < 256; ++i) {
+            slices[k][i] = slices[0][slices[k - 1][i]];
+        }
+    }
+    return slices;
+}
+
+inline constexpr std::array<CRC8Table, 8> CRC8_SLICES = makeCRC8SliceTables();
+inline constexpr const CRC8Table& CRC8_TABLE = CRC8_SLICES[0];
+
+static_assert(CRC8_TABLE[0x01] == CRC8_POLYNOMIAL, "CRC-8 table generation is broken");
+
+// CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF, not
+// reflected. table[i] is the register after shifting byte i in at the top.
+constexpr uint16_t CRC16_POLYNOMIAL = 0x1021;
+constexpr uint16_t CRC16_INITIAL = 0xFFFF;
+
+constexpr std::array<uint16_t, 256> makeCRC16Table() {
+    std::array<uint16_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        uint16_t crc = static_cast<uint16_t>(i << 8);
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ CRC16_POLYNOMIAL)
+                                 : static_cast<uint16_t>(crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+inline constexpr std::array<uint16_t, 256> CRC16_TABLE = makeCRC16Table();
+
+static_assert(CRC16_TABLE[0x01] == CRC16_POLYNOMIAL, "CRC-16 table generation is broken");
+
+// Advance a CRC-16 register by one byte.
+constexpr uint16_t crc16Update(uint16_t crc, uint8_t byte) {
+    return static_cast<uint16_t>(crc << 8 ^ CRC16_TABLE[(crc >> 8 ^ byte) & 0xFF]);
+}
+
+// CRC-32C (Castagnoli), reflected polynomial 0x82F63B78 as computed by the
+// SSE4.2 crc32 instruction. The register starts at 0xFFFFFFFF and is
+// inverted at the end.
+constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+constexpr uint32_t CRC32C_INITIAL = 0xFFFFFFFF;
+
+constexpr std::array<uint32_t, 256> makeCRC32CTable() {
+    std::array<uint32_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        uint32_t crc = static_cast<uint32_t>(i);
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLYNOMIAL : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+inline constexpr std::array<uint32_t, 256> CRC32C_TABLE = makeCRC32CTable();
+
+static_assert(CRC32C_TABLE[0x80] == CRC32C_POLYNOMIAL, "CRC-32C table generation is broken");
+
+// Advance a CRC-32C register by one byte.
+constexpr uint32_t crc32cUpdate(uint32_t crc, uint8_t byte) {
+    return crc >> 8 ^ CRC32C_TABLE[(crc ^ byte) & 0xFF];
+}
+
+// TWO_BIT_TABLE[b] is popcount(b) % 4. Since the sum of per-byte values
+// modulo 4 equals the total bit count modulo 4, it also finishes batch tails.
+constexpr std::array<uint8_t, 256> makeTwoBitTable() {
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        uint8_t bits = 0;
+        for (size_t value = i; value != 0; value >>= 1) {
+            bits += value & 1;
+        }
+        table[i] = bits % 4;
+    }
+    return table;
+}
+
+inline constexpr std::array<uint8_t, 256> TWO_BIT_TABLE = makeTwoBitTable();
+
+// Advance a CRC-8 register by one byte.
+constexpr uint8_t crc8Update(uint8_t crc, uint8_t byte) {
+    return CRC8_TABLE[crc ^ byte];
+}
+
+} // namespace ChecksumTables
+
+} // namespace SCALPEL
+
+#endif // CHECKSUMTABLES_HPP
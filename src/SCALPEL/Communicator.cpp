@@ -1,88 +1,290 @@
 #include "Communicator.hpp"
-#include <iostream>
-// Include your specific hardware communication library headers here
-// For example, for serial communication, you might include <serial/serial.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
 namespace SCALPEL {
 
-Communicator::Communicator(ReceiveCallback receiveCallback)
-    : onReceive(receiveCallback), running(false) {}
+Communicator::Communicator(ReceiveCallback receiveCallback, std::unique_ptr<Transport> backend)
+    : onReceive(receiveCallback), transport(std::move(backend)), sendQueue(new SendQueue()), running(false) {}
 
 Communicator::~Communicator() {
     stop();
 }
 
+void Communicator::setTransport(std::unique_ptr<Transport> newTransport) {
+    if (running) {
+        throw std::logic_error("Cannot replace the transport of a running Communicator.");
+    }
+    transport = std::move(newTransport);
+}
+
+void Communicator::setReceiveCallback(ReceiveCallback receiveCallback) {
+    if (running) {
+        throw std::logic_error("Cannot replace the receive callback of a running Communicator.");
+    }
+    onReceive = std::move(receiveCallback);
+}
+
 void Communicator::start() {
+    if (running) {
+        return;
+    }
+    clearLinkFailure();
     running = true;
-    sendThread = std::thread(&Communicator::sendThreadFunc, this);
-    receiveThread = std::thread(&Communicator::receiveThreadFunc, this);
+    if (transport) {
+        ioThread = std::thread(&Communicator::ioThreadFunc, this);
+    }
 }
 
 void Communicator::stop() {
     if (running) {
         running = false;
-        sendCV.notify_all();
+        // A loop that failed has already returned, and stopping it now
+        // would make the next run() return at once
+        if (transport && !linkFailed.load(std::memory_order_acquire)) {
+            transport->stop();
+        }
+        releaseBlockedSenders();
+        if (ioThread.joinable()) {
+            ioThread.join();
+        }
+        clearLinkFailure();
+    }
+}
+
+std::exception_ptr Communicator::getLinkFailure() const {
+    std::lock_guard<std::mutex> lock(failureMutex);
+    return linkFailure;
+}
+
+void Communicator::clearLinkFailure() {
+    std::lock_guard<std::mutex> lock(failureMutex);
+    linkFailure = nullptr;
+    linkFailed.store(false, std::memory_order_release);
+}
+
+Communicator::SendResult Communicator::send(const std::vector<uint8_t>& data, FrameClass frameClass) {
+    return send(Span<const uint8_t>(data.data(), data.size()), frameClass);
+}
+
+Communicator::SendResult Communicator::send(Span<const uint8_t> data, FrameClass frameClass) {
+    if (data.size() > MAX_FRAME_LENGTH) {
+        throw std::length_error("Frame exceeds the Communicator's maximum frame length.");
+    }
+    if (!transport) {
+        return SendResult::NoTransport;
+    }
+    if (linkFailed.load(std::memory_order_acquire)) {
+        return SendResult::LinkFailed;
+    }
+    if (data.empty()) {
+        return SendResult::Queued;
+    }
 
-        if (sendThread.joinable()) {
-            sendThread.join();
+    SendQueue::Reservation slot = sendQueue->tryReserve();
+    if (!slot) {
+        QueueFullPolicy policy = queueFullPolicy.load(std::memory_order_relaxed);
+        if (policy == QueueFullPolicy::Reject) {
+            framesRejected.fetch_add(1, std::memory_order_relaxed);
+            return SendResult::QueueFull;
         }
-        if (receiveThread.joinable()) {
-            receiveThread.join();
+        SendResult waited = waitForSlot(slot, policy);
+        if (!slot) {
+            return waited;
         }
     }
+    std::memcpy(slot.data(), data.data(), data.size());
+    sendQueue->commit(slot, data.size(), static_cast<uint8_t>(frameClass));
+    noteQueueDepth(sendQueue->size());
+
+    // Pairs with the fence in pendingOutput: either the I/O thread sees this
+    // frame, or this thread sees it idle and wakes it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumerIdle.load(std::memory_order_relaxed) && consumerIdle.exchange(false)) {
+        transport->notify();
+    }
+    return SendResult::Queued;
 }
 
-void Communicator::send(const std::vector<uint8_t>& data) {
-    {
-        std::lock_guard<std::mutex> lock(sendMutex);
-        sendQueue.push(data);
+Communicator::SendResult Communicator::waitForSlot(SendQueue::Reservation& slot, QueueFullPolicy policy) {
+    std::unique_lock<std::mutex> lock(spaceMutex);
+    blockedSenders.fetch_add(1);
+    SendResult result = SendResult::Queued;
+    for (;;) {
+        // Pairs with the fence in releaseBlockedSenders: either this sees
+        // the slot the I/O thread freed, or it sees this sender waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        slot = sendQueue->tryReserve();
+        if (slot) {
+            break;
+        }
+        if (linkFailed.load(std::memory_order_acquire)) {
+            result = SendResult::LinkFailed;
+            break;
+        }
+        if (!running.load(std::memory_order_acquire)) {
+            result = SendResult::NotRunning;
+            break;
+        }
+        // Ask for an eviction on every attempt, since another sender may
+        // have taken the slot the last one freed
+        if (policy == QueueFullPolicy::DropOldestTelemetry &&
+            dropRequests.fetch_add(1, std::memory_order_relaxed) == 0) {
+            transport->notify();
+        }
+        spaceFreed.wait(lock);
     }
-    sendCV.notify_one();
+    blockedSenders.fetch_sub(1);
+    return result;
 }
 
-void Communicator::sendThreadFunc() {
-    while (running) {
-        std::unique_lock<std::mutex> lock(sendMutex);
-        sendCV.wait(lock, [this]() { return !sendQueue.empty() || !running; });
+void Communicator::releaseBlockedSenders() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (blockedSenders.load(std::memory_order_relaxed) > 0) {
+        // Taking the mutex orders this after a sender's last check, so it
+        // is already waiting when notified
+        { std::lock_guard<std::mutex> lock(spaceMutex); }
+        spaceFreed.notify_all();
+    }
+}
+
+void Communicator::setQueueFullPolicy(QueueFullPolicy policy) {
+    queueFullPolicy.store(policy, std::memory_order_relaxed);
+}
+
+Communicator::QueueFullPolicy Communicator::getQueueFullPolicy() const {
+    return queueFullPolicy.load(std::memory_order_relaxed);
+}
+
+void Communicator::setWriteBudget(size_t bytes) {
+    writeBudget.store(bytes, std::memory_order_relaxed);
+}
 
-        while (!sendQueue.empty()) {
-            std::vector<uint8_t> data = sendQueue.front();
-            sendQueue.pop();
-            lock.unlock();
+size_t Communicator::getQueueDepth() const {
+    return sendQueue->size();
+}
+
+Communicator::QueueStats Communicator::getQueueStats() const {
+    QueueStats stats;
+    stats.depth = sendQueue->size();
+    stats.highWater = std::max(queueHighWater.load(std::memory_order_relaxed), stats.depth);
+    stats.dropped = framesDropped.load(std::memory_order_relaxed);
+    stats.rejected = framesRejected.load(std::memory_order_relaxed);
+    return stats;
+}
 
-            // Implement the actual send logic here.
-            // For example, write to a serial port.
-            // Example:
-            // serialPort.write(data);
+void Communicator::resetQueueHighWater() {
+    queueHighWater.store(sendQueue->size(), std::memory_order_relaxed);
+}
 
-            // Placeholder for send operation
-            std::cout << "Sending data:";
-            for (auto byte : data) {
-                std::cout << " " << static_cast<int>(byte);
-            }
-            std::cout << std::endl;
+void Communicator::noteQueueDepth(size_t depth) {
+    size_t highest = queueHighWater.load(std::memory_order_relaxed);
+    while (depth > highest && !queueHighWater.compare_exchange_weak(highest, depth, std::memory_order_relaxed)) {
+    }
+}
 
-            lock.lock();
+void Communicator::ioThreadFunc() {
+    try {
+        transport->run(*this);
+    } catch (...) {
+        // The link is gone; sends are refused until the owner restarts it
+        std::lock_guard<std::mutex> lock(failureMutex);
+        linkFailure = std::current_exception();
+        linkFailed.store(true, std::memory_order_release);
+    }
+    releaseBlockedSenders();
+}
+
+void Communicator::onReceived(Span<const uint8_t> bytes) {
+    receiveBuffer.assign(bytes.begin(), bytes.end());
+    onReceive(receiveBuffer);
+}
+
+void Communicator::dropOldestTelemetry() {
+    // Requests with no telemetry left to evict lapse; those senders wait for
+    // frames to be written instead
+    size_t count = dropRequests.exchange(0, std::memory_order_relaxed);
+
+    // Frames handed to the transport stay, since outputWritten counts bytes
+    // against them, as does a partly written one, which has to finish or
+    // the byte stream breaks
+    size_t i = std::max(framesOffered, sendOffset > 0 ? size_t{1} : size_t{0});
+    bool evicted = false;
+    while (count > 0 && !sendQueue->peek(i).empty()) {
+        if (sendQueue->tag(i) != static_cast<uint8_t>(FrameClass::Telemetry)) {
+            ++i;
+            continue;
         }
+        // Older frames move up a slot, so the next candidate is now at i
+        sendQueue->erase(i);
+        framesDropped.fetch_add(1, std::memory_order_relaxed);
+        --count;
+        evicted = true;
+    }
+    if (evicted) {
+        releaseBlockedSenders();
     }
 }
 
-void Communicator::receiveThreadFunc() {
-    while (running) {
-        // Implement the actual receive logic here.
-        // For example, read from a serial port.
-        // Example:
-        // std::vector<uint8_t> incomingData = serialPort.read();
+void Communicator::onNotified() {
+    if (dropRequests.load(std::memory_order_relaxed) != 0) {
+        dropOldestTelemetry();
+    }
+}
 
-        // Placeholder for receive operation
-        // Simulate receiving data
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        std::vector<uint8_t> incomingData = { /* populate with received bytes */ };
+size_t Communicator::pendingOutput(Span<const uint8_t>* segments, size_t maxSegments) {
+    // Nothing earlier is in flight any more
+    framesOffered = 0;
+    if (dropRequests.load(std::memory_order_relaxed) != 0) {
+        dropOldestTelemetry();
+    }
 
-        if (!incomingData.empty()) {
-            onReceive(incomingData);
+    Span<const uint8_t> frame = sendQueue->peek();
+    if (frame.empty()) {
+        // Announce the loop is about to wait, then look again in case a
+        // frame was published before the announcement was visible
+        consumerIdle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        frame = sendQueue->peek();
+        if (frame.empty()) {
+            return 0;
         }
+        consumerIdle.store(false, std::memory_order_relaxed);
+    }
+
+    // Gather frames oldest first until the budget is spent; the oldest goes
+    // out whatever its size so the queue always makes progress
+    size_t budget = writeBudget.load(std::memory_order_relaxed);
+    size_t count = 0;
+    size_t bytes = 0;
+    for (; count < maxSegments && !frame.empty(); frame = sendQueue->peek(count)) {
+        size_t offset = count == 0 ? sendOffset : 0;
+        size_t length = frame.size() - offset;
+        if (count > 0 && bytes + length > budget) {
+            break;
+        }
+        segments[count] = frame.subspan(offset);
+        bytes += length;
+        ++count;
+    }
+    framesOffered = count;
+    return count;
+}
+
+void Communicator::outputWritten(size_t bytes) {
+    framesOffered = 0;
+    sendOffset += bytes;
+    bool released = false;
+    for (Span<const uint8_t> frame = sendQueue->peek(); !frame.empty() && sendOffset >= frame.size();
+         frame = sendQueue->peek()) {
+        sendOffset -= frame.size();
+        sendQueue->pop();
+        released = true;
+    }
+    if (released) {
+        releaseBlockedSenders();
     }
 }
 
-} // namespace SCALPEL
\ No newline at end of file
+} // namespace SCALPEL
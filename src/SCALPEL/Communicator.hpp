@@ -2,37 +2,121 @@
 #define COMMUNICATOR_HPP
 
 #include <cstdint>
+#include <cstddef>
 #include <vector>
 #include <thread>
-#include <mutex>
 #include <functional>
 #include <atomic>
-#include <queue>
 #include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include "FrameRing.hpp"
+#include "Span.hpp"
+#include "Transport.hpp"
 
 namespace SCALPEL {
 
 /**
  * @class Communicator
  * @brief Handles low-level I/O operations with the physical communication interface.
+ *
+ * Reads and writes go through a pluggable Transport whose event loop runs on
+ * a single I/O thread; received bytes are handed to the callback on that
+ * thread as soon as they arrive. Without a transport, sent data is discarded.
+ *
+ * Outgoing frames go through a lock-free ring of fixed-size slots: send()
+ * copies the frame straight into a slot, and the transport is only woken
+ * when its loop has run out of output, so a busy link costs producers no
+ * syscalls. Each time the device can take output, every queued frame up to
+ * the write budget goes out in a single gathered write.
+ *
+ * The queue is bounded; what send() does when it is full is set by the
+ * QueueFullPolicy, and getQueueStats() reports how deep it has run.
  */
-class Communicator {
+class Communicator : private Transport::Handler {
 public:
     /**
      * @brief Type alias for the received data callback function.
      */
     using ReceiveCallback = std::function<void(const std::vector<uint8_t>&)>;
 
+    /**
+     * @brief Longest frame a single send() accepts.
+     */
+    static constexpr size_t MAX_FRAME_LENGTH = 256;
+
+    /**
+     * @brief Frames the send queue holds before the QueueFullPolicy applies.
+     */
+    static constexpr size_t SEND_QUEUE_SLOTS = 256;
+
+    /**
+     * @brief Bytes gathered into one write unless setWriteBudget() says otherwise.
+     */
+    static constexpr size_t DEFAULT_WRITE_BUDGET = 4096;
+
+    /**
+     * @brief Kind of traffic a frame carries; only telemetry may be dropped.
+     */
+    enum class FrameClass : uint8_t {
+        Command,
+        Telemetry,
+    };
+
+    /**
+     * @brief What send() does when the queue is full.
+     */
+    enum class QueueFullPolicy : uint8_t {
+        Block,               // Wait for the I/O thread to free a slot
+        DropOldestTelemetry, // Discard the oldest unsent telemetry frame to make room
+        Reject,              // Return SendResult::QueueFull without queueing
+    };
+
+    /**
+     * @brief Outcome of send().
+     */
+    enum class SendResult : uint8_t {
+        Queued,      // Queued for the transport, or empty and nothing to do
+        QueueFull,   // Refused under QueueFullPolicy::Reject
+        NoTransport, // Discarded because no transport is set
+        LinkFailed,  // Discarded because the transport failed; see getLinkFailure()
+        NotRunning,  // Queue full and stopped, so nothing would free a slot
+    };
+
+    /**
+     * @brief Send queue counters; safe to read while running.
+     */
+    struct QueueStats {
+        size_t depth = 0;       // Frames queued and not yet fully written
+        size_t highWater = 0;   // Deepest the queue has been since the last reset
+        uint64_t dropped = 0;   // Telemetry frames discarded to make room
+        uint64_t rejected = 0;  // Frames refused with SendResult::QueueFull
+    };
+
     /**
      * @brief Constructs the Communicator.
      * @param receiveCallback Callback function to handle received data.
+     * @param transport I/O backend for the link, e.g. an EpollTransport.
      */
-    Communicator(ReceiveCallback receiveCallback);
+    explicit Communicator(ReceiveCallback receiveCallback, std::unique_ptr<Transport> transport = nullptr);
 
     /**
      * @brief Destructor to clean up resources.
      */
-    ~Communicator();
+    ~Communicator() override;
+
+    /**
+     * @brief Replaces the I/O backend; only allowed while stopped.
+     * @param transport The new transport, or nullptr to discard sent data.
+     */
+    void setTransport(std::unique_ptr<Transport> transport);
+
+    /**
+     * @brief Replaces the callback given received data; only allowed while stopped.
+     * @param receiveCallback The new callback, called on the I/O thread.
+     */
+    void setReceiveCallback(ReceiveCallback receiveCallback);
 
     /**
      * @brief Starts the communication interface.
@@ -46,32 +130,157 @@ public:
 
     /**
      * @brief Sends raw data through the communication interface.
-     * @param data The data to send.
+     *        Safe to call from any thread. When the send queue is full the
+     *        QueueFullPolicy decides whether this waits or returns QueueFull.
+     *        A stopped Communicator keeps queueing frames for the next
+     *        start(), but returns NotRunning rather than wait once the
+     *        queue is full; stopping it or losing the link also releases
+     *        senders already waiting.
+     * @param data The data to send, at most MAX_FRAME_LENGTH bytes.
+     * @param frameClass Whether the frame may be dropped under DropOldestTelemetry.
+     * @return Whether the frame was queued.
+     * @throws std::length_error if data is longer than MAX_FRAME_LENGTH.
      */
-    void send(const std::vector<uint8_t>& data);
+    SendResult send(const std::vector<uint8_t>& data, FrameClass frameClass = FrameClass::Command);
+
+    /**
+     * @brief Sends raw data without requiring it to live in a vector.
+     * @param data The data to send, at most MAX_FRAME_LENGTH bytes.
+     * @param frameClass Whether the frame may be dropped under DropOldestTelemetry.
+     * @return Whether the frame was queued.
+     */
+    SendResult send(Span<const uint8_t> data, FrameClass frameClass = FrameClass::Command);
+
+    /**
+     * @brief Why the transport's loop stopped on its own, if it did.
+     *        Once it fails, send() returns LinkFailed until the Communicator
+     *        is stopped and started again, which clears the failure.
+     * @return The exception the transport threw, or nullptr while the link is up.
+     */
+    std::exception_ptr getLinkFailure() const;
+
+    /**
+     * @brief Sets what send() does when the queue is full; Block by default.
+     *        Takes effect for sends that start after the call.
+     * @param policy The policy to apply.
+     */
+    void setQueueFullPolicy(QueueFullPolicy policy);
+
+    /**
+     * @brief Gets the policy applied when the queue is full.
+     */
+    QueueFullPolicy getQueueFullPolicy() const;
+
+    /**
+     * @brief Caps the bytes gathered into one write. The oldest queued frame
+     *        is always written whole, so a budget below MAX_FRAME_LENGTH
+     *        only limits coalescing.
+     * @param bytes The budget, DEFAULT_WRITE_BUDGET unless changed.
+     */
+    void setWriteBudget(size_t bytes);
+
+    /**
+     * @brief Frames queued and not yet fully written.
+     */
+    size_t getQueueDepth() const;
+
+    /**
+     * @brief Queue depth, high-water mark and drop and reject counts.
+     */
+    QueueStats getQueueStats() const;
+
+    /**
+     * @brief Restarts the high-water mark from the current depth.
+     */
+    void resetQueueHighWater();
 
 private:
+    using SendQueue = FrameRing<MAX_FRAME_LENGTH, SEND_QUEUE_SLOTS>;
+
+    /**
+     * @brief Thread function running the transport's event loop.
+     */
+    void ioThreadFunc();
+
+    /**
+     * @brief Forgets a recorded transport failure.
+     */
+    void clearLinkFailure();
+
+    /**
+     * @brief Waits for a free slot after send() found the queue full,
+     *        asking the I/O thread to evict telemetry under
+     *        DropOldestTelemetry.
+     * @return Queued with slot filled in, or why no slot will come.
+     */
+    SendResult waitForSlot(SendQueue::Reservation& slot, QueueFullPolicy policy);
+
+    /**
+     * @brief Wakes senders waiting in waitForSlot; called after freeing
+     *        slots or when they can no longer be freed.
+     */
+    void releaseBlockedSenders();
+
+    // Transport::Handler, called on the I/O thread
+    void onReceived(Span<const uint8_t> bytes) override;
+    size_t pendingOutput(Span<const uint8_t>* segments, size_t maxSegments) override;
+    void outputWritten(size_t bytes) override;
+    void onNotified() override;
+
     /**
-     * @brief Thread function for sending data.
+     * @brief Discards the oldest queued telemetry frame for each pending
+     *        drop request, skipping frames handed to the transport.
+     *        Called on the I/O thread.
      */
-    void sendThreadFunc();
+    void dropOldestTelemetry();
 
     /**
-     * @brief Thread function for receiving data.
+     * @brief Raises the high-water mark to depth if it is higher.
      */
-    void receiveThreadFunc();
+    void noteQueueDepth(size_t depth);
 
     // Callback to handle received data
     ReceiveCallback onReceive;
 
-    // Threads for sending and receiving
-    std::thread sendThread;
-    std::thread receiveThread;
+    // I/O backend and the thread running its loop
+    std::unique_ptr<Transport> transport;
+    std::thread ioThread;
+
+    // Frames waiting to be written. Only the I/O thread releases or moves
+    // slots, so the transport can write straight from them
+    std::unique_ptr<SendQueue> sendQueue;
+    size_t sendOffset = 0;    // Bytes of the oldest frame already written
+    size_t framesOffered = 0; // Oldest frames handed out and not yet accounted for
+
+    // Set by the I/O thread when it finds the queue empty, so the next
+    // send() knows to wake it; cleared by whoever does the waking
+    std::atomic<bool> consumerIdle{true};
+
+    // Only the I/O thread may move frames, so a send() that finds the queue
+    // full under DropOldestTelemetry asks it to evict one, waking it if no
+    // request is already outstanding
+    std::atomic<size_t> dropRequests{0};
+
+    // Senders waiting for a slot sleep on spaceFreed; the I/O thread only
+    // takes the mutex to wake them when blockedSenders says one is there
+    std::atomic<size_t> blockedSenders{0};
+    std::mutex spaceMutex;
+    std::condition_variable spaceFreed;
+
+    std::atomic<QueueFullPolicy> queueFullPolicy{QueueFullPolicy::Block};
+    std::atomic<size_t> writeBudget{DEFAULT_WRITE_BUDGET};
+    std::atomic<size_t> queueHighWater{0};
+    std::atomic<uint64_t> framesDropped{0};
+    std::atomic<uint64_t> framesRejected{0};
+
+    // Set by the I/O thread when the transport throws; cleared by start()
+    // and stop()
+    std::atomic<bool> linkFailed{false};
+    mutable std::mutex failureMutex;
+    std::exception_ptr linkFailure;
 
-    // Queues and synchronization primitives for sending data
-    std::queue<std::vector<uint8_t>> sendQueue;
-    std::mutex sendMutex;
-    std::condition_variable sendCV;
+    // Reused for every read so receiving does not allocate
+    std::vector<uint8_t> receiveBuffer;
 
     // Atomic flag to control the running state
     std::atomic<bool> running;
@@ -0,0 +1,220 @@
+#include "EpollTransport.hpp"
+#include <cerrno>
+#include <system_error>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace SCALPEL {
+
+namespace {
+
+[[noreturn]] void throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Bring fd's registration from registered to wanted events, adding or
+// removing it so an unwatched descriptor cannot report hangups
+void setInterest(int epollFd, int fd, uint32_t wanted, uint32_t& registered) {
+    if (wanted == registered) {
+        return;
+    }
+    epoll_event event{};
+    event.events = wanted;
+    event.data.fd = fd;
+    int op = registered == 0 ? EPOLL_CTL_ADD : (wanted == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD);
+    if (::epoll_ctl(epollFd, op, fd, &event) != 0) {
+        throwErrno("epoll_ctl failed");
+    }
+    registered = wanted;
+}
+
+} // namespace
+
+EpollTransport::EpollTransport(SerialDevice device) : input(std::move(device)) {
+    setup();
+}
+
+EpollTransport::EpollTransport(SerialDevice inputDevice, SerialDevice outputDevice)
+    : input(std::move(inputDevice)), output(std::move(outputDevice)) {
+    setup();
+}
+
+EpollTransport::~EpollTransport() {
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+    }
+    if (epollFd >= 0) {
+        ::close(epollFd);
+    }
+}
+
+void EpollTransport::setup() {
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        throwErrno("epoll_create1 failed");
+    }
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        ::close(epollFd);
+        throwErrno("eventfd failed");
+    }
+    uint32_t wakeEvents = 0;
+    try {
+        setInterest(epollFd, wakeFd, EPOLLIN, wakeEvents);
+        setInterest(epollFd, input.fd(), EPOLLIN, inputEvents);
+    } catch (...) {
+        ::close(wakeFd);
+        ::close(epollFd);
+        throw;
+    }
+}
+
+void EpollTransport::updateInterest() {
+    uint32_t readEvents = inputOpen ? static_cast<uint32_t>(EPOLLIN) : 0u;
+    uint32_t writeEvents = outputWatched ? static_cast<uint32_t>(EPOLLOUT) : 0u;
+    if (output.isOpen()) {
+        setInterest(epollFd, input.fd(), readEvents, inputEvents);
+        setInterest(epollFd, output.fd(), writeEvents, outputEvents);
+    } else {
+        setInterest(epollFd, input.fd(), readEvents | writeEvents, inputEvents);
+    }
+}
+
+void EpollTransport::run(Handler& handler) {
+    std::array<epoll_event, 4> events;
+
+    // Output queued before the loop started goes out straight away
+    outputWatched = writeOutput(handler);
+    updateInterest();
+
+    while (!stopping.load(std::memory_order_acquire)) {
+        int ready = ::epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
+        waits.fetch_add(1, std::memory_order_relaxed);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("epoll_wait failed");
+        }
+
+        bool woken = false;
+        bool writable = false;
+        bool closed = false;
+        for (int i = 0; i < ready; ++i) {
+            const epoll_event& event = events[i];
+            if (event.data.fd == wakeFd) {
+                uint64_t count;
+                ssize_t drained = ::read(wakeFd, &count, sizeof(count));
+                (void)drained;
+                woken = true;
+                handler.onNotified();
+                continue;
+            }
+            if ((event.events & EPOLLOUT) != 0) {
+                writable = true;
+            }
+            if (event.data.fd == input.fd() && inputOpen &&
+                (event.events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0) {
+                closed = !readInput(handler) || closed;
+            }
+        }
+        if (stopping.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        // While the device is refusing output, only its readiness can help
+        bool watched = outputWatched;
+        if ((woken && !outputWatched) || writable) {
+            watched = writeOutput(handler);
+        }
+        if (closed || watched != outputWatched) {
+            inputOpen = inputOpen && !closed;
+            outputWatched = watched;
+            updateInterest();
+        }
+    }
+    stopping.store(false, std::memory_order_release);
+}
+
+bool EpollTransport::readInput(Handler& handler) {
+    for (;;) {
+        ssize_t got = ::read(input.fd(), readBuffer.data(), readBuffer.size());
+        reads.fetch_add(1, std::memory_order_relaxed);
+        if (got > 0) {
+            bytesRead.fetch_add(static_cast<uint64_t>(got), std::memory_order_relaxed);
+            handler.onReceived(Span<const uint8_t>(readBuffer.data(), static_cast<size_t>(got)));
+            if (static_cast<size_t>(got) < readBuffer.size()) {
+                return true;
+            }
+            continue;
+        }
+        if (got == 0) {
+            return false;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return true;
+        }
+        if (errno == EIO) {
+            // A pty whose other end has closed
+            return false;
+        }
+        throwErrno("read failed");
+    }
+}
+
+bool EpollTransport::writeOutput(Handler& handler) {
+    int fd = output.isOpen() ? output.fd() : input.fd();
+    std::array<Span<const uint8_t>, MAX_WRITE_SEGMENTS> segments;
+    std::array<iovec, MAX_WRITE_SEGMENTS> iov;
+    for (;;) {
+        size_t count = handler.pendingOutput(segments.data(), segments.size());
+        if (count == 0) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            iov[i].iov_base = const_cast<uint8_t*>(segments[i].data());
+            iov[i].iov_len = segments[i].size();
+        }
+        ssize_t written = ::writev(fd, iov.data(), static_cast<int>(count));
+        writes.fetch_add(1, std::memory_order_relaxed);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return true;
+            }
+            throwErrno("writev failed");
+        }
+        bytesWritten.fetch_add(static_cast<uint64_t>(written), std::memory_order_relaxed);
+        handler.outputWritten(static_cast<size_t>(written));
+    }
+}
+
+void EpollTransport::notify() {
+    uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+void EpollTransport::stop() {
+    stopping.store(true, std::memory_order_release);
+    notify();
+}
+
+EpollTransport::Stats EpollTransport::getStats() const {
+    Stats stats;
+    stats.waits = waits.load(std::memory_order_relaxed);
+    stats.reads = reads.load(std::memory_order_relaxed);
+    stats.writes = writes.load(std::memory_order_relaxed);
+    stats.bytesRead = bytesRead.load(std::memory_order_relaxed);
+    stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace SCALPEL
@@ -0,0 +1,88 @@
+#ifndef EPOLLTRANSPORT_HPP
+#define EPOLLTRANSPORT_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "SerialDevice.hpp"
+#include "Transport.hpp"
+
+namespace SCALPEL {
+
+// Transport driven by a single epoll loop over non-blocking descriptors.
+//
+// The loop waits on the input descriptor for reads and on an eventfd that
+// notify() and stop() signal. Queued output is written with writev straight
+// after each wakeup; write readiness is only watched while the device has
+// refused part of it, so an idle link costs no wakeups beyond arrivals.
+// When the input reports end of file or a hangup it is dropped from the
+// interest list and the loop carries on writing.
+class EpollTransport : public Transport {
+public:
+    // Syscall counts since construction, for benchmarks and diagnostics
+    struct Stats {
+        uint64_t waits = 0;        // epoll_wait calls
+        uint64_t reads = 0;        // read calls
+        uint64_t writes = 0;       // writev calls
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+    };
+
+    // Read and write the same descriptor, e.g. a serial port or pty
+    explicit EpollTransport(SerialDevice device);
+
+    // Read from input and write to output, e.g. the ends of two pipes
+    EpollTransport(SerialDevice input, SerialDevice output);
+
+    ~EpollTransport() override;
+
+    EpollTransport(const EpollTransport&) = delete;
+    EpollTransport& operator=(const EpollTransport&) = delete;
+
+    void run(Handler& handler) override;
+    void notify() override;
+    void stop() override;
+
+    // Safe to call while the loop runs
+    Stats getStats() const;
+
+private:
+    static constexpr size_t READ_BUFFER_SIZE = 4096;
+    // Enough for a full write budget of short frames
+    static constexpr size_t MAX_WRITE_SEGMENTS = 64;
+
+    // Create the epoll instance and eventfd and register the input
+    void setup();
+
+    // Register the events the loop currently needs on each descriptor
+    void updateInterest();
+
+    // Read once, or until the buffer stops filling; false once input closed
+    bool readInput(Handler& handler);
+
+    // Write pending output until it runs out or the device would block;
+    // returns true if output is left over
+    bool writeOutput(Handler& handler);
+
+    SerialDevice input;
+    SerialDevice output;  // Unused when input is also the output
+    int epollFd = -1;
+    int wakeFd = -1;
+    bool inputOpen = true;
+    bool outputWatched = false;
+    uint32_t inputEvents = 0;   // Registered epoll events of each descriptor
+    uint32_t outputEvents = 0;
+    std::atomic<bool> stopping{false};
+    std::array<uint8_t, READ_BUFFER_SIZE> readBuffer;
+
+    std::atomic<uint64_t> waits{0};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> writes{0};
+    std::atomic<uint64_t> bytesRead{0};
+    std::atomic<uint64_t> bytesWritten{0};
+};
+
+} // namespace SCALPEL
+
+#endif // EPOLLTRANSPORT_HPP
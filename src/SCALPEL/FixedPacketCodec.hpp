@@ -0,0 +1,183 @@
+#ifndef FIXEDPACKETCODEC_HPP
+#define FIXEDPACKETCODEC_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include "ChecksumTables.hpp"
+#include "Packet.hpp"
+#include "PacketView.hpp"
+
+namespace SCALPEL {
+
+// Encoder and decoder for packets whose payload length N is known at compile
+// time, such as 28-byte telemetry. Produces and accepts exactly the legacy
+// wire format of Packet (no options byte, no parity), but every per-byte
+// step is expanded over an index sequence, so with N fixed the compiler
+// emits straight-line code: no loop counters, no length checks, and every
+// output position a constant.
+//
+// COBS never moves a payload byte: byte i always lands at HEADER_LENGTH + 1
+// + i, and a START_BYTE just turns its slot into the next code byte. Encoding
+// therefore writes the payload in place and only patches code bytes, without
+// branching on the data. The CRC-8 runs separately, eight bytes per step
+// through the slice tables, so it does not serialise the COBS pass.
+template <size_t N>
+class FixedPacketCodec {
+    static_assert(N <= Packet::MAX_PAYLOAD_LENGTH, "Payload too long for a SCALPEL packet");
+
+public:
+    static constexpr size_t HEADER_LENGTH = 3;
+    // START, length, COBS, N + 1 encoded bytes, CRC-8
+    static constexpr size_t ASSEMBLED_LENGTH = HEADER_LENGTH + N + 1 + 1;
+
+    using Payload = std::array<uint8_t, N>;
+    using Frame = std::array<uint8_t, ASSEMBLED_LENGTH>;
+
+    // Assemble payload into frame; identical to Packet(payload).assemble()
+    static void encode(const uint8_t* payload, uint8_t* frame) noexcept {
+        frame[0] = Packet::START_BYTE;
+        frame[1] = LENGTH_BYTE;
+
+        EncodeState state{HEADER_LENGTH, 0};
+        encodeBytes(payload, frame, state, std::make_index_sequence<N>{});
+        frame[state.codePtr] = static_cast<uint8_t>(HEADER_LENGTH + 1 + N - state.codePtr);
+
+        unsigned bits = encodedBits(frame, std::make_index_sequence<N + 1>{});
+        frame[2] = static_cast<uint8_t>((state.index & 0x3F) << 2 | (bits & 0x03));
+        frame[ASSEMBLED_LENGTH - 1] = crc8(payload);
+    }
+
+    static Frame encode(const Payload& payload) noexcept {
+        Frame frame;
+        encode(payload.data(), frame.data());
+        return frame;
+    }
+
+    // Validate frame and decode its payload, which is only written on Ok.
+    // Accepts exactly the packets PacketView::parse accepts at this length;
+    // a packet with a different payload length is a LengthMismatch
+    static PacketView::Status decode(const uint8_t* frame, uint8_t* payload) noexcept {
+        if (frame[0] != Packet::START_BYTE) {
+            return PacketView::Status::BadStartByte;
+        }
+        uint8_t lengthField = (frame[1] >> 2) & 0x3F;
+        if ((frame[1] & 0x03) != ChecksumTables::TWO_BIT_TABLE[lengthField]) {
+            return PacketView::Status::BadLengthChecksum;
+        }
+        if (frame[1] != LENGTH_BYTE) {
+            return PacketView::Status::LengthMismatch;
+        }
+        if ((frame[2] & 0x03) != (encodedBits(frame, std::make_index_sequence<N + 1>{}) & 0x03)) {
+            return PacketView::Status::BadCobsChecksum;
+        }
+
+        Payload decoded;
+        DecodeState state{HEADER_LENGTH + size_t{frame[HEADER_LENGTH]}, 0, frame[HEADER_LENGTH] != 0};
+        decodeBytes(frame, decoded.data(), state, std::make_index_sequence<N>{});
+        if (!state.valid || state.nextCode != HEADER_LENGTH + 1 + N) {
+            return PacketView::Status::BadCobsEncoding;
+        }
+        if (state.restored != ((frame[2] >> 2) & 0x3F)) {
+            return PacketView::Status::BadCobsIndex;
+        }
+        if (crc8(decoded.data()) != frame[ASSEMBLED_LENGTH - 1]) {
+            return PacketView::Status::BadPayloadChecksum;
+        }
+
+        std::copy(decoded.begin(), decoded.end(), payload);
+        return PacketView::Status::Ok;
+    }
+
+    static PacketView::Status decode(const Frame& frame, Payload& payload) noexcept {
+        return decode(frame.data(), payload.data());
+    }
+
+private:
+    static constexpr uint8_t LENGTH_BYTE = static_cast<uint8_t>(N << 2 | ChecksumTables::TWO_BIT_TABLE[N]);
+
+    struct EncodeState {
+        size_t codePtr; // Slot of the code byte of the current block
+        uint8_t index;  // START_BYTEs replaced so far
+    };
+
+    struct DecodeState {
+        size_t nextCode;  // Position of the next code byte
+        uint8_t restored; // START_BYTEs restored so far
+        bool valid;       // No zero code byte seen
+    };
+
+    template <size_t I>
+    static void encodeByte(const uint8_t* payload, uint8_t* frame, EncodeState& state) noexcept {
+        constexpr size_t position = HEADER_LENGTH + 1 + I;
+        uint8_t byte = payload[I];
+        bool start = byte == Packet::START_BYTE;
+        frame[position] = byte;
+        // The code of the open block as if it ended here; a later byte
+        // overwrites it unless it really does
+        frame[state.codePtr] = static_cast<uint8_t>(position - state.codePtr);
+        state.codePtr = start ? position : state.codePtr;
+        state.index = static_cast<uint8_t>(state.index + start);
+    }
+
+    template <size_t... I>
+    static void encodeBytes(const uint8_t* payload, uint8_t* frame, EncodeState& state,
+                            std::index_sequence<I...>) noexcept {
+        (encodeByte<I>(payload, frame, state), ...);
+    }
+
+    template <size_t I>
+    static void decodeByte(const uint8_t* frame, uint8_t* payload, DecodeState& state) noexcept {
+        constexpr size_t position = HEADER_LENGTH + 1 + I;
+        uint8_t byte = frame[position];
+        bool code = position == state.nextCode;
+        state.valid = state.valid && (!code || byte != 0);
+        state.nextCode = code ? position + byte : state.nextCode;
+        state.restored = static_cast<uint8_t>(state.restored + code);
+        payload[I] = code ? Packet::START_BYTE : byte;
+    }
+
+    template <size_t... I>
+    static void decodeBytes(const uint8_t* frame, uint8_t* payload, DecodeState& state,
+                            std::index_sequence<I...>) noexcept {
+        (decodeByte<I>(frame, payload, state), ...);
+    }
+
+    // CRC-8 of data[0, N): whole eight-byte blocks through the slice tables,
+    // then the remaining bytes one at a time
+    static uint8_t crc8(const uint8_t* data) noexcept {
+        uint8_t crc = crc8Blocks(data, std::make_index_sequence<N / 8>{});
+        return crc8Tail(crc, data + N / 8 * 8, std::make_index_sequence<N % 8>{});
+    }
+
+    template <size_t... B>
+    static uint8_t crc8Blocks(const uint8_t* data, std::index_sequence<B...>) noexcept {
+        uint8_t crc = 0x00;
+        ((crc = crc8Block(crc, data + 8 * B, std::make_index_sequence<8>{})), ...);
+        return crc;
+    }
+
+    template <size_t... K>
+    static uint8_t crc8Block(uint8_t crc, const uint8_t* block, std::index_sequence<K...>) noexcept {
+        return static_cast<uint8_t>(
+            (0u ^ ... ^ ChecksumTables::CRC8_SLICES[7 - K][K == 0 ? block[K] ^ crc : block[K]]));
+    }
+
+    template <size_t... K>
+    static uint8_t crc8Tail(uint8_t crc, const uint8_t* tail, std::index_sequence<K...>) noexcept {
+        ((crc = ChecksumTables::crc8Update(crc, tail[K])), ...);
+        return crc;
+    }
+
+    // Sum of the per-byte 2-bit checksums of the encoded payload
+    template <size_t... I>
+    static unsigned encodedBits(const uint8_t* frame, std::index_sequence<I...>) noexcept {
+        return (0u + ... + ChecksumTables::TWO_BIT_TABLE[frame[HEADER_LENGTH + I]]);
+    }
+};
+
+} // namespace SCALPEL
+
+#endif // FIXEDPACKETCODEC_HPP
@@ -0,0 +1,51 @@
+#include "FrameAggregator.hpp"
+#include <stdexcept>
+
+namespace SCALPEL {
+
+FrameAggregator::FrameAggregator(size_t maxBatchLength, Clock::duration latencyBudget, BatchCallback onBatch)
+    : maxBatchLength(maxBatchLength), latencyBudget(latencyBudget), onBatch(std::move(onBatch)) {
+    if (maxBatchLength < Packet::MAX_PACKET_LENGTH) {
+        throw std::invalid_argument("Batch length too small for a packet.");
+    }
+}
+
+void FrameAggregator::add(const Packet& packet, Clock::time_point now) {
+    size_t length = packet.getAssembledLength();
+    if (batchLength + length > maxBatchLength) {
+        flush();
+    }
+    if (count == 0) {
+        oldest = now;
+    }
+    batch[count++] = packet;
+    batchLength += length;
+    if (count == MAX_BATCH_PACKETS) {
+        flush();
+    } else {
+        poll(now);
+    }
+}
+
+void FrameAggregator::poll(Clock::time_point now) {
+    if (count != 0 && now - oldest >= latencyBudget) {
+        flush();
+    }
+}
+
+void FrameAggregator::flush() {
+    if (count == 0) {
+        return;
+    }
+    // Reset first so a throwing callback does not resend the batch
+    size_t sent = count;
+    count = 0;
+    batchLength = 0;
+    batchesSent++;
+    packetsSent += sent;
+    if (onBatch) {
+        onBatch(Span<const Packet>(batch.data(), sent));
+    }
+}
+
+} // namespace SCALPEL
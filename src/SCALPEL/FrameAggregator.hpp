@@ -0,0 +1,73 @@
+#ifndef FRAMEAGGREGATOR_HPP
+#define FRAMEAGGREGATOR_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include "Packet.hpp"
+#include "Span.hpp"
+
+namespace SCALPEL {
+
+// Coalesces outgoing packets so a radio can send several of them in one
+// radio frame, paying its framing overhead once. Packets are held until the
+// batch is full or the oldest one has waited for the latency budget; a zero
+// budget sends every packet on its own, as before.
+//
+// The receiver needs no counterpart: each packet keeps its own START_BYTE,
+// so FrameParser splits a radio frame back into packets.
+//
+// Not thread-safe; the owner serialises add, poll and flush.
+class FrameAggregator {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Called with each batch, oldest packet first. The view is only valid
+    // for the duration of the call.
+    using BatchCallback = std::function<void(Span<const Packet> packets)>;
+
+    static constexpr size_t MAX_BATCH_PACKETS = 16;
+
+    // maxBatchLength is the assembled size a batch may not exceed, i.e. the
+    // radio's payload capacity. Throws std::invalid_argument if it cannot
+    // hold one packet
+    FrameAggregator(size_t maxBatchLength, Clock::duration latencyBudget, BatchCallback onBatch);
+
+    // Queue a packet, first sending the batch if the packet would overflow it
+    void add(const Packet& packet, Clock::time_point now = Clock::now());
+
+    // Send the batch if its oldest packet has waited for the latency budget
+    void poll(Clock::time_point now = Clock::now());
+
+    // Send the batch now
+    void flush();
+
+    // When poll must next run; only meaningful while pending() is nonzero
+    Clock::time_point deadline() const { return oldest + latencyBudget; }
+
+    size_t pending() const { return count; }
+
+    void setLatencyBudget(Clock::duration budget) { latencyBudget = budget; }
+    Clock::duration getLatencyBudget() const { return latencyBudget; }
+    size_t getMaxBatchLength() const { return maxBatchLength; }
+
+    uint64_t getBatchesSent() const { return batchesSent; }
+    uint64_t getPacketsSent() const { return packetsSent; }
+
+private:
+    size_t maxBatchLength;
+    Clock::duration latencyBudget;
+    BatchCallback onBatch;
+    std::array<Packet, MAX_BATCH_PACKETS> batch;
+    size_t count = 0;
+    size_t batchLength = 0;     // Assembled size of the queued packets
+    Clock::time_point oldest;   // When the first queued packet was added
+    uint64_t batchesSent = 0;
+    uint64_t packetsSent = 0;
+};
+
+} // namespace SCALPEL
+
+#endif // FRAMEAGGREGATOR_HPP
@@ -0,0 +1,204 @@
+#include "FrameParser.hpp"
+#include "HeaderCode.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace SCALPEL {
+
+namespace {
+
+// Payloads of up to MAX_PAYLOAD_LENGTH bytes encode to exactly one byte more,
+// followed by the CRC and any Reed-Solomon parity.
+inline size_t frameLength(uint8_t payloadLength, const PacketFormat& format) {
+    return format.headerLength() + payloadLength + 1 + format.checksumLength() + format.fecParity;
+}
+
+inline uint8_t optionsField(const uint8_t* frame) {
+    return (frame[3] >> 2) & 0x3F;
+}
+
+} // namespace
+
+FrameParser::FrameParser(FrameCallback onFrame, PacketFormat::HeaderProtection protection)
+    : onFrame(std::move(onFrame)), protection(protection) {}
+
+size_t FrameParser::targetLength() const {
+    // Assumes the buffered header fields already passed checkByte
+    size_t headerBytes = protection == PacketFormat::HeaderProtection::Secded ? 3 : 2;
+    if (buffered < headerBytes) {
+        return headerBytes;
+    }
+    if ((headerField & PacketFormat::EXTENDED_FLAG) && buffered < 4) {
+        return 4;
+    }
+    return frameLength(headerField & ~PacketFormat::EXTENDED_FLAG, candidate);
+}
+
+void FrameParser::feed(Span<const uint8_t> chunk) {
+    const uint8_t* data = chunk.data();
+    size_t size = chunk.size();
+    size_t i = 0;
+
+    while (i < size) {
+        if (buffered == 0) {
+            // Hunt for the next START_BYTE
+            const void* found = std::memchr(data + i, Packet::START_BYTE, size - i);
+            size_t skip = found ? static_cast<size_t>(static_cast<const uint8_t*>(found) - (data + i)) : size - i;
+            stats.bytesDiscarded += skip;
+            i += skip;
+            if (i == size) {
+                break;
+            }
+            bufferOffset = stats.bytesConsumed + i;
+        }
+
+        // Buffer at most the rest of the current candidate, then validate it
+        size_t target = targetLength();
+        size_t take = std::min(target - buffered, size - i);
+        std::memcpy(buffer.data() + buffered, data + i, take);
+        buffered += take;
+        i += take;
+        process();
+    }
+
+    stats.bytesConsumed += size;
+}
+
+void FrameParser::reset() {
+    stats.bytesDiscarded += buffered;
+    buffered = 0;
+    checked = 0;
+}
+
+FrameParser::Check FrameParser::checkByte(size_t position) {
+    if (position == 0) {
+        return Check::Continue; // START_BYTE, guaranteed by drop()
+    }
+
+    bool secded = protection == PacketFormat::HeaderProtection::Secded;
+    if (position == 1) {
+        candidate = PacketFormat{};
+        candidate.headerProtection = protection;
+        if (secded) {
+            return Check::Continue; // Decoded together with the COBS byte
+        }
+        headerField = (buffer[1] >> 2) & 0x3F;
+        bool valid = (headerField & ~PacketFormat::EXTENDED_FLAG) <= Packet::MAX_PAYLOAD_LENGTH &&
+                     (buffer[1] & 0x03) == Checksum::calculate2BitChecksum(headerField);
+        return valid ? Check::Continue : Check::Fail;
+    }
+    if (position == 2) {
+        if (secded) {
+            if (HeaderCode::decode(buffer.data() + 1, headerField, headerIndex) < 0 ||
+                (headerField & ~PacketFormat::EXTENDED_FLAG) > Packet::MAX_PAYLOAD_LENGTH) {
+                return Check::Fail;
+            }
+        } else {
+            headerIndex = (buffer[2] >> 2) & 0x3F;
+        }
+    }
+
+    uint8_t payloadLength = headerField & ~PacketFormat::EXTENDED_FLAG;
+    bool extended = (headerField & PacketFormat::EXTENDED_FLAG) != 0;
+
+    // Every restored START_BYTE is a payload byte. Checked once the format is
+    // known, since parity may repair a damaged COBS byte
+    auto checkIndex = [&] {
+        return candidate.fecParity != 0 || headerIndex <= payloadLength ? Check::Continue : Check::Fail;
+    };
+
+    if (position == 2) {
+        return extended ? Check::Continue : checkIndex();
+    }
+
+    if (extended && position == 3) {
+        uint8_t options = optionsField(buffer.data());
+        bool valid = (buffer[3] & 0x03) == Checksum::calculate2BitChecksum(options) &&
+                     PacketFormat::fromOptionsValue(options, candidate) && candidate.isExtended();
+        return valid ? checkIndex() : Check::Fail;
+    }
+
+    size_t headerLength = candidate.headerLength();
+    size_t encodedEnd = headerLength + payloadLength + 1;
+    size_t length = frameLength(payloadLength, candidate);
+    if (candidate.fecParity != 0) {
+        // Any byte of the body may be damaged until the parity is applied
+        if (position + 1 < length) {
+            return Check::Continue;
+        }
+        int corrected = PacketView::correct(buffer.data(), length, candidate);
+        if (corrected < 0) {
+            return Check::Fail;
+        }
+        stats.bytesCorrected += static_cast<uint64_t>(corrected);
+    } else if (position < encodedEnd) {
+        if (buffer[position] == Packet::START_BYTE) {
+            return Check::Fail;
+        }
+        if (position + 1 == encodedEnd && !secded) {
+            uint8_t cobsChecksum = Checksum::calculate2BitChecksum(buffer.data() + headerLength, payloadLength + 1);
+            if ((buffer[2] & 0x03) != cobsChecksum) {
+                return Check::Fail;
+            }
+        }
+        return Check::Continue;
+    } else if (position + 1 < length) {
+        return Check::Continue; // Rest of a multi-byte CRC
+    }
+
+    // Last byte completes the packet; PacketView runs the remaining checks
+    if (PacketView::parse(buffer.data(), position + 1, completed, protection) != PacketView::Status::Ok) {
+        return Check::Fail;
+    }
+    // Repair a flipped header bit only now, so a false start never alters
+    // bytes that are replayed after it
+    if (secded && HeaderCode::correct(buffer.data() + 1) > 0) {
+        stats.bytesCorrected++;
+    }
+    return Check::Complete;
+}
+
+void FrameParser::process() {
+    while (checked < buffered) {
+        switch (checkByte(checked)) {
+            case Check::Continue:
+                checked++;
+                break;
+
+            case Check::Complete: {
+                size_t length = checked + 1;
+                stats.framesParsed++;
+                if (onFrame) {
+                    onFrame(completed, bufferOffset);
+                }
+                buffered -= length;
+                std::memmove(buffer.data(), buffer.data() + length, buffered);
+                bufferOffset += length;
+                checked = 0;
+                drop(0);
+                break;
+            }
+
+            case Check::Fail:
+                stats.resyncs++;
+                stats.bytesDiscarded++;
+                drop(1);
+                break;
+        }
+    }
+}
+
+void FrameParser::drop(size_t count) {
+    // Resume at the next START_BYTE among the remaining buffered bytes
+    size_t next = count;
+    while (next < buffered && buffer[next] != Packet::START_BYTE) {
+        next++;
+    }
+    stats.bytesDiscarded += next - count;
+    buffered -= next;
+    std::memmove(buffer.data(), buffer.data() + next, buffered);
+    bufferOffset += next;
+    checked = 0;
+}
+
+} // namespace SCALPEL
@@ -0,0 +1,86 @@
+#ifndef FRAMEPARSER_HPP
+#define FRAMEPARSER_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include "Packet.hpp"
+#include "PacketView.hpp"
+#include "Span.hpp"
+
+namespace SCALPEL {
+
+// Finds SCALPEL packets in a raw byte stream fed in chunks of any size.
+// The parser hunts for START_BYTE, then checks each header field as it
+// arrives so a false start is rejected after as few bytes as possible:
+// the length checksum at byte 1, the COBS index at byte 2, the absence of
+// START_BYTE inside the encoded payload, the COBS checksum once the payload
+// is complete, and finally the CRC. Extended packets also have their
+// options byte checked at byte 3; packets carrying Reed-Solomon parity are
+// corrected once complete, so they survive damage anywhere after the length
+// and options bytes. On any failure it resyncs on the next START_BYTE after
+// the rejected one, replaying bytes it already buffered.
+//
+// With Secded header protection the length and COBS bytes are decoded
+// together at byte 2, and a single flipped header bit is corrected in the
+// emitted packet instead of rejecting it.
+class FrameParser {
+public:
+    // Called for each valid packet with the stream offset of its START_BYTE.
+    // The view points into the parser's buffer and is only valid during the
+    // call.
+    using FrameCallback = std::function<void(const PacketView& frame, uint64_t offset)>;
+
+    struct Stats {
+        uint64_t bytesConsumed = 0;  // Bytes fed to the parser
+        uint64_t framesParsed = 0;   // Valid packets emitted
+        uint64_t bytesDiscarded = 0; // Bytes not belonging to any emitted packet
+        uint64_t resyncs = 0;        // Candidate packets rejected after their START_BYTE
+        uint64_t bytesCorrected = 0; // Bytes repaired by Reed-Solomon parity or the header code
+    };
+
+    explicit FrameParser(FrameCallback onFrame,
+                         PacketFormat::HeaderProtection protection = PacketFormat::HeaderProtection::Checksum);
+
+    // Parse a chunk, invoking the callback for every packet it completes
+    void feed(Span<const uint8_t> chunk);
+
+    // Drop any partially received packet; its bytes count as discarded
+    void reset();
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    enum class Check { Continue, Complete, Fail };
+
+    // Validate the buffered byte at position, given the bytes before it.
+    // On Complete, completed views the packet
+    Check checkByte(size_t position);
+
+    // Bytes the current candidate needs buffered before it can be checked
+    // further, i.e. its header or, once that is known, its full length
+    size_t targetLength() const;
+
+    // Re-run the checks over buffered bytes not yet validated
+    void process();
+
+    // Drop the first count buffered bytes and advance to the next START_BYTE
+    void drop(size_t count);
+
+    FrameCallback onFrame;
+    PacketFormat::HeaderProtection protection;
+    std::array<uint8_t, Packet::MAX_PACKET_LENGTH> buffer;
+    size_t buffered = 0;      // Bytes in buffer; buffer[0] is START_BYTE when nonzero
+    size_t checked = 0;       // Leading buffered bytes already validated
+    uint64_t bufferOffset = 0; // Stream offset of buffer[0]
+    PacketFormat candidate;   // Format of the buffered candidate, from its header
+    uint8_t headerField = 0;  // Length field of the candidate, once checked
+    uint8_t headerIndex = 0;  // COBS index of the candidate, once checked
+    PacketView completed;
+    Stats stats;
+};
+
+} // namespace SCALPEL
+
+#endif // FRAMEPARSER_HPP
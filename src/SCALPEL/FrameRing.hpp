@@ -0,0 +1,164 @@
+#ifndef FRAMERING_HPP
+#define FRAMERING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "Span.hpp"
+
+namespace SCALPEL {
+
+// Bounded lock-free queue of fixed-size frame slots with any number of
+// producers and a single consumer.
+//
+// A producer claims the next slot, writes its frame straight into the slot
+// and publishes it; the consumer reads frames in place and releases them in
+// order. Each slot carries a sequence number (Vyukov's bounded queue): it
+// equals the slot's position while free, position + 1 once published and
+// position + SLOTS after the consumer releases it, so producers never wait
+// on each other except to claim a position and nothing is copied or
+// allocated beyond the one write into the slot. The producer and consumer
+// indices live on separate cache lines, as does every slot. Each frame
+// also carries a one-byte tag for the caller's use, such as a traffic class.
+//
+// SLOTS must be a power of two.
+template <size_t SLOT_BYTES, size_t SLOTS>
+class FrameRing {
+    static_assert(SLOTS >= 2 && (SLOTS & (SLOTS - 1)) == 0, "FrameRing needs a power-of-two slot count");
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct Slot;
+
+public:
+    static constexpr size_t MAX_FRAME_LENGTH = SLOT_BYTES;
+    static constexpr size_t CAPACITY = SLOTS;
+
+    // A claimed slot; fill data() and publish it with commit()
+    class Reservation {
+    public:
+        Reservation() = default;
+
+        explicit operator bool() const { return slot != nullptr; }
+        uint8_t* data() const { return slot->bytes.data(); }
+
+    private:
+        friend class FrameRing;
+        Reservation(Slot* slot, uint64_t position) : slot(slot), position(position) {}
+
+        Slot* slot = nullptr;
+        uint64_t position = 0;
+    };
+
+    FrameRing() {
+        for (size_t i = 0; i < SLOTS; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    FrameRing(const FrameRing&) = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+
+    // Claim the next free slot; an empty reservation when the ring is full.
+    // Any thread
+    Reservation tryReserve() {
+        uint64_t position = tail.value.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[position & (SLOTS - 1)];
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+            if (difference == 0) {
+                if (tail.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    return Reservation(&slot, position);
+                }
+            } else if (difference < 0) {
+                return Reservation();
+            } else {
+                position = tail.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Publish a reserved slot holding length bytes, which must be nonzero
+    // and at most MAX_FRAME_LENGTH
+    void commit(const Reservation& reservation, size_t length, uint8_t tag = 0) {
+        reservation.slot->length = static_cast<uint32_t>(length);
+        reservation.slot->tag = tag;
+        reservation.slot->sequence.store(reservation.position + 1, std::memory_order_release);
+    }
+
+    // Frame i places behind the oldest unreleased one, or an empty span if
+    // it has not been published yet. Consumer only
+    Span<const uint8_t> peek(size_t i = 0) const {
+        uint64_t position = head.value.load(std::memory_order_relaxed) + i;
+        const Slot& slot = slots[position & (SLOTS - 1)];
+        if (i >= SLOTS || slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            return Span<const uint8_t>();
+        }
+        return Span<const uint8_t>(slot.bytes.data(), slot.length);
+    }
+
+    // Tag of frame i, which peek(i) must have returned. Consumer only
+    uint8_t tag(size_t i = 0) const {
+        return slots[(head.value.load(std::memory_order_relaxed) + i) & (SLOTS - 1)].tag;
+    }
+
+    // Discard frame i, which peek(i) must have returned, by moving the i
+    // older frames up one slot and releasing the oldest. Copies i frames, so
+    // meant for occasional eviction rather than the normal path. Consumer only
+    void erase(size_t i) {
+        uint64_t position = head.value.load(std::memory_order_relaxed) + i;
+        for (; i > 0; --i, --position) {
+            Slot& to = slots[position & (SLOTS - 1)];
+            const Slot& from = slots[(position - 1) & (SLOTS - 1)];
+            to.length = from.length;
+            to.tag = from.tag;
+            std::memcpy(to.bytes.data(), from.bytes.data(), from.length);
+        }
+        pop();
+    }
+
+    // Release the oldest frame, which peek() must have returned. Consumer only
+    void pop() {
+        uint64_t position = head.value.load(std::memory_order_relaxed);
+        slots[position & (SLOTS - 1)].sequence.store(position + SLOTS, std::memory_order_release);
+        head.value.store(position + 1, std::memory_order_relaxed);
+    }
+
+    // Whether the oldest slot holds no published frame. Consumer only
+    bool empty() const {
+        return peek().empty();
+    }
+
+    // Frames claimed but not yet released; a snapshot while producers run.
+    // Any thread
+    size_t size() const {
+        uint64_t released = head.value.load(std::memory_order_relaxed);
+        uint64_t claimed = tail.value.load(std::memory_order_relaxed);
+        return claimed > released ? static_cast<size_t>(claimed - released) : 0;
+    }
+
+private:
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<uint64_t> sequence{0};
+        uint32_t length = 0;
+        uint8_t tag = 0;
+        std::array<uint8_t, SLOT_BYTES> bytes;
+    };
+
+    // Written by producers and the consumer respectively; the consumer's
+    // index is atomic only so size() can read it from other threads
+    struct alignas(CACHE_LINE) Index {
+        std::atomic<uint64_t> value{0};
+    };
+
+    Index tail;
+    Index head;
+    std::array<Slot, SLOTS> slots;
+};
+
+} // namespace SCALPEL
+
+#endif // FRAMERING_HPP
@@ -0,0 +1,123 @@
+#include "GatherFrame.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <sys/uio.h>
+#endif
+
+namespace SCALPEL {
+
+Span<uint8_t> GatherFrame::reserve(size_t size) {
+    if (size > store.size() - stored) {
+        throw std::length_error("Gather frame inline storage exhausted.");
+    }
+    uint8_t* data = store.data() + stored;
+    addSegment(data, size);
+    stored += size;
+    return Span<uint8_t>(data, size);
+}
+
+Span<const uint8_t> GatherFrame::append(Span<const uint8_t> bytes) {
+    Span<uint8_t> space = reserve(bytes.size());
+    if (!bytes.empty()) {
+        std::memcpy(space.data(), bytes.data(), bytes.size());
+    }
+    return Span<const uint8_t>(space.data(), space.size());
+}
+
+void GatherFrame::appendReference(Span<const uint8_t> bytes) {
+    addSegment(bytes.data(), bytes.size());
+}
+
+Span<const uint8_t> GatherFrame::appendPacket(const Packet& packet) {
+    Span<uint8_t> space = reserve(packet.getAssembledLength());
+    packet.assembleInto(space.data(), space.size());
+    return Span<const uint8_t>(space.data(), space.size());
+}
+
+void GatherFrame::clear() {
+    count = 0;
+    stored = 0;
+    length = 0;
+}
+
+void GatherFrame::addSegment(const uint8_t* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    if (count != 0) {
+        Span<const uint8_t>& last = segmentList[count - 1];
+        if (last.data() + last.size() == data) {
+            last = Span<const uint8_t>(last.data(), last.size() + size);
+            length += size;
+            return;
+        }
+    }
+    if (count == segmentList.size()) {
+        throw std::length_error("Gather frame has too many segments.");
+    }
+    segmentList[count] = Span<const uint8_t>(data, size);
+    count++;
+    length += size;
+}
+
+size_t GatherFrame::copyTo(uint8_t* out) const {
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(out + written, segmentList[i].data(), segmentList[i].size());
+        written += segmentList[i].size();
+    }
+    return written;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+size_t GatherFrame::writeTo(int fd) const {
+    // writev may stop part way through a segment; resume from a local copy
+    // of the segment list so the frame itself stays intact
+    std::array<iovec, MAX_SEGMENTS> pending;
+    for (size_t i = 0; i < count; ++i) {
+        pending[i].iov_base = const_cast<uint8_t*>(segmentList[i].data());
+        pending[i].iov_len = segmentList[i].size();
+    }
+    iovec* next = pending.data();
+    size_t remaining = count;
+
+    while (remaining != 0) {
+        ssize_t result = ::writev(fd, next, static_cast<int>(remaining));
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                pollfd ready{fd, POLLOUT, 0};
+                if (::poll(&ready, 1, -1) < 0 && errno != EINTR) {
+                    throw std::system_error(errno, std::generic_category(), "poll failed");
+                }
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "writev failed");
+        }
+
+        size_t done = static_cast<size_t>(result);
+        while (remaining != 0 && done >= next->iov_len) {
+            done -= next->iov_len;
+            ++next;
+            --remaining;
+        }
+        if (remaining != 0) {
+            next->iov_base = static_cast<uint8_t*>(next->iov_base) + done;
+            next->iov_len -= done;
+        }
+    }
+    return length;
+}
+
+#endif
+
+} // namespace SCALPEL
@@ -0,0 +1,88 @@
+#ifndef GATHERFRAME_HPP
+#define GATHERFRAME_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "Packet.hpp"
+#include "Span.hpp"
+
+namespace SCALPEL {
+
+// Outgoing frame held as a list of segments and written with a single gather
+// write, so each layer adds its framing as a segment of its own instead of
+// copying the inner frame into a bigger buffer.
+//
+// Generated bytes (radio headers, trailers, assembled packets) live in a
+// fixed inline store; reserve() hands out space there, and a reservation
+// directly after the previous one extends its segment, so a frame built
+// entirely in place still goes out as one segment. appendReference() adds
+// caller-owned bytes, e.g. packets already assembled by assembleBatch,
+// without copying them; they must stay alive until the frame is written.
+//
+// Segments point into the inline store, so a frame is neither copyable nor
+// movable. Not thread-safe.
+class GatherFrame {
+public:
+    static constexpr size_t MAX_SEGMENTS = 32;
+    static constexpr size_t INLINE_CAPACITY = 512;
+
+    GatherFrame() = default;
+    GatherFrame(const GatherFrame&) = delete;
+    GatherFrame& operator=(const GatherFrame&) = delete;
+
+    // Reserve length bytes of inline storage at the end of the frame, for
+    // the caller to fill in before writing. Throws std::length_error if the
+    // store or the segment list is full
+    Span<uint8_t> reserve(size_t length);
+
+    // Append a copy of bytes; meant for short generated fields
+    Span<const uint8_t> append(Span<const uint8_t> bytes);
+
+    // Append caller-owned bytes without copying them. Throws
+    // std::length_error if the segment list is full
+    void appendReference(Span<const uint8_t> bytes);
+
+    // Assemble a packet straight into inline storage; returns its bytes
+    Span<const uint8_t> appendPacket(const Packet& packet);
+
+    // Drop every segment, keeping nothing referenced
+    void clear();
+
+    const Span<const uint8_t>* segments() const { return segmentList.data(); }
+    size_t segmentCount() const { return count; }
+
+    // Bytes of the i-th segment
+    Span<const uint8_t> segment(size_t i) const { return segmentList[i]; }
+
+    // Total frame length
+    size_t size() const { return length; }
+
+    // Bytes held in the inline store rather than referenced
+    size_t inlineLength() const { return stored; }
+
+    // Copy the frame into out, which must hold size() bytes; for tests and
+    // transports without gather writes. Returns size()
+    size_t copyTo(uint8_t* out) const;
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Write the whole frame to fd, issuing writev again after partial writes
+    // and waiting for POLLOUT when fd is non-blocking. Returns size(); throws
+    // std::system_error if a write fails
+    size_t writeTo(int fd) const;
+#endif
+
+private:
+    // Add or extend a segment ending at data + size
+    void addSegment(const uint8_t* data, size_t size);
+
+    std::array<uint8_t, INLINE_CAPACITY> store;
+    std::array<Span<const uint8_t>, MAX_SEGMENTS> segmentList;
+    size_t count = 0;
+    size_t stored = 0;
+    size_t length = 0;
+};
+
+} // namespace SCALPEL
+
+#endif // GATHERFRAME_HPP
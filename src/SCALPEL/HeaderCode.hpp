@@ -0,0 +1,175 @@
+#ifndef HEADERCODE_HPP
+#define HEADERCODE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "ChecksumTables.hpp"
+#include "PacketFormat.hpp"
+
+namespace SCALPEL {
+
+// Extended Hamming (16,11) code over the length and COBS bytes, used when a
+// link runs PacketFormat::HeaderProtection::Secded. The two bytes carry
+// eleven data bits, enough for everything the header says: the extended
+// flag, the payload length (at most 28) and the COBS index (at most the
+// length). Any single flipped bit is corrected and any two are detected,
+// where the 2-bit checksums can only reject the frame.
+//
+// Codeword bit p is Hamming position p: parity bits at positions 1, 2, 4
+// and 8, the overall parity bit at 0 and data bits at the rest. frame[1]
+// holds positions 15..8 and frame[2] positions 7..0. Decoding is two
+// table lookups per byte.
+namespace HeaderCode {
+
+constexpr uint16_t DATA_BITS = 11;
+
+// Hamming positions of the data bits, least significant first
+constexpr std::array<uint8_t, DATA_BITS> DATA_POSITIONS = {3, 5, 6, 7, 9, 10, 11, 12, 13, 14, 15};
+
+// Data word: extended flag in bit 10, payload length in bits 9..5, COBS
+// index in bits 4..0
+constexpr uint16_t pack(uint8_t lengthField, uint8_t cobsIndex) {
+    return static_cast<uint16_t>(((lengthField & PacketFormat::EXTENDED_FLAG) ? 0x400 : 0) |
+                                 (lengthField & 0x1F) << 5 | (cobsIndex & 0x1F));
+}
+
+constexpr uint8_t lengthFieldOf(uint16_t data) {
+    return static_cast<uint8_t>(((data & 0x400) ? PacketFormat::EXTENDED_FLAG : 0) | (data >> 5 & 0x1F));
+}
+
+constexpr uint8_t cobsIndexOf(uint16_t data) {
+    return static_cast<uint8_t>(data & 0x1F);
+}
+
+constexpr uint16_t encodeBits(uint16_t data) {
+    uint16_t codeword = 0;
+    for (size_t i = 0; i < DATA_BITS; ++i) {
+        if (data >> i & 1) {
+            codeword = static_cast<uint16_t>(codeword | 1u << DATA_POSITIONS[i]);
+        }
+    }
+    // Parity bit 2^k covers every position with bit k set
+    for (unsigned k = 0; k < 4; ++k) {
+        unsigned parity = 0;
+        for (unsigned position = 1; position < 16; ++position) {
+            if ((position >> k & 1) && (codeword >> position & 1)) {
+                parity ^= 1;
+            }
+        }
+        codeword = static_cast<uint16_t>(codeword | parity << (1u << k));
+    }
+    unsigned overall = 0;
+    for (unsigned position = 1; position < 16; ++position) {
+        overall ^= codeword >> position & 1;
+    }
+    return static_cast<uint16_t>(codeword | overall);
+}
+
+constexpr std::array<uint16_t, 1u << DATA_BITS> makeEncodeTable() {
+    std::array<uint16_t, 1u << DATA_BITS> table{};
+    for (size_t data = 0; data < table.size(); ++data) {
+        table[data] = encodeBits(static_cast<uint16_t>(data));
+    }
+    return table;
+}
+
+// Per header byte (0 = frame[1], 1 = frame[2]) and value: the XOR of the
+// Hamming positions of its set bits in bits 3..0 and their parity in bit 4
+constexpr std::array<std::array<uint8_t, 256>, 2> makeSyndromeTables() {
+    std::array<std::array<uint8_t, 256>, 2> tables{};
+    for (unsigned byte = 0; byte < 2; ++byte) {
+        unsigned base = byte == 0 ? 8 : 0;
+        for (unsigned value = 0; value < 256; ++value) {
+            unsigned syndrome = 0;
+            for (unsigned bit = 0; bit < 8; ++bit) {
+                if (value >> bit & 1) {
+                    syndrome ^= base + bit;
+                    syndrome ^= 0x10;
+                }
+            }
+            tables[byte][value] = static_cast<uint8_t>(syndrome);
+        }
+    }
+    return tables;
+}
+
+// Per header byte and value: the data bits it carries
+constexpr std::array<std::array<uint16_t, 256>, 2> makeDataTables() {
+    std::array<std::array<uint16_t, 256>, 2> tables{};
+    for (unsigned byte = 0; byte < 2; ++byte) {
+        unsigned base = byte == 0 ? 8 : 0;
+        for (unsigned value = 0; value < 256; ++value) {
+            uint16_t data = 0;
+            for (size_t i = 0; i < DATA_BITS; ++i) {
+                unsigned position = DATA_POSITIONS[i];
+                if (position >= base && position < base + 8 && (value >> (position - base) & 1)) {
+                    data = static_cast<uint16_t>(data | 1u << i);
+                }
+            }
+            tables[byte][value] = data;
+        }
+    }
+    return tables;
+}
+
+inline constexpr std::array<uint16_t, 1u << DATA_BITS> ENCODE_TABLE = makeEncodeTable();
+inline constexpr std::array<std::array<uint8_t, 256>, 2> SYNDROME_TABLES = makeSyndromeTables();
+inline constexpr std::array<std::array<uint16_t, 256>, 2> DATA_TABLES = makeDataTables();
+
+static_assert(ENCODE_TABLE[0] == 0, "Header code table generation is broken");
+static_assert((SYNDROME_TABLES[0][ENCODE_TABLE[0x5A5] >> 8] ^ SYNDROME_TABLES[1][ENCODE_TABLE[0x5A5] & 0xFF]) == 0,
+              "Header code table generation is broken");
+
+// Write the codeword for the given header fields into header[0..1]
+inline void encode(uint8_t lengthField, uint8_t cobsIndex, uint8_t* header) {
+    uint16_t codeword = ENCODE_TABLE[pack(lengthField, cobsIndex)];
+    header[0] = static_cast<uint8_t>(codeword >> 8);
+    header[1] = static_cast<uint8_t>(codeword & 0xFF);
+}
+
+// Correct header[0..1] in place. Returns 0 if it was intact, 1 if one bit
+// was corrected, or -1 if two bits are in error (header left untouched)
+inline int correct(uint8_t* header) {
+    unsigned syndrome = SYNDROME_TABLES[0][header[0]] ^ SYNDROME_TABLES[1][header[1]];
+    if (syndrome == 0) {
+        return 0;
+    }
+    if (!(syndrome & 0x10)) {
+        return -1; // Even number of errors with a nonzero syndrome
+    }
+    unsigned position = syndrome & 0x0F;
+    header[position >= 8 ? 0 : 1] ^= static_cast<uint8_t>(1u << (position & 7));
+    return 1;
+}
+
+// Decode header[0..1] without modifying it. Returns what correct() would
+inline int decode(const uint8_t* header, uint8_t& lengthField, uint8_t& cobsIndex) {
+    uint8_t copy[2] = {header[0], header[1]};
+    int corrected = correct(copy);
+    if (corrected >= 0) {
+        uint16_t data = DATA_TABLES[0][copy[0]] | DATA_TABLES[1][copy[1]];
+        lengthField = lengthFieldOf(data);
+        cobsIndex = cobsIndexOf(data);
+    }
+    return corrected;
+}
+
+// Length field and COBS index of the packet in frame, under either header
+// protection; false if the header is unusable (a failed length checksum, or
+// an uncorrectable codeword)
+inline bool readHeader(const uint8_t* frame, PacketFormat::HeaderProtection protection, uint8_t& lengthField,
+                       uint8_t& cobsIndex) {
+    if (protection == PacketFormat::HeaderProtection::Secded) {
+        return decode(frame + 1, lengthField, cobsIndex) >= 0;
+    }
+    lengthField = (frame[1] >> 2) & 0x3F;
+    cobsIndex = (frame[2] >> 2) & 0x3F;
+    return (frame[1] & 0x03) == ChecksumTables::TWO_BIT_TABLE[lengthField];
+}
+
+} // namespace HeaderCode
+
+} // namespace SCALPEL
+
+#endif // HEADERCODE_HPP
@@ -0,0 +1,175 @@
+#include "Interleaver.hpp"
+#include "HeaderCode.hpp"
+#include "Packet.hpp"
+#include "PacketView.hpp"
+#include <stdexcept>
+
+namespace SCALPEL {
+
+namespace {
+
+void checkGeometry(size_t depth, size_t slotLength) {
+    if (depth == 0 || depth > Interleaver::MAX_DEPTH) {
+        throw std::invalid_argument("Interleaver depth out of range.");
+    }
+    if (slotLength == 0) {
+        throw std::invalid_argument("Interleaver slot length must be nonzero.");
+    }
+}
+
+} // namespace
+
+Interleaver::Interleaver(size_t depth, size_t slotLength, BlockCallback onBlock)
+    : depth(depth), slotLength(slotLength), onBlock(std::move(onBlock)) {
+    checkGeometry(depth, slotLength);
+    block.resize(depth * slotLength);
+}
+
+void Interleaver::push(Span<const uint8_t> packet) {
+    if (packet.size() > slotLength) {
+        throw std::length_error("Packet longer than interleaver slot.");
+    }
+
+    if (depth == 1) {
+        if (onBlock) {
+            onBlock(packet);
+        }
+        return;
+    }
+
+    // Write the packet as row `rows`, i.e. every depth-th byte of the block
+    uint8_t* out = block.data() + rows;
+    size_t column = 0;
+    for (; column < packet.size(); ++column) {
+        out[column * depth] = packet[column];
+    }
+    for (; column < slotLength; ++column) {
+        out[column * depth] = FILL_BYTE;
+    }
+
+    if (++rows == depth) {
+        if (onBlock) {
+            onBlock(Span<const uint8_t>(block.data(), block.size()));
+        }
+        rows = 0;
+    }
+}
+
+void Interleaver::flush() {
+    while (rows != 0) {
+        push(Span<const uint8_t>());
+    }
+}
+
+void Interleaver::setDepth(size_t newDepth) {
+    checkGeometry(newDepth, slotLength);
+    flush();
+    depth = newDepth;
+    block.resize(depth * slotLength);
+}
+
+Deinterleaver::Deinterleaver(size_t depth, size_t slotLength, DataCallback onData)
+    : depth(depth), slotLength(slotLength), onData(std::move(onData)) {
+    checkGeometry(depth, slotLength);
+    rowsBuffer.resize(depth * slotLength);
+}
+
+void Deinterleaver::feed(Span<const uint8_t> chunk) {
+    if (depth == 1) {
+        if (onData && !chunk.empty()) {
+            onData(chunk);
+        }
+        return;
+    }
+
+    // Incoming byte i of a block is column i / depth of row i % depth
+    for (size_t i = 0; i < chunk.size(); ++i) {
+        rowsBuffer[row * slotLength + column] = chunk[i];
+        if (++row == depth) {
+            row = 0;
+            if (++column == slotLength) {
+                column = 0;
+                emit();
+            }
+        }
+    }
+}
+
+bool Deinterleaver::feedAt(size_t offset, Span<const uint8_t> chunk, bool newBlock) {
+    if (depth == 1) {
+        feed(chunk);
+        return true;
+    }
+
+    const size_t blockLength = getBlockLength();
+    if (offset >= blockLength || chunk.size() > blockLength - offset) {
+        return false;
+    }
+    size_t position = column * depth + row;
+    if (position != 0 && (newBlock || offset < position)) {
+        fill(blockLength - position);
+        position = 0;
+    }
+    fill(offset - position);
+    feed(chunk);
+    return true;
+}
+
+void Deinterleaver::fill(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        rowsBuffer[row * slotLength + column] = Interleaver::FILL_BYTE;
+        if (++row == depth) {
+            row = 0;
+            if (++column == slotLength) {
+                column = 0;
+                emit();
+            }
+        }
+    }
+}
+
+void Deinterleaver::emit() {
+    if (slotFormat.fecParity != 0) {
+        for (size_t slot = 0; slot < depth; ++slot) {
+            uint8_t* packet = rowsBuffer.data() + slot * slotLength;
+            int corrected = PacketView::correct(packet, slotLength, slotFormat);
+            // Padding slots decode too; only a packet header carries the flag
+            uint8_t lengthField;
+            uint8_t cobsIndex;
+            if (corrected < 0 ||
+                !HeaderCode::readHeader(packet, slotFormat.headerProtection, lengthField, cobsIndex) ||
+                !(lengthField & PacketFormat::EXTENDED_FLAG)) {
+                continue;
+            }
+            if (packet[0] != Packet::START_BYTE) {
+                packet[0] = Packet::START_BYTE;
+                corrected++;
+            }
+            bytesCorrected += static_cast<uint64_t>(corrected);
+        }
+    }
+    if (onData) {
+        onData(Span<const uint8_t>(rowsBuffer.data(), rowsBuffer.size()));
+    }
+}
+
+void Deinterleaver::setSlotFormat(const PacketFormat& format) {
+    if (!format.isValid()) {
+        throw std::invalid_argument("Unsupported packet format.");
+    }
+    slotFormat = format;
+}
+
+void Deinterleaver::reset() {
+    row = 0;
+    column = 0;
+}
+
+void Deinterleaver::setDepth(size_t newDepth) {
+    checkGeometry(newDepth, slotLength);
+    reset();
+    depth = newDepth;
+    rowsBuffer.resize(depth * slotLength);
+}
+
+} // namespace SCALPEL
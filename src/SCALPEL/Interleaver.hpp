@@ -0,0 +1,129 @@
+#ifndef INTERLEAVER_HPP
+#define INTERLEAVER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "PacketFormat.hpp"
+#include "Span.hpp"
+
+namespace SCALPEL {
+
+// Block interleaver that sits between Packet::assembleInto and the radio.
+//
+// A block holds depth assembled packets, each padded with FILL_BYTE to
+// slotLength bytes. Packets are written as rows and the block is sent
+// column by column, so consecutive bytes on the air belong to different
+// packets: a burst of b bytes damages at most ceil(b / depth) bytes of any
+// one packet, which per-packet Reed-Solomon parity can then repair.
+//
+// The price is latency: a packet is not sent until the block is full (or
+// flush() is called), and the receiver cannot restore it until the whole
+// block has arrived. A depth of 1 disables interleaving and passes packets
+// through unpadded.
+class Interleaver {
+public:
+    // Padding after short packets; never START_BYTE, so FrameParser skips it
+    static constexpr uint8_t FILL_BYTE = 0x00;
+
+    static constexpr size_t MAX_DEPTH = 64;
+
+    // Called with each interleaved block, or with each packet at depth 1.
+    // The view is only valid for the duration of the call.
+    using BlockCallback = std::function<void(Span<const uint8_t> block)>;
+
+    // Throws std::invalid_argument if depth is 0 or above MAX_DEPTH, or if
+    // slotLength is 0
+    Interleaver(size_t depth, size_t slotLength, BlockCallback onBlock);
+
+    // Add an assembled packet; emits the block once it holds depth packets.
+    // Throws std::length_error if the packet is longer than slotLength
+    void push(Span<const uint8_t> packet);
+
+    // Pad the rest of a partial block with fill bytes and emit it
+    void flush();
+
+    // Change the depth at the next block boundary; a partial block is flushed
+    void setDepth(size_t depth);
+
+    size_t getDepth() const { return depth; }
+    size_t getSlotLength() const { return slotLength; }
+    size_t getBlockLength() const { return depth * slotLength; }
+
+    // Packets waiting in the current block
+    size_t pending() const { return rows; }
+
+private:
+    size_t depth;
+    size_t slotLength;
+    BlockCallback onBlock;
+    std::vector<uint8_t> block; // Column-major: byte c of row r at c * depth + r
+    size_t rows = 0;
+};
+
+// Receive side of Interleaver. feed() takes the blocks in order starting at a
+// block boundary, so it suits transports that preserve that alignment. When
+// the sender marks where each chunk sits in its block, as the radios do,
+// feedAt() realigns after lost bytes instead. Each restored block is passed
+// on as the concatenation of its padded packets, ready for FrameParser.
+class Deinterleaver {
+public:
+    // Called with each restored block, or with each fed chunk at depth 1.
+    // The view is only valid for the duration of the call.
+    using DataCallback = std::function<void(Span<const uint8_t> data)>;
+
+    // Same limits as Interleaver
+    Deinterleaver(size_t depth, size_t slotLength, DataCallback onData);
+
+    // Consume interleaved bytes, emitting every block they complete
+    void feed(Span<const uint8_t> chunk);
+
+    // Consume interleaved bytes that start offset bytes into their block.
+    // Bytes lost before them are filled with FILL_BYTE, which spreads the
+    // loss over every slot of the block like any other burst. If the chunk
+    // starts a new block (newBlock is set, or offset is behind the bytes
+    // already received) the rest of the partial block is filled and emitted
+    // first. Returns false and consumes nothing if the chunk does not fit in
+    // a block. At depth 1 this is feed()
+    bool feedAt(size_t offset, Span<const uint8_t> chunk, bool newBlock = false);
+
+    // Discard a partially received block
+    void reset();
+
+    // Change the depth; a partial block is discarded
+    void setDepth(size_t depth);
+
+    // On links where every packet has this format and exactly fills its slot,
+    // apply the Reed-Solomon parity to each slot before passing the block on.
+    // Unlike FrameParser this also repairs the START, length and options
+    // bytes; slots that do not decode are passed on unchanged. Has no effect
+    // at depth 1, where packets are not padded into slots
+    void setSlotFormat(const PacketFormat& format);
+
+    size_t getDepth() const { return depth; }
+    size_t getSlotLength() const { return slotLength; }
+    size_t getBlockLength() const { return depth * slotLength; }
+
+    // Bytes repaired by setSlotFormat correction
+    uint64_t getBytesCorrected() const { return bytesCorrected; }
+
+private:
+    void emit();
+
+    // Feed count fill bytes in place of lost ones
+    void fill(size_t count);
+
+    size_t depth;
+    size_t slotLength;
+    DataCallback onData;
+    PacketFormat slotFormat;
+    uint64_t bytesCorrected = 0;
+    std::vector<uint8_t> rowsBuffer; // Row-major: the packets as sent
+    size_t row = 0;                  // Position of the next byte in the block
+    size_t column = 0;
+};
+
+} // namespace SCALPEL
+
+#endif // INTERLEAVER_HPP
@@ -0,0 +1,273 @@
+#include "LoopbackTransport.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace SCALPEL {
+
+namespace {
+
+int64_t clockNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void validate(const LoopbackTransport::LinkModel& model) {
+    if (model.latency.count() < 0 || model.jitter.count() < 0) {
+        throw std::invalid_argument("Loopback latency and jitter must not be negative.");
+    }
+    if (!(model.lossRate >= 0 && model.lossRate <= 1) || !(model.bitErrorRate >= 0 && model.bitErrorRate <= 1)) {
+        throw std::invalid_argument("Loopback loss and bit error rates must be within [0, 1].");
+    }
+}
+
+} // namespace
+
+// State shared by both ends; channels[i] and endpoints[i] belong to side i
+struct LoopbackTransport::Link {
+    struct Endpoint {
+        // Set by an end about to sleep, so the other knows to signal it
+        // after adding to its input or freeing room in its output
+        std::atomic<bool> waitingForInput{false};
+        std::atomic<bool> waitingForSpace{false};
+
+        // Wakes the end's loop; a signal sent while it is awake is kept
+        // for its next sleep
+        std::mutex mutex;
+        std::condition_variable wake;
+        bool signalled = false;
+
+        void signal() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                signalled = true;
+            }
+            wake.notify_one();
+        }
+    };
+
+    Channel channels[2]; // What side i sends
+    Endpoint endpoints[2];
+};
+
+LoopbackTransport::Pair LoopbackTransport::createPair() {
+    return createPair(LinkModel(), LinkModel());
+}
+
+LoopbackTransport::Pair LoopbackTransport::createPair(const LinkModel& bothWays) {
+    return createPair(bothWays, bothWays);
+}
+
+LoopbackTransport::Pair LoopbackTransport::createPair(const LinkModel& firstToSecond, const LinkModel& secondToFirst) {
+    validate(firstToSecond);
+    validate(secondToFirst);
+    std::shared_ptr<Link> link = std::make_shared<Link>();
+    std::unique_ptr<LoopbackTransport> first(new LoopbackTransport(link, 0, firstToSecond));
+    std::unique_ptr<LoopbackTransport> second(new LoopbackTransport(link, 1, secondToFirst));
+    return {std::move(first), std::move(second)};
+}
+
+LoopbackTransport::LoopbackTransport(std::shared_ptr<Link> sharedLink, int linkSide, const LinkModel& linkModel)
+    : link(std::move(sharedLink)),
+      side(linkSide),
+      model(linkModel),
+      random(linkModel.seed),
+      lossDraw(linkModel.lossRate),
+      errorGapDraw(linkModel.bitErrorRate > 0 ? linkModel.bitErrorRate : 1.0) {
+    if (model.bitErrorRate > 0) {
+        bitsUntilError = errorGapDraw(random);
+    }
+}
+
+LoopbackTransport::~LoopbackTransport() = default;
+
+void LoopbackTransport::run(Handler& handler) {
+    Link::Endpoint& self = link->endpoints[side];
+    const Channel& inbox = link->channels[1 - side];
+    const Channel& outbox = link->channels[side];
+
+    while (!stopping.load(std::memory_order_acquire)) {
+        int64_t due = deliver(handler);
+        bool full = transmit(handler);
+
+        // Announce the wait, then look again in case the peer added input
+        // or freed room before the announcement was visible. Input arriving
+        // behind a chunk that is not yet due cannot be delivered any sooner
+        self.waitingForInput.store(due == 0, std::memory_order_relaxed);
+        self.waitingForSpace.store(full, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool ready = stopping.load(std::memory_order_relaxed) || (due == 0 && !inbox.empty()) ||
+                     (full && outbox.size() < CHUNKS);
+        if (!ready) {
+            sleep(due);
+        }
+        self.waitingForInput.store(false, std::memory_order_relaxed);
+        self.waitingForSpace.store(false, std::memory_order_relaxed);
+    }
+    stopping.store(false, std::memory_order_release);
+}
+
+int64_t LoopbackTransport::deliver(Handler& handler) {
+    Channel& inbox = link->channels[1 - side];
+    int64_t now = 0;
+    int64_t due = 0;
+    bool popped = false;
+    for (Span<const uint8_t> chunk = inbox.peek(); !chunk.empty(); chunk = inbox.peek()) {
+        int64_t deliverAt;
+        std::memcpy(&deliverAt, chunk.data(), sizeof(deliverAt));
+        if (deliverAt > now) {
+            now = clockNow();
+            if (deliverAt > now) {
+                due = deliverAt;
+                break;
+            }
+        }
+        Span<const uint8_t> bytes(chunk.data() + sizeof(deliverAt), chunk.size() - sizeof(deliverAt));
+        bytesReceived.fetch_add(bytes.size(), std::memory_order_relaxed);
+        handler.onReceived(bytes);
+        inbox.pop();
+        popped = true;
+    }
+
+    if (popped) {
+        // Pairs with the fence in the peer's run(): either it sees the room
+        // made here, or this side sees it waiting and signals it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        Link::Endpoint& peer = link->endpoints[1 - side];
+        if (peer.waitingForSpace.load(std::memory_order_relaxed) && peer.waitingForSpace.exchange(false)) {
+            peer.signal();
+        }
+    }
+    return due;
+}
+
+bool LoopbackTransport::transmit(Handler& handler) {
+    Channel& outbox = link->channels[side];
+    Span<const uint8_t> segments[MAX_WRITE_SEGMENTS];
+    bool pushed = false;
+    bool full = false;
+
+    while (!full) {
+        size_t count = handler.pendingOutput(segments, MAX_WRITE_SEGMENTS);
+        if (count == 0) {
+            break;
+        }
+        size_t taken = 0;
+        for (size_t i = 0; i < count && !full; ++i) {
+            const uint8_t* bytes = segments[i].data();
+            size_t remaining = segments[i].size();
+            // The first segment may be the rest of a frame the link filled
+            // up on, which was already judged not lost
+            bool resuming = i == 0 && segmentPending;
+            segmentPending = false;
+            if (!resuming && model.lossRate > 0 && lossDraw(random)) {
+                framesSent.fetch_add(1, std::memory_order_relaxed);
+                framesLost.fetch_add(1, std::memory_order_relaxed);
+                taken += remaining;
+                continue;
+            }
+            while (remaining > 0) {
+                Channel::Reservation slot = outbox.tryReserve();
+                if (!slot) {
+                    // The rest of this segment is offered again once the peer catches up
+                    full = true;
+                    segmentPending = true;
+                    break;
+                }
+                size_t piece = std::min(remaining, CHUNK_BYTES);
+                int64_t deliverAt = deliveryTime();
+                std::memcpy(slot.data(), &deliverAt, sizeof(deliverAt));
+                std::memcpy(slot.data() + sizeof(deliverAt), bytes, piece);
+                corrupt(slot.data() + sizeof(deliverAt), piece);
+                outbox.commit(slot, sizeof(deliverAt) + piece);
+                bytes += piece;
+                remaining -= piece;
+                taken += piece;
+                pushed = true;
+                bytesSent.fetch_add(piece, std::memory_order_relaxed);
+            }
+            if (remaining == 0) {
+                framesSent.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if (taken > 0) {
+            handler.outputWritten(taken);
+        }
+    }
+
+    if (pushed) {
+        // Pairs with the fence in the peer's run(), as in deliver()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        Link::Endpoint& peer = link->endpoints[1 - side];
+        if (peer.waitingForInput.load(std::memory_order_relaxed) && peer.waitingForInput.exchange(false)) {
+            peer.signal();
+        }
+    }
+    return full;
+}
+
+int64_t LoopbackTransport::deliveryTime() {
+    if (model.latency.count() == 0 && model.jitter.count() == 0) {
+        return 0;
+    }
+    int64_t delay = model.latency.count();
+    if (model.jitter.count() > 0) {
+        delay += std::uniform_int_distribution<int64_t>(0, model.jitter.count())(random);
+    }
+    lastDelivery = std::max(lastDelivery, clockNow() + delay);
+    return lastDelivery;
+}
+
+void LoopbackTransport::corrupt(uint8_t* data, size_t length) {
+    if (model.bitErrorRate <= 0) {
+        return;
+    }
+    // Skip straight to each error instead of drawing once per bit
+    uint64_t bits = static_cast<uint64_t>(length) * 8;
+    uint64_t position = 0;
+    while (bitsUntilError < bits - position) {
+        position += bitsUntilError;
+        data[position / 8] ^= static_cast<uint8_t>(1u << (position % 8));
+        bitsFlipped.fetch_add(1, std::memory_order_relaxed);
+        position++;
+        bitsUntilError = errorGapDraw(random);
+    }
+    bitsUntilError -= bits - position;
+}
+
+void LoopbackTransport::sleep(int64_t deadline) {
+    Link::Endpoint& self = link->endpoints[side];
+    std::unique_lock<std::mutex> lock(self.mutex);
+    if (deadline != 0) {
+        std::chrono::steady_clock::time_point until{std::chrono::nanoseconds(deadline)};
+        self.wake.wait_until(lock, until, [&self] { return self.signalled; });
+    } else {
+        self.wake.wait(lock, [&self] { return self.signalled; });
+    }
+    self.signalled = false;
+    wakes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LoopbackTransport::notify() {
+    link->endpoints[side].signal();
+}
+
+void LoopbackTransport::stop() {
+    stopping.store(true, std::memory_order_release);
+    notify();
+}
+
+LoopbackTransport::Stats LoopbackTransport::getStats() const {
+    Stats stats;
+    stats.framesSent = framesSent.load(std::memory_order_relaxed);
+    stats.framesLost = framesLost.load(std::memory_order_relaxed);
+    stats.bitsFlipped = bitsFlipped.load(std::memory_order_relaxed);
+    stats.bytesSent = bytesSent.load(std::memory_order_relaxed);
+    stats.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+    stats.wakes = wakes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace SCALPEL
@@ -0,0 +1,122 @@
+#ifndef LOOPBACKTRANSPORT_HPP
+#define LOOPBACKTRANSPORT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <utility>
+#include "FrameRing.hpp"
+#include "Transport.hpp"
+
+namespace SCALPEL {
+
+// One end of an in-process link to a peer LoopbackTransport, so two stacks
+// can run against each other without hardware.
+//
+// Each direction is a FrameRing of chunks that one side's loop writes and
+// the other's reads, so bytes cross without locks and with one copy. The
+// sending loop applies its LinkModel to every output segment, i.e. every
+// queued frame: the frame may be lost, its bits are flipped at the bit
+// error rate, and it is stamped with the time it may be delivered. That time
+// is now plus the latency and a uniform jitter, but never before the chunk
+// ahead of it, so the link keeps its order like a serial line. Each loop
+// sleeps on its own condition variable until the oldest incoming chunk
+// falls due, and a side only signals the other after the other has
+// announced it is about to sleep. Only the standard library is used, so
+// the pair works on every platform.
+class LoopbackTransport : public Transport {
+public:
+    // Impairments applied to everything one end sends
+    struct LinkModel {
+        std::chrono::nanoseconds latency{0};
+        std::chrono::nanoseconds jitter{0}; // Extra delay, uniform in [0, jitter]
+        double lossRate = 0;                 // Chance a frame is lost outright
+        double bitErrorRate = 0;             // Chance each delivered bit is flipped
+        uint64_t seed = 1;                   // Seeds the loss, error and jitter draws
+    };
+
+    // Counts since construction, for benchmarks and diagnostics
+    struct Stats {
+        uint64_t framesSent = 0;    // Output segments taken, lost ones included
+        uint64_t framesLost = 0;
+        uint64_t bitsFlipped = 0;
+        uint64_t bytesSent = 0;     // Bytes put on the link, lost ones excluded
+        uint64_t bytesReceived = 0;
+        uint64_t wakes = 0;         // Returns from sleeping
+    };
+
+    using Pair = std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>>;
+
+    // Two connected ends: what first sends arrives at second under
+    // firstToSecond, and the reverse; a single model applies both ways and
+    // none gives a perfect link. Throws std::invalid_argument for a negative
+    // delay or a rate outside [0, 1]
+    static Pair createPair();
+    static Pair createPair(const LinkModel& bothWays);
+    static Pair createPair(const LinkModel& firstToSecond, const LinkModel& secondToFirst);
+
+    ~LoopbackTransport() override;
+
+    LoopbackTransport(const LoopbackTransport&) = delete;
+    LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+
+    void run(Handler& handler) override;
+    void notify() override;
+    void stop() override;
+
+    // Safe to call while the loop runs
+    Stats getStats() const;
+
+private:
+    static constexpr size_t CHUNK_BYTES = 256; // Longer segments are split
+    static constexpr size_t CHUNKS = 512;
+    static constexpr size_t MAX_WRITE_SEGMENTS = 64;
+
+    // Each chunk is its delivery time in steady_clock nanoseconds, or 0 for
+    // at once, followed by the bytes
+    using Channel = FrameRing<sizeof(int64_t) + CHUNK_BYTES, CHUNKS>;
+    struct Link;
+
+    LoopbackTransport(std::shared_ptr<Link> link, int side, const LinkModel& model);
+
+    // Hand every due incoming chunk to the handler. Returns when the next
+    // one falls due, or 0 if none is waiting
+    int64_t deliver(Handler& handler);
+
+    // Move pending output onto the link; true if it filled first
+    bool transmit(Handler& handler);
+
+    // Delivery time for a chunk sent now
+    int64_t deliveryTime();
+
+    // Flip bits of data at the bit error rate
+    void corrupt(uint8_t* data, size_t length);
+
+    // Wait for a signal, or until deadline unless it is 0
+    void sleep(int64_t deadline);
+
+    std::shared_ptr<Link> link;
+    int side;
+    LinkModel model;
+    std::mt19937_64 random;
+    std::bernoulli_distribution lossDraw;
+    std::geometric_distribution<uint64_t> errorGapDraw;
+    uint64_t bitsUntilError = 0;  // Clean bits before the next flipped one
+    bool segmentPending = false;  // The link filled partway through a segment
+    int64_t lastDelivery = 0;
+    std::atomic<bool> stopping{false};
+
+    std::atomic<uint64_t> framesSent{0};
+    std::atomic<uint64_t> framesLost{0};
+    std::atomic<uint64_t> bitsFlipped{0};
+    std::atomic<uint64_t> bytesSent{0};
+    std::atomic<uint64_t> bytesReceived{0};
+    std::atomic<uint64_t> wakes{0};
+};
+
+} // namespace SCALPEL
+
+#endif // LOOPBACKTRANSPORT_HPP
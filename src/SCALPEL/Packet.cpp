@@ -1,120 +1,160 @@
 #include "Packet.hpp"
+#include "ChecksumTables.hpp"
+#include "HeaderCode.hpp"
+#include "PacketView.hpp"
+#include "ReedSolomon.hpp"
+#include <algorithm>
 
 namespace SCALPEL {
 
-Packet::Packet() : payloadLength(0), payloadLengthChecksum(0), cobsIndex(0), cobsChecksum(0), checksum(0) {}
+Packet::Packet() : payloadLength(0), payloadLengthChecksum(0), cobsIndex(0), cobsChecksum(0), payload{}, checksum(0), format{} {}
 
-Packet::Packet(const std::vector<uint8_t>& payloadData) {
+Packet::Packet(const std::vector<uint8_t>& payloadData)
+    : Packet(Span<const uint8_t>(payloadData)) {}
+
+Packet::Packet(Span<const uint8_t> payloadData) : Packet() {
     if (payloadData.size() > MAX_PAYLOAD_LENGTH) {
         throw std::invalid_argument("Payload length exceeds maximum allowed size.");
     }
-    payload = payloadData;
-    payloadLength = static_cast<uint8_t>(payload.size());
+    std::copy(payloadData.begin(), payloadData.end(), payload.begin());
+    payloadLength = static_cast<uint8_t>(payloadData.size());
     calculateChecksums();
 }
 
-std::vector<uint8_t> Packet::assemble() const {
-    std::vector<uint8_t> packet;
-    packet.push_back(START_BYTE);
-
-    // Payload Length Byte
-    uint8_t lengthByte = (payloadLength & 0x3F) << 2 | (payloadLengthChecksum & 0x03);
-    packet.push_back(lengthByte);
-
-    // COBS Encoding
-    COBS cobs;
-    COBS::COBSResult result = cobs.encode(payload);
-    std::vector<uint8_t> encodedPayload = result.encodedPayload;
+Packet::Packet(Span<const uint8_t> payloadData, const PacketFormat& packetFormat) : Packet(payloadData) {
+    setFormat(packetFormat);
+}
 
-    // Ensure no byte equals START_BYTE after COBS
-    for (const auto& byte : encodedPayload) {
-        if (byte == START_BYTE) {
-            throw std::runtime_error("COBS encoding failed to eliminate start byte from payload.");
-        }
+void Packet::setFormat(const PacketFormat& packetFormat) {
+    if (!packetFormat.isValid()) {
+        throw std::invalid_argument("Unsupported packet format.");
     }
+    format = packetFormat;
+}
 
-    // COBS Byte
-    uint8_t index = result.index; // Use the index from COBSResult
-    uint8_t cobsChk = Checksum::calculate2BitChecksum(encodedPayload.data(), encodedPayload.size()) & 0x03;
-    uint8_t cobsByte = (index & 0x3F) << 2 | (cobsChk & 0x03);
-    packet.push_back(cobsByte);
-
-    // Payload
-    packet.insert(packet.end(), encodedPayload.begin(), encodedPayload.end());
+std::vector<uint8_t> Packet::assemble() const {
+    std::vector<uint8_t> packet(getAssembledLength());
+    assembleInto(packet.data(), packet.size());
+    return packet;
+}
 
-    // Checksum Byte (CRC-8)
-    uint8_t payloadChk = Checksum::calculateCRC8(payload.data(), payload.size());
-    packet.push_back(payloadChk);
+size_t Packet::getAssembledLength() const {
+    return assembledLength(payloadLength, format);
+}
 
-    return packet;
+size_t Packet::assembledLength(size_t payloadLength, const PacketFormat& format) {
+    // Payloads never reach a full 254-byte COBS block, so encoding adds exactly
+    // one code byte
+    return format.headerLength() + payloadLength + 1 + format.checksumLength() + format.fecParity;
 }
 
-Packet Packet::disassemble(const std::vector<uint8_t>& data) {
-    if (data.size() < 4) { // Minimum packet size
-        throw std::invalid_argument("Data size too small to be a valid packet.");
+size_t Packet::assembleInto(uint8_t* out, size_t capacity) const {
+    if (capacity < getAssembledLength()) {
+        throw std::length_error("Output buffer too small for assembled packet.");
     }
+    return encodeInto(payload.data(), payloadLength, format, out);
+}
 
-    if (data[0] != START_BYTE) {
-        throw std::invalid_argument("Invalid start byte.");
+size_t Packet::assembleBatch(Span<const Span<const uint8_t>> payloads, OutputBuffer& out, const PacketFormat& format) {
+    if (!format.isValid()) {
+        throw std::invalid_argument("Unsupported packet format.");
     }
 
-    Packet pkt;
-
-    // Payload Length Byte
-    uint8_t lengthByte = data[1];
-    pkt.payloadLength = (lengthByte >> 2) & 0x3F;
-    pkt.payloadLengthChecksum = lengthByte & 0x03;
-
-    // Verify payload length checksum
-    uint8_t expectedLengthChecksum = Checksum::calculate2BitChecksum(pkt.payloadLength);
-    if (pkt.payloadLengthChecksum != expectedLengthChecksum) {
-        throw std::runtime_error("Invalid payload length checksum.");
+    // Size the whole burst first so encoding never reallocates
+    size_t total = 0;
+    for (const Span<const uint8_t>& payload : payloads) {
+        if (payload.size() > MAX_PAYLOAD_LENGTH) {
+            throw std::invalid_argument("Payload length exceeds maximum allowed size.");
+        }
+        total += assembledLength(payload.size(), format);
     }
 
-    // COBS Byte
-    uint8_t cobsByte = data[2];
-    pkt.cobsIndex = (cobsByte >> 2) & 0x3F;
-    pkt.cobsChecksum = cobsByte & 0x03;
-
-    // Extract payload
-    size_t payloadStart = 3;
-    size_t payloadEnd = data.size() - 1; // Exclude checksum byte
-    if (payloadEnd < payloadStart) {
-        throw std::invalid_argument("Invalid payload boundaries.");
+    out.bytes.resize(total);
+    out.offsets.resize(payloads.size());
+    size_t written = 0;
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        out.offsets[i] = written;
+        written += encodeInto(payloads[i].data(), payloads[i].size(), format, out.bytes.data() + written);
     }
+    return written;
+}
+
+size_t Packet::encodeInto(const uint8_t* payload, size_t payloadLength, const PacketFormat& format, uint8_t* out) {
+    static_assert(MAX_PAYLOAD_LENGTH < 0xFE, "encodeInto assumes the payload fits in one COBS block");
 
-    std::vector<uint8_t> encodedPayload(data.begin() + payloadStart, data.begin() + payloadEnd);
+    out[0] = START_BYTE;
 
-    // Verify COBS checksum
-    uint8_t calculatedCobsChecksum = Checksum::calculate2BitChecksum(encodedPayload.data(), encodedPayload.size()) & 0x03;
-    if (pkt.cobsChecksum != calculatedCobsChecksum) {
-        throw std::runtime_error("Invalid COBS checksum.");
+    // Payload Length Byte, flagged when an options byte follows
+    uint8_t lengthField = static_cast<uint8_t>(payloadLength);
+    size_t headerLength = format.headerLength();
+    if (format.isExtended()) {
+        lengthField |= PacketFormat::EXTENDED_FLAG;
+        uint8_t options = format.optionsValue();
+        out[3] = static_cast<uint8_t>(options << 2 | ChecksumTables::TWO_BIT_TABLE[options]);
     }
 
-    // COBS Decoding
-    COBS cobs;
-    pkt.payload = cobs.decode(encodedPayload, pkt.cobsIndex);
+    // COBS encode the payload after the header, accumulating the CRC-8 of
+    // the raw payload and the 2-bit checksum of the encoded bytes as we go.
+    // Runs are at most MAX_PAYLOAD_LENGTH long, so no code byte can reach
+    // START_BYTE or the 0xFF block limit.
+    size_t codePtr = headerLength;
+    size_t written = headerLength + 1;
+    uint8_t code = 1;
+    uint8_t index = 0;
+    uint8_t crc = 0x00;
+    unsigned bits = 0;
+
+    for (size_t i = 0; i < payloadLength; ++i) {
+        uint8_t byte = payload[i];
+        crc = ChecksumTables::crc8Update(crc, byte);
+        if (byte == START_BYTE) {
+            out[codePtr] = code;
+            bits += ChecksumTables::TWO_BIT_TABLE[code];
+            code = 1;
+            codePtr = written++;
+            index++;
+        } else {
+            out[written++] = byte;
+            bits += ChecksumTables::TWO_BIT_TABLE[byte];
+            code++;
+        }
+    }
+    out[codePtr] = code;
+    bits += ChecksumTables::TWO_BIT_TABLE[code];
+
+    // Payload Length and COBS Bytes
+    if (format.headerProtection == PacketFormat::HeaderProtection::Secded) {
+        HeaderCode::encode(lengthField, index, out + 1);
+    } else {
+        out[1] = static_cast<uint8_t>((lengthField & 0x3F) << 2 | ChecksumTables::TWO_BIT_TABLE[lengthField]);
+        out[2] = static_cast<uint8_t>((index & 0x3F) << 2 | (bits & 0x03));
+    }
 
-    if (pkt.payload.size() != pkt.payloadLength) {
-        throw std::runtime_error("Payload length mismatch after decoding.");
+    // Checksum: the CRC-8 accumulated above, or a wider CRC over the raw
+    // payload in one pass
+    if (format.integrity == PacketFormat::Integrity::Crc8) {
+        out[written++] = crc;
+    } else {
+        format.writeChecksum(Checksum::calculate(format.integrity, payload, payloadLength), out + written);
+        written += format.checksumLength();
     }
 
-    // Verify payload checksum (CRC-8)
-    pkt.checksum = data.back();
-    uint8_t calculatedPayloadChecksum = Checksum::calculateCRC8(pkt.payload.data(), pkt.payload.size());
-    if (pkt.checksum != calculatedPayloadChecksum) {
-        throw std::runtime_error("Invalid payload checksum.");
+    // Reed-Solomon parity over everything after START_BYTE
+    if (format.fecParity != 0) {
+        ReedSolomon::get(format.fecParity).encode(out + 1, written - 1, out + written);
+        written += format.fecParity;
     }
 
-    return pkt;
+    return written;
 }
 
-uint8_t Packet::getPayloadLength() const {
-    return payloadLength;
+Packet Packet::disassemble(const std::vector<uint8_t>& data, PacketFormat::HeaderProtection protection) {
+    // Validates the header, COBS structure and CRC in place before decoding
+    return PacketView::from(data.data(), data.size(), protection).toPacket();
 }
 
-const std::vector<uint8_t>& Packet::getPayload() const {
-    return payload;
+uint8_t Packet::getPayloadLength() const {
+    return payloadLength;
 }
 
 void Packet::calculateChecksums() {
@@ -1,11 +1,14 @@
 #ifndef PACKET_HPP
 #define PACKET_HPP
 
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <stdexcept>
+#include <type_traits>
 #include "COBS.hpp"
 #include "Checksum.hpp"
+#include "PacketFormat.hpp"
 
 namespace SCALPEL {
 
@@ -13,35 +16,97 @@ class Packet {
 public:
     static constexpr uint8_t START_BYTE = 170;
     static constexpr uint8_t MAX_PAYLOAD_LENGTH = 28;
+    // Longest packet in any format: START, length, COBS and options bytes,
+    // the encoded payload, the widest CRC and the Reed-Solomon parity
+    static constexpr size_t MAX_PACKET_LENGTH = 4 + COBS::maxEncodedLength(MAX_PAYLOAD_LENGTH) +
+                                                PacketFormat::MAX_CHECKSUM_LENGTH + PacketFormat::MAX_FEC_PARITY;
+
+    // Destination of assembleBatch: assembled packets back to back, ready for
+    // a single write, and the offset at which each one starts. Reusing one
+    // buffer across batches avoids allocating once it has grown.
+    struct OutputBuffer {
+        std::vector<uint8_t> bytes;
+        std::vector<size_t> offsets;
+
+        size_t packetCount() const { return offsets.size(); }
+
+        // Assembled bytes of the i-th packet of the last batch
+        Span<const uint8_t> packet(size_t i) const {
+            size_t end = i + 1 < offsets.size() ? offsets[i + 1] : bytes.size();
+            return Span<const uint8_t>(bytes.data() + offsets[i], end - offsets[i]);
+        }
+
+        void clear() {
+            bytes.clear();
+            offsets.clear();
+        }
+    };
 
     Packet();
     Packet(const std::vector<uint8_t>& payload);
+    explicit Packet(Span<const uint8_t> payload);
+    Packet(Span<const uint8_t> payload, const PacketFormat& format);
 
     // Assemble the packet into a byte array
     std::vector<uint8_t> assemble() const;
 
-    // Disassemble the packet from a byte array
-    static Packet disassemble(const std::vector<uint8_t>& data);
+    // Assemble the packet into a caller-provided buffer in a single pass that
+    // COBS-encodes the payload while accumulating both checksums
+    // Returns the number of bytes written; throws std::length_error if
+    // capacity is smaller than getAssembledLength()
+    size_t assembleInto(uint8_t* out, size_t capacity) const;
+
+    // Number of bytes assemble() produces for this packet
+    size_t getAssembledLength() const;
+
+    // Assemble a burst of payloads, all in one format, back to back into out,
+    // replacing its contents. The output is sized once up front and each
+    // payload is encoded straight into place, skipping the per-packet Packet
+    // and vector construction of assemble().
+    // Returns the total length; throws std::invalid_argument, leaving out
+    // untouched, if a payload is too long or the format is invalid
+    static size_t assembleBatch(Span<const Span<const uint8_t>> payloads, OutputBuffer& out,
+                                const PacketFormat& format = PacketFormat{});
+
+    // Disassemble the packet from a byte array, read with the link's header
+    // protection
+    static Packet disassemble(const std::vector<uint8_t>& data,
+                              PacketFormat::HeaderProtection protection = PacketFormat::HeaderProtection::Checksum);
+
+    // Wire format used by assemble; throws std::invalid_argument if invalid
+    void setFormat(const PacketFormat& format);
+    const PacketFormat& getFormat() const { return format; }
 
     // Getters
     uint8_t getPayloadLength() const;
-    const std::vector<uint8_t>& getPayload() const;
+    Span<const uint8_t> getPayload() const { return Span<const uint8_t>(payload.data(), payloadLength); }
 
-    // New method to get payload as vector
-    std::vector<uint8_t> getPayloadVector() const { return payload; }
+    // Copy of the payload as a vector
+    std::vector<uint8_t> getPayloadVector() const {
+        return std::vector<uint8_t>(payload.begin(), payload.begin() + payloadLength);
+    }
 
 private:
+    friend class PacketView;
+
     uint8_t payloadLength;
     uint8_t payloadLengthChecksum;
     uint8_t cobsIndex;
     uint8_t cobsChecksum;
-    std::vector<uint8_t> payload;
-    uint8_t checksum;
+    std::array<uint8_t, MAX_PAYLOAD_LENGTH> payload; // First payloadLength bytes are valid
+    uint32_t checksum; // Payload check in the format's integrity mode
+    PacketFormat format;
+
+    static size_t assembledLength(size_t payloadLength, const PacketFormat& format);
+    static size_t encodeInto(const uint8_t* payload, size_t payloadLength, const PacketFormat& format, uint8_t* out);
 
     void calculateChecksums();
     void validate() const;
 };
 
+// Packets are copied by value through the radio queues; keep them a flat block
+static_assert(std::is_trivially_copyable<Packet>::value, "Packet must stay trivially copyable");
+
 } // namespace SCALPEL
 
 #endif // PACKET_HPP
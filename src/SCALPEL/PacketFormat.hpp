@@ -0,0 +1,119 @@
+#ifndef PACKETFORMAT_HPP
+#define PACKETFORMAT_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace SCALPEL {
+
+// Optional wire features of a SCALPEL packet, configured per link.
+//
+// The default format is the original wire format. Any other format sets
+// bit 5 of the 6-bit length field (payloads never exceed 28 bytes, so
+// legacy receivers reject such packets) and inserts an options byte after
+// the COBS byte. Its top six bits describe the format and its low two bits
+// are their 2-bit checksum:
+//
+//   START | LEN | COBS | OPTIONS | encoded payload | CRC | RS parity
+//
+// The CRC covers the raw payload and is one, two or four bytes wide
+// depending on the integrity mode (big-endian when wider than a byte).
+// Reed-Solomon parity, when enabled, covers every byte after START.
+//
+// Since the options byte names the integrity mode, a receiver accepts
+// whichever mode each packet arrives in: either end of a link can move to a
+// wider CRC without reconfiguring the other.
+//
+// Header protection is not signalled on the wire, since the receiver needs
+// it to read the length byte; both ends of a link must agree on it.
+struct PacketFormat {
+    // How the length and COBS bytes are protected
+    enum class HeaderProtection : uint8_t {
+        Checksum, // Six-bit fields, each with a 2-bit checksum (original)
+        Secded,   // Extended Hamming (16,11) over both bytes; see HeaderCode
+    };
+
+    // Payload check after the encoded payload, carried in bits 4..5 of the
+    // options value
+    enum class Integrity : uint8_t {
+        Crc8 = 0,   // CRC-8, polynomial 0x07 (original)
+        Crc16 = 1,  // CRC-16/CCITT-FALSE
+        Crc32c = 2, // CRC-32C (Castagnoli)
+    };
+
+    // Bit 5 of the length field marks an extended header
+    static constexpr uint8_t EXTENDED_FLAG = 0x20;
+
+    // Parity is carried in the options byte as fecParity / 2 in four bits
+    static constexpr uint8_t MAX_FEC_PARITY = 30;
+
+    // Widest payload check, that of Crc32c
+    static constexpr size_t MAX_CHECKSUM_LENGTH = 4;
+
+    // Reed-Solomon parity bytes per packet (even, up to MAX_FEC_PARITY);
+    // corrects up to fecParity / 2 byte errors
+    uint8_t fecParity = 0;
+
+    HeaderProtection headerProtection = HeaderProtection::Checksum;
+
+    Integrity integrity = Integrity::Crc8;
+
+    bool isExtended() const { return fecParity != 0 || integrity != Integrity::Crc8; }
+
+    size_t headerLength() const { return isExtended() ? 4 : 3; }
+
+    // Bytes of the payload check
+    size_t checksumLength() const {
+        switch (integrity) {
+            case Integrity::Crc16: return 2;
+            case Integrity::Crc32c: return 4;
+            default: return 1;
+        }
+    }
+
+    // Store a payload check in checksumLength() big-endian bytes
+    void writeChecksum(uint32_t value, uint8_t* out) const {
+        for (size_t i = checksumLength(); i-- != 0; value >>= 8) {
+            out[i] = static_cast<uint8_t>(value);
+        }
+    }
+
+    // Load a payload check stored by writeChecksum
+    uint32_t readChecksum(const uint8_t* in) const {
+        uint32_t value = 0;
+        for (size_t i = 0; i < checksumLength(); ++i) {
+            value = value << 8 | in[i];
+        }
+        return value;
+    }
+
+    // Six-bit value carried in the options byte
+    uint8_t optionsValue() const {
+        return static_cast<uint8_t>(fecParity / 2 | static_cast<uint8_t>(integrity) << 4);
+    }
+
+    // Decode the options byte value; false if it names unsupported features
+    static bool fromOptionsValue(uint8_t value, PacketFormat& format) {
+        uint8_t integrity = (value >> 4) & 0x03;
+        if (integrity > static_cast<uint8_t>(Integrity::Crc32c)) { // Reserved
+            return false;
+        }
+        format.fecParity = static_cast<uint8_t>((value & 0x0F) * 2);
+        format.integrity = static_cast<Integrity>(integrity);
+        return true;
+    }
+
+    bool isValid() const {
+        return fecParity % 2 == 0 && fecParity <= MAX_FEC_PARITY && integrity <= Integrity::Crc32c;
+    }
+
+    bool operator==(const PacketFormat& other) const {
+        return fecParity == other.fecParity && headerProtection == other.headerProtection &&
+               integrity == other.integrity;
+    }
+    bool operator!=(const PacketFormat& other) const { return !(*this == other); }
+};
+
+} // namespace SCALPEL
+
+#endif // PACKETFORMAT_HPP
@@ -0,0 +1,215 @@
+#include "PacketView.hpp"
+#include "ChecksumTables.hpp"
+#include "HeaderCode.hpp"
+#include "ReedSolomon.hpp"
+
+namespace SCALPEL {
+
+namespace {
+
+// Payload check in a packet's integrity mode, fed the decoded payload in
+// pieces as the COBS blocks are walked
+class PayloadCheck {
+public:
+    explicit PayloadCheck(PacketFormat::Integrity integrity) : integrity(integrity) {
+        switch (integrity) {
+            case PacketFormat::Integrity::Crc16: crc = ChecksumTables::CRC16_INITIAL; break;
+            case PacketFormat::Integrity::Crc32c: crc = ChecksumTables::CRC32C_INITIAL; break;
+            default: crc = 0x00; break;
+        }
+    }
+
+    void update(const uint8_t* data, size_t length) {
+        switch (integrity) {
+            case PacketFormat::Integrity::Crc16:
+                crc = Checksum::updateCRC16(static_cast<uint16_t>(crc), data, length);
+                break;
+            case PacketFormat::Integrity::Crc32c:
+                crc = Checksum::updateCRC32C(crc, data, length);
+                break;
+            default: {
+                uint8_t crc8 = static_cast<uint8_t>(crc);
+                for (size_t i = 0; i < length; ++i) {
+                    crc8 = ChecksumTables::crc8Update(crc8, data[i]);
+                }
+                crc = crc8;
+                break;
+            }
+        }
+    }
+
+    uint32_t value() const { return integrity == PacketFormat::Integrity::Crc32c ? ~crc : crc; }
+
+private:
+    PacketFormat::Integrity integrity;
+    uint32_t crc;
+};
+
+} // namespace
+
+PacketView::Status PacketView::parse(const uint8_t* data, size_t size, PacketView& view,
+                                     PacketFormat::HeaderProtection protection) noexcept {
+    if (size < 4) { // Minimum packet size
+        return Status::TooShort;
+    }
+
+    if (data[0] != Packet::START_BYTE) {
+        return Status::BadStartByte;
+    }
+
+    // Payload Length and COBS Bytes; bit 5 of the length field flags an
+    // extended header
+    uint8_t lengthField;
+    uint8_t cobsIndex;
+    if (!HeaderCode::readHeader(data, protection, lengthField, cobsIndex)) {
+        return Status::BadLengthChecksum;
+    }
+    uint8_t payloadLength = lengthField & ~PacketFormat::EXTENDED_FLAG;
+
+    // Options Byte
+    PacketFormat format;
+    format.headerProtection = protection;
+    if (lengthField & PacketFormat::EXTENDED_FLAG) {
+        if (size < 5) {
+            return Status::TooShort;
+        }
+        uint8_t options = (data[3] >> 2) & 0x3F;
+        if ((data[3] & 0x03) != Checksum::calculate2BitChecksum(options) ||
+            !PacketFormat::fromOptionsValue(options, format) || !format.isExtended()) {
+            return Status::BadOptions;
+        }
+    }
+    size_t headerLength = format.headerLength();
+    if (size < headerLength + format.checksumLength() + format.fecParity) {
+        return Status::TooShort;
+    }
+    size_t checksumPosition = size - format.checksumLength() - format.fecParity;
+
+    // COBS checksum, which the SECDED header has no room for; the CRC
+    // still covers the payload
+    const uint8_t* encoded = data + headerLength;
+    size_t encodedLength = checksumPosition - headerLength; // Exclude header, checksum and parity
+    if (protection == PacketFormat::HeaderProtection::Checksum &&
+        (data[2] & 0x03) != Checksum::calculate2BitChecksum(encoded, encodedLength)) {
+        return Status::BadCobsChecksum;
+    }
+
+    // A valid payload never encodes to more than this
+    if (encodedLength > COBS::maxEncodedLength(Packet::MAX_PAYLOAD_LENGTH)) {
+        return Status::LengthMismatch;
+    }
+
+    // Walk the COBS blocks as COBS::decodeInto would, feeding the decoded
+    // byte sequence into the CRC instead of writing it out
+    const uint8_t startByte = Packet::START_BYTE;
+    size_t decodedLength = 0;
+    uint8_t restored = 0;
+    PayloadCheck crc(format.integrity);
+    size_t i = 0;
+    while (i < encodedLength) {
+        uint8_t code = encoded[i++];
+        if (code == 0) {
+            return Status::BadCobsEncoding;
+        }
+        size_t run = code - 1u;
+        if (encodedLength - i < run) {
+            return Status::BadCobsEncoding;
+        }
+        crc.update(encoded + i, run);
+        i += run;
+        decodedLength += run;
+
+        if (code < 0xFF && i < encodedLength) {
+            if (restored == cobsIndex) {
+                return Status::BadCobsIndex;
+            }
+            crc.update(&startByte, 1);
+            decodedLength++;
+            restored++;
+        }
+    }
+    if (restored != cobsIndex) {
+        return Status::BadCobsIndex;
+    }
+
+    if (decodedLength != payloadLength) {
+        return Status::LengthMismatch;
+    }
+
+    // Verify payload checksum
+    uint32_t checksum = format.readChecksum(data + checksumPosition);
+    if (crc.value() != checksum) {
+        return Status::BadPayloadChecksum;
+    }
+
+    view.data = data;
+    view.size = size;
+    view.format = format;
+    view.payloadLength = payloadLength;
+    view.cobsIndex = cobsIndex;
+    view.checksum = checksum;
+    return Status::Ok;
+}
+
+int PacketView::correct(uint8_t* data, size_t size, const PacketFormat& format) {
+    if (format.fecParity == 0) {
+        return 0;
+    }
+    if (size < format.headerLength() + 1 + format.checksumLength() + format.fecParity) {
+        return -1;
+    }
+    // The codeword is everything after START_BYTE
+    return ReedSolomon::get(format.fecParity).decode(data + 1, size - 1);
+}
+
+PacketView PacketView::from(const uint8_t* data, size_t size, PacketFormat::HeaderProtection protection) {
+    PacketView view;
+    Status status = parse(data, size, view, protection);
+    switch (status) {
+        case Status::Ok:
+            return view;
+        case Status::TooShort:
+        case Status::BadStartByte:
+            throw std::invalid_argument(statusMessage(status));
+        default:
+            throw std::runtime_error(statusMessage(status));
+    }
+}
+
+const char* PacketView::statusMessage(Status status) noexcept {
+    switch (status) {
+        case Status::Ok: return "Packet is valid.";
+        case Status::TooShort: return "Data size too small to be a valid packet.";
+        case Status::BadStartByte: return "Invalid start byte.";
+        case Status::BadLengthChecksum: return "Invalid payload length checksum.";
+        case Status::BadOptions: return "Invalid or unsupported options byte.";
+        case Status::BadCobsChecksum: return "Invalid COBS checksum.";
+        case Status::BadCobsEncoding: return "Invalid COBS encoding.";
+        case Status::BadCobsIndex: return "COBS decode: index mismatch.";
+        case Status::LengthMismatch: return "Payload length mismatch after decoding.";
+        case Status::BadPayloadChecksum: return "Invalid payload checksum.";
+    }
+    return "Unknown packet status.";
+}
+
+size_t PacketView::decodePayload(Span<uint8_t> output) const {
+    if (output.size() < payloadLength) {
+        throw std::length_error("Output buffer too small for decoded payload.");
+    }
+    COBS cobs;
+    return cobs.decodeInto(encodedPayload(), cobsIndex, output);
+}
+
+Packet PacketView::toPacket() const {
+    Packet pkt;
+    pkt.payloadLength = payloadLength;
+    pkt.payloadLengthChecksum = Checksum::calculate2BitChecksum(payloadLength);
+    pkt.cobsIndex = cobsIndex;
+    pkt.cobsChecksum = format.headerProtection == PacketFormat::HeaderProtection::Checksum ? data[2] & 0x03 : 0;
+    pkt.checksum = checksum;
+    pkt.format = format;
+    decodePayload(pkt.payload);
+    return pkt;
+}
+
+} // namespace SCALPEL
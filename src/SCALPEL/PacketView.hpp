@@ -0,0 +1,94 @@
+#ifndef PACKETVIEW_HPP
+#define PACKETVIEW_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include "Packet.hpp"
+#include "Span.hpp"
+
+namespace SCALPEL {
+
+// Non-owning view over an assembled packet in a receive buffer. parse()
+// validates the header, the COBS structure and the CRC in place, without
+// decoding into memory; the payload is only materialised on request, either
+// into a caller-supplied buffer or as a Packet.
+class PacketView {
+public:
+    // Outcome of parse(); everything but Ok rejects the packet
+    enum class Status : uint8_t {
+        Ok,
+        TooShort,            // Shorter than the header, CRC and parity
+        BadStartByte,        // First byte is not START_BYTE
+        BadLengthChecksum,   // 2-bit checksum of the length field
+        BadOptions,          // Options byte checksum or unsupported format
+        BadCobsChecksum,     // 2-bit checksum of the encoded payload
+        BadCobsEncoding,     // Zero code byte or a block running past the end
+        BadCobsIndex,        // Restored START_BYTE count differs from the index
+        LengthMismatch,      // Decoded length differs from the length field
+        BadPayloadChecksum,  // CRC of the decoded payload
+    };
+
+    PacketView() = default;
+
+    // Validate the packet occupying data[0, size) and point view at it.
+    // view is only updated when Ok is returned. With Secded header
+    // protection a single flipped header bit is corrected in the decoded
+    // fields (data itself is not modified); an uncorrectable header is a
+    // BadLengthChecksum
+    static Status parse(const uint8_t* data, size_t size, PacketView& view,
+                        PacketFormat::HeaderProtection protection = PacketFormat::HeaderProtection::Checksum) noexcept;
+    static Status parse(Span<const uint8_t> data, PacketView& view,
+                        PacketFormat::HeaderProtection protection = PacketFormat::HeaderProtection::Checksum) noexcept {
+        return parse(data.data(), data.size(), view, protection);
+    }
+
+    // Like parse() but throws the exceptions Packet::disassemble documents:
+    // std::invalid_argument for framing errors, std::runtime_error otherwise
+    static PacketView from(const uint8_t* data, size_t size,
+                           PacketFormat::HeaderProtection protection = PacketFormat::HeaderProtection::Checksum);
+    static PacketView from(Span<const uint8_t> data,
+                           PacketFormat::HeaderProtection protection = PacketFormat::HeaderProtection::Checksum) {
+        return from(data.data(), data.size(), protection);
+    }
+
+    // Repair an extended packet in data[0, size) in place using its
+    // Reed-Solomon parity before parsing it. Returns the number of corrected
+    // bytes (0 when format carries no parity) or -1 if uncorrectable, in
+    // which case data is left untouched
+    static int correct(uint8_t* data, size_t size, const PacketFormat& format);
+
+    // Human readable description of a status
+    static const char* statusMessage(Status status) noexcept;
+
+    uint8_t getPayloadLength() const { return payloadLength; }
+    uint8_t getCobsIndex() const { return cobsIndex; }
+    uint32_t getChecksum() const { return checksum; }
+    const PacketFormat& getFormat() const { return format; }
+
+    // The whole packet and the COBS-encoded payload within it
+    Span<const uint8_t> bytes() const { return Span<const uint8_t>(data, size); }
+    Span<const uint8_t> encodedPayload() const {
+        size_t headerLength = format.headerLength();
+        return Span<const uint8_t>(data + headerLength,
+                                   size - headerLength - format.checksumLength() - format.fecParity);
+    }
+
+    // Decode the payload into output, returning getPayloadLength().
+    // Throws std::length_error if output is too small
+    size_t decodePayload(Span<uint8_t> output) const;
+
+    // Decode into an owning Packet
+    Packet toPacket() const;
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    PacketFormat format;
+    uint8_t payloadLength = 0;
+    uint8_t cobsIndex = 0;
+    uint32_t checksum = 0;
+};
+
+} // namespace SCALPEL
+
+#endif // PACKETVIEW_HPP
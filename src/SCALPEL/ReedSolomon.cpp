@@ -0,0 +1,306 @@
+#include "ReedSolomon.hpp"
+#include "Utils/CpuFeatures.hpp"
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(NOVALINK_X86)
+#include <immintrin.h>
+#endif
+
+namespace SCALPEL {
+
+namespace {
+
+constexpr uint16_t GF_POLYNOMIAL = 0x11D; // x^8 + x^4 + x^3 + x^2 + 1
+
+struct GaloisTables {
+    // exp is doubled so exp[log a + log b] needs no reduction modulo 255
+    std::array<uint8_t, 512> exp{};
+    std::array<uint8_t, 256> log{};
+};
+
+constexpr GaloisTables makeGaloisTables() {
+    GaloisTables tables{};
+    uint16_t value = 1;
+    for (size_t i = 0; i < 255; ++i) {
+        tables.exp[i] = static_cast<uint8_t>(value);
+        tables.log[value] = static_cast<uint8_t>(i);
+        value = static_cast<uint16_t>(value << 1);
+        if (value & 0x100) {
+            value ^= GF_POLYNOMIAL;
+        }
+    }
+    for (size_t i = 255; i < tables.exp.size(); ++i) {
+        tables.exp[i] = tables.exp[i - 255];
+    }
+    return tables;
+}
+
+constexpr GaloisTables GF = makeGaloisTables();
+
+static_assert(GF.exp[8] == 0x1D, "GF(256) table generation is broken");
+
+inline uint8_t gfMul(uint8_t a, uint8_t b) {
+    if (a == 0 || b == 0) {
+        return 0;
+    }
+    return GF.exp[GF.log[a] + GF.log[b]];
+}
+
+inline uint8_t gfDiv(uint8_t a, uint8_t b) {
+    if (a == 0) {
+        return 0;
+    }
+    return GF.exp[GF.log[a] + 255 - GF.log[b]];
+}
+
+// alpha^power for any non-negative power
+inline uint8_t gfPow(size_t power) {
+    return GF.exp[power % 255];
+}
+
+// Evaluate a polynomial stored lowest degree first at x
+uint8_t evaluateLowFirst(const uint8_t* poly, size_t terms, uint8_t x) {
+    uint8_t result = 0;
+    for (size_t i = terms; i-- > 0;) {
+        result = static_cast<uint8_t>(gfMul(result, x) ^ poly[i]);
+    }
+    return result;
+}
+
+#if defined(NOVALINK_X86)
+
+// Lane m of a 16-byte accumulator runs Horner's rule over bytes m, m + 16,
+// m + 32, ... of the codeword, so every lane multiplies by the same constant
+// alpha^(16 j) per block: one pair of pshufb nibble lookups. The codeword is
+// front-padded with zeros to whole blocks, which leaves its value unchanged.
+NOVALINK_TARGET("ssse3")
+uint8_t syndromeSSSE3(const uint8_t* codeword, size_t length,
+                      const std::array<uint8_t, 32>& step, const std::array<uint8_t, 16>& weight) {
+    const __m128i lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(step.data()));
+    const __m128i highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(step.data() + 16));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    size_t pad = (16 - length % 16) % 16;
+    alignas(16) uint8_t first[16] = {};
+    size_t firstBytes = 16 - pad;
+    for (size_t i = 0; i < firstBytes && i < length; ++i) {
+        first[pad + i] = codeword[i];
+    }
+    __m128i acc = _mm_load_si128(reinterpret_cast<const __m128i*>(first));
+
+    for (size_t offset = firstBytes; offset < length; offset += 16) {
+        __m128i low = _mm_shuffle_epi8(lowTable, _mm_and_si128(acc, nibble));
+        __m128i high = _mm_shuffle_epi8(highTable, _mm_and_si128(_mm_srli_epi16(acc, 4), nibble));
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codeword + offset));
+        acc = _mm_xor_si128(_mm_xor_si128(low, high), block);
+    }
+
+    alignas(16) uint8_t lanes[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    uint8_t syndrome = 0;
+    for (size_t m = 0; m < 16; ++m) {
+        syndrome ^= gfMul(lanes[m], weight[m]);
+    }
+    return syndrome;
+}
+
+#endif // NOVALINK_X86
+
+} // namespace
+
+ReedSolomon::ReedSolomon(uint8_t parityBytes) : parity(parityBytes) {
+    if (parityBytes == 0 || parityBytes > MAX_PARITY) {
+        throw std::invalid_argument("Reed-Solomon parity must be between 1 and 32 bytes.");
+    }
+
+    // g(x) = (x - alpha^0)(x - alpha^1)...(x - alpha^(parity - 1))
+    generator[0] = 1;
+    for (size_t root = 0; root < parity; ++root) {
+        uint8_t alpha = gfPow(root);
+        for (size_t i = root + 1; i > 0; --i) {
+            generator[i] = static_cast<uint8_t>(generator[i] ^ gfMul(generator[i - 1], alpha));
+        }
+    }
+
+    for (size_t j = 0; j < parity; ++j) {
+        uint8_t multiplier = gfPow(16 * j);
+        for (uint8_t x = 0; x < 16; ++x) {
+            blockStep[j][x] = gfMul(multiplier, x);
+            blockStep[j][16 + x] = gfMul(multiplier, static_cast<uint8_t>(x << 4));
+        }
+        for (size_t m = 0; m < 16; ++m) {
+            laneWeight[j][m] = gfPow(j * (15 - m));
+        }
+    }
+}
+
+const ReedSolomon& ReedSolomon::get(uint8_t parityBytes) {
+    if (parityBytes == 0 || parityBytes > MAX_PARITY) {
+        throw std::invalid_argument("Reed-Solomon parity must be between 1 and 32 bytes.");
+    }
+    static std::array<std::unique_ptr<ReedSolomon>, MAX_PARITY + 1> codecs;
+    static std::once_flag once;
+    std::call_once(once, []() {
+        for (uint8_t p = 1; p <= MAX_PARITY; ++p) {
+            codecs[p] = std::make_unique<ReedSolomon>(p);
+        }
+    });
+    return *codecs[parityBytes];
+}
+
+void ReedSolomon::encode(const uint8_t* data, size_t length, uint8_t* parityOut) const {
+    if (length + parity > MAX_CODEWORD_LENGTH) {
+        throw std::length_error("Reed-Solomon codeword exceeds 255 bytes.");
+    }
+
+    // Remainder of data(x) * x^parity divided by g(x), as an LFSR
+    std::array<uint8_t, MAX_PARITY> remainder{};
+    for (size_t i = 0; i < length; ++i) {
+        uint8_t feedback = data[i] ^ remainder[0];
+        for (size_t k = 0; k + 1 < parity; ++k) {
+            remainder[k] = static_cast<uint8_t>(remainder[k + 1] ^ gfMul(feedback, generator[k + 1]));
+        }
+        remainder[parity - 1] = gfMul(feedback, generator[parity]);
+    }
+    for (size_t k = 0; k < parity; ++k) {
+        parityOut[k] = remainder[k];
+    }
+}
+
+bool ReedSolomon::computeSyndromes(const uint8_t* codeword, size_t length, uint8_t* syndromes) const {
+#if defined(NOVALINK_X86)
+    static const bool ssse3 = CpuFeatures::get().ssse3;
+    if (ssse3 && length > 16) {
+        uint8_t any = 0;
+        for (size_t j = 0; j < parity; ++j) {
+            syndromes[j] = syndromeSSSE3(codeword, length, blockStep[j], laneWeight[j]);
+            any |= syndromes[j];
+        }
+        return any != 0;
+    }
+#endif
+    return computeSyndromesScalar(codeword, length, syndromes);
+}
+
+bool ReedSolomon::computeSyndromesScalar(const uint8_t* codeword, size_t length, uint8_t* syndromes) const {
+    uint8_t any = 0;
+    for (size_t j = 0; j < parity; ++j) {
+        uint8_t root = gfPow(j);
+        uint8_t s = 0;
+        for (size_t i = 0; i < length; ++i) {
+            s = static_cast<uint8_t>(gfMul(s, root) ^ codeword[i]);
+        }
+        syndromes[j] = s;
+        any |= s;
+    }
+    return any != 0;
+}
+
+int ReedSolomon::decode(uint8_t* codeword, size_t length) const {
+    if (length <= parity || length > MAX_CODEWORD_LENGTH) {
+        return -1;
+    }
+
+    std::array<uint8_t, MAX_PARITY> syndromes{};
+    if (!computeSyndromes(codeword, length, syndromes.data())) {
+        return 0;
+    }
+
+    // Berlekamp-Massey: error locator lambda(x), lowest degree first
+    std::array<uint8_t, MAX_PARITY + 1> lambda{};
+    std::array<uint8_t, MAX_PARITY + 1> previous{};
+    lambda[0] = 1;
+    previous[0] = 1;
+    size_t errors = 0;
+    size_t shift = 1;
+    uint8_t previousDiscrepancy = 1;
+
+    for (size_t n = 0; n < parity; ++n) {
+        uint8_t discrepancy = syndromes[n];
+        for (size_t i = 1; i <= errors; ++i) {
+            discrepancy ^= gfMul(lambda[i], syndromes[n - i]);
+        }
+        if (discrepancy == 0) {
+            shift++;
+            continue;
+        }
+
+        uint8_t scale = gfDiv(discrepancy, previousDiscrepancy);
+        std::array<uint8_t, MAX_PARITY + 1> saved = lambda;
+        for (size_t i = 0; i + shift <= parity; ++i) {
+            lambda[i + shift] ^= gfMul(scale, previous[i]);
+        }
+        if (2 * errors <= n) {
+            errors = n + 1 - errors;
+            previous = saved;
+            previousDiscrepancy = discrepancy;
+            shift = 1;
+        } else {
+            shift++;
+        }
+    }
+
+    if (2 * errors > parity) {
+        return -1;
+    }
+
+    // Chien search: byte i has degree length - 1 - i, so its locator is
+    // X = alpha^(length - 1 - i) and lambda(X^-1) vanishes for error bytes
+    std::array<size_t, MAX_PARITY> positions{};
+    size_t found = 0;
+    for (size_t i = 0; i < length && found <= errors; ++i) {
+        uint8_t inverse = gfPow(255 - (length - 1 - i) % 255);
+        if (evaluateLowFirst(lambda.data(), errors + 1, inverse) == 0) {
+            if (found == errors) {
+                return -1;
+            }
+            positions[found++] = i;
+        }
+    }
+    if (found != errors) {
+        return -1;
+    }
+
+    // Error evaluator omega(x) = S(x) lambda(x) mod x^parity
+    std::array<uint8_t, MAX_PARITY> omega{};
+    for (size_t i = 0; i < parity; ++i) {
+        for (size_t k = 0; k <= errors && k <= i; ++k) {
+            omega[i] ^= gfMul(syndromes[i - k], lambda[k]);
+        }
+    }
+
+    // Forney: with first root alpha^0 the magnitude is X omega(X^-1) / lambda'(X^-1)
+    std::array<uint8_t, MAX_PARITY> magnitudes{};
+    for (size_t e = 0; e < found; ++e) {
+        uint8_t locator = gfPow(length - 1 - positions[e]);
+        uint8_t inverse = gfDiv(1, locator);
+
+        uint8_t derivative = 0;
+        for (size_t i = 1; i <= errors; i += 2) {
+            derivative ^= gfMul(lambda[i], gfPow(GF.log[inverse] * (i - 1)));
+        }
+        if (derivative == 0) {
+            return -1;
+        }
+        uint8_t numerator = gfMul(locator, evaluateLowFirst(omega.data(), parity, inverse));
+        magnitudes[e] = gfDiv(numerator, derivative);
+    }
+
+    for (size_t e = 0; e < found; ++e) {
+        codeword[positions[e]] ^= magnitudes[e];
+    }
+
+    // More errors than the code can handle may still yield a consistent
+    // locator; confirm the result is a codeword before accepting it
+    if (computeSyndromes(codeword, length, syndromes.data())) {
+        for (size_t e = 0; e < found; ++e) {
+            codeword[positions[e]] ^= magnitudes[e];
+        }
+        return -1;
+    }
+    return static_cast<int>(found);
+}
+
+} // namespace SCALPEL
@@ -0,0 +1,92 @@
+#ifndef REEDSOLOMON_HPP
+#define REEDSOLOMON_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace SCALPEL {
+
+/**
+ * @class ReedSolomon
+ * @brief Systematic Reed-Solomon codec over GF(256).
+ *
+ * Uses the field polynomial x^8 + x^4 + x^3 + x^2 + 1 (0x11D) with generator
+ * alpha = 2 and first consecutive root alpha^0. A codec with p parity bytes
+ * corrects up to p / 2 byte errors anywhere in a codeword of at most 255
+ * bytes; shorter (shortened) codewords are handled implicitly.
+ */
+class ReedSolomon {
+public:
+    static constexpr size_t MAX_CODEWORD_LENGTH = 255;
+    static constexpr uint8_t MAX_PARITY = 32;
+
+    /**
+     * @brief Builds the generator polynomial for the given number of parity bytes.
+     *
+     * @param parityBytes Parity bytes per codeword, 1 to MAX_PARITY.
+     * @throws std::invalid_argument if parityBytes is out of range.
+     */
+    explicit ReedSolomon(uint8_t parityBytes);
+
+    /**
+     * @brief Returns a shared codec for the given number of parity bytes.
+     *
+     * @param parityBytes Parity bytes per codeword, 1 to MAX_PARITY.
+     * @throws std::invalid_argument if parityBytes is out of range.
+     */
+    static const ReedSolomon& get(uint8_t parityBytes);
+
+    uint8_t getParityBytes() const { return parity; }
+
+    /**
+     * @brief Compute the parity bytes for a message.
+     *
+     * @param data Message bytes.
+     * @param length Number of message bytes.
+     * @param parityOut Receives getParityBytes() parity bytes.
+     * @throws std::length_error if length plus parity exceeds MAX_CODEWORD_LENGTH.
+     */
+    void encode(const uint8_t* data, size_t length, uint8_t* parityOut) const;
+
+    /**
+     * @brief Correct a codeword (message followed by its parity) in place.
+     *
+     * The codeword is left untouched when it cannot be corrected.
+     *
+     * @param codeword Codeword bytes.
+     * @param length Number of codeword bytes, including parity.
+     * @return Number of corrected bytes, or -1 if there are too many errors.
+     */
+    int decode(uint8_t* codeword, size_t length) const;
+
+    /**
+     * @brief Evaluate the codeword at each root of the generator polynomial.
+     *
+     * Uses SSSE3 when available, otherwise a scalar Horner loop.
+     *
+     * @param codeword Codeword bytes.
+     * @param length Number of codeword bytes.
+     * @param syndromes Receives getParityBytes() syndromes.
+     * @return True if any syndrome is nonzero, i.e. the codeword has errors.
+     */
+    bool computeSyndromes(const uint8_t* codeword, size_t length, uint8_t* syndromes) const;
+
+    /**
+     * @brief Scalar reference for computeSyndromes.
+     */
+    bool computeSyndromesScalar(const uint8_t* codeword, size_t length, uint8_t* syndromes) const;
+
+private:
+    uint8_t parity;
+    // Generator polynomial, highest degree first; generator[0] is 1
+    std::array<uint8_t, MAX_PARITY + 1> generator{};
+    // Nibble product tables for multiplying by alpha^(16 j): low then high nibble
+    std::array<std::array<uint8_t, 32>, MAX_PARITY> blockStep{};
+    // Weight alpha^(j (15 - m)) of lane m when folding the 16 lanes of syndrome j
+    std::array<std::array<uint8_t, 16>, MAX_PARITY> laneWeight{};
+};
+
+} // namespace SCALPEL
+
+#endif // REEDSOLOMON_HPP
@@ -0,0 +1,130 @@
+#include "SerialDevice.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace SCALPEL {
+
+namespace {
+
+[[noreturn]] void throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+speed_t toSpeed(unsigned baudRate) {
+    switch (baudRate) {
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default: throw std::invalid_argument("Unsupported serial baud rate.");
+    }
+}
+
+// Raw 8N1: no line editing, echo, signals, CR/LF translation or flow control
+void makeRaw(int fd, speed_t speed) {
+    termios settings;
+    if (::tcgetattr(fd, &settings) != 0) {
+        throwErrno("tcgetattr failed");
+    }
+    ::cfmakeraw(&settings);
+    settings.c_cflag |= CLOCAL | CREAD;
+    settings.c_cflag &= ~(CSTOPB | CRTSCTS);
+    settings.c_iflag &= ~(IXON | IXOFF | IXANY);
+    settings.c_cc[VMIN] = 1;
+    settings.c_cc[VTIME] = 0;
+    if (speed != B0 && (::cfsetispeed(&settings, speed) != 0 || ::cfsetospeed(&settings, speed) != 0)) {
+        throwErrno("cfsetspeed failed");
+    }
+    if (::tcsetattr(fd, TCSANOW, &settings) != 0) {
+        throwErrno("tcsetattr failed");
+    }
+}
+
+} // namespace
+
+SerialDevice::SerialDevice(int fd) : descriptor(fd) {
+    int flags = ::fcntl(fd, F_GETFL);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        // Owned from here on, so the descriptor is closed even though the
+        // constructor does not complete
+        int error = errno;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        descriptor = -1;
+        throw std::system_error(error, std::generic_category(), "fcntl failed");
+    }
+}
+
+SerialDevice::~SerialDevice() {
+    close();
+}
+
+SerialDevice::SerialDevice(SerialDevice&& other) noexcept : descriptor(other.descriptor) {
+    other.descriptor = -1;
+}
+
+SerialDevice& SerialDevice::operator=(SerialDevice&& other) noexcept {
+    if (this != &other) {
+        close();
+        descriptor = other.descriptor;
+        other.descriptor = -1;
+    }
+    return *this;
+}
+
+void SerialDevice::close() {
+    if (descriptor >= 0) {
+        ::close(descriptor);
+        descriptor = -1;
+    }
+}
+
+SerialDevice SerialDevice::open(const std::string& path, unsigned baudRate) {
+    speed_t speed = toSpeed(baudRate);
+    int fd = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        throwErrno("open failed");
+    }
+    SerialDevice device(fd);
+    makeRaw(fd, speed);
+    ::tcflush(fd, TCIOFLUSH);
+    return device;
+}
+
+std::pair<SerialDevice, SerialDevice> SerialDevice::openPtyPair() {
+    int masterFd = ::posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (masterFd < 0) {
+        throwErrno("posix_openpt failed");
+    }
+    SerialDevice master(masterFd);
+    if (::grantpt(masterFd) != 0 || ::unlockpt(masterFd) != 0) {
+        throwErrno("unlockpt failed");
+    }
+    char name[64];
+    if (::ptsname_r(masterFd, name, sizeof(name)) != 0) {
+        throwErrno("ptsname_r failed");
+    }
+    int slaveFd = ::open(name, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (slaveFd < 0) {
+        throwErrno("open failed");
+    }
+    SerialDevice slave(slaveFd);
+
+    // The slave's line discipline sits between the two ends; the master's
+    // settings are configured too so either end can be handed out
+    makeRaw(slaveFd, B0);
+    makeRaw(masterFd, B0);
+    return {std::move(master), std::move(slave)};
+}
+
+} // namespace SCALPEL
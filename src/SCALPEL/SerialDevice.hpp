@@ -0,0 +1,53 @@
+#ifndef SERIALDEVICE_HPP
+#define SERIALDEVICE_HPP
+
+#include <string>
+#include <utility>
+
+namespace SCALPEL {
+
+// Owned, non-blocking file descriptor for one end of a serial link.
+//
+// open() puts a tty into raw 8N1 mode at the requested baud rate, so bytes
+// pass through without line editing, echo or flow control. openPtyPair()
+// creates a pseudo-terminal pair configured the same way, which stands in
+// for a radio in tests and benchmarks. Any other descriptor, such as one end
+// of a pipe, can be adopted with the fd constructor.
+//
+// Move-only; the descriptor is closed on destruction.
+class SerialDevice {
+public:
+    SerialDevice() = default;
+
+    // Take ownership of fd and make it non-blocking. Throws
+    // std::system_error if fd is invalid
+    explicit SerialDevice(int fd);
+
+    ~SerialDevice();
+
+    SerialDevice(SerialDevice&& other) noexcept;
+    SerialDevice& operator=(SerialDevice&& other) noexcept;
+    SerialDevice(const SerialDevice&) = delete;
+    SerialDevice& operator=(const SerialDevice&) = delete;
+
+    // Open and configure a serial port such as /dev/ttyUSB0. Throws
+    // std::invalid_argument for an unsupported baud rate and
+    // std::system_error if the port cannot be opened or configured
+    static SerialDevice open(const std::string& path, unsigned baudRate);
+
+    // Create a connected pseudo-terminal pair in raw mode; returns
+    // {master, slave}. Throws std::system_error on failure
+    static std::pair<SerialDevice, SerialDevice> openPtyPair();
+
+    int fd() const { return descriptor; }
+    bool isOpen() const { return descriptor >= 0; }
+
+    void close();
+
+private:
+    int descriptor = -1;
+};
+
+} // namespace SCALPEL
+
+#endif // SERIALDEVICE_HPP
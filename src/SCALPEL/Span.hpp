@@ -0,0 +1,70 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace SCALPEL {
+
+/**
+ * @class Span
+ * @brief Non-owning view over contiguous elements (a C++17 stand-in for std::span).
+ *
+ * Implicitly constructible from C arrays and from any container exposing
+ * data() and size() (std::vector, std::array, Span), so existing vector-based
+ * call sites can pass their buffers straight through.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept : ptr(nullptr), count(0) {}
+    constexpr Span(T* data, size_t size) noexcept : ptr(data), count(size) {}
+
+    template <size_t N>
+    constexpr Span(T (&array)[N]) noexcept : ptr(array), count(N) {}
+
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible<
+                  decltype(std::declval<Container&>().data()), T*>::value>>
+    constexpr Span(Container& container) noexcept
+        : ptr(container.data()), count(container.size()) {}
+
+    // Read-only views may also refer to temporaries, as with std::span<const T>.
+    template <typename Container,
+              typename = std::enable_if_t<std::is_const<T>::value &&
+                                          std::is_convertible<
+                  decltype(std::declval<const Container&>().data()), T*>::value>>
+    constexpr Span(const Container& container) noexcept
+        : ptr(container.data()), count(container.size()) {}
+
+    constexpr T* data() const noexcept { return ptr; }
+    constexpr size_t size() const noexcept { return count; }
+    constexpr bool empty() const noexcept { return count == 0; }
+
+    constexpr T& operator[](size_t index) const { return ptr[index]; }
+
+    constexpr iterator begin() const noexcept { return ptr; }
+    constexpr iterator end() const noexcept { return ptr + count; }
+
+    // First n elements; n must not exceed size().
+    constexpr Span first(size_t n) const { return Span(ptr, n); }
+
+    // Elements from offset to the end; offset must not exceed size().
+    constexpr Span subspan(size_t offset) const { return Span(ptr + offset, count - offset); }
+
+    // n elements starting at offset; the range must lie within the span.
+    constexpr Span subspan(size_t offset, size_t n) const { return Span(ptr + offset, n); }
+
+private:
+    T* ptr;
+    size_t count;
+};
+
+} // namespace SCALPEL
+
+#endif // SPAN_HPP
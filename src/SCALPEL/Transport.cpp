@@ -0,0 +1,21 @@
+#include "Transport.hpp"
+#include "EpollTransport.hpp"
+#include "UringTransport.hpp"
+
+namespace SCALPEL {
+
+std::unique_ptr<Transport> createTransport(SerialDevice device) {
+    if (UringTransport::isSupported()) {
+        return std::make_unique<UringTransport>(std::move(device));
+    }
+    return std::make_unique<EpollTransport>(std::move(device));
+}
+
+std::unique_ptr<Transport> createTransport(SerialDevice input, SerialDevice output) {
+    if (UringTransport::isSupported()) {
+        return std::make_unique<UringTransport>(std::move(input), std::move(output));
+    }
+    return std::make_unique<EpollTransport>(std::move(input), std::move(output));
+}
+
+} // namespace SCALPEL
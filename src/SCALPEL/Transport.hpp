@@ -0,0 +1,66 @@
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include "SerialDevice.hpp"
+#include "Span.hpp"
+
+namespace SCALPEL {
+
+// I/O backend behind a Communicator. A transport owns the link's file
+// descriptors and an event loop that hands received bytes to its handler as
+// they arrive and writes the handler's queued output as soon as the device
+// can take it. The loop runs on a thread of the caller's choosing; notify()
+// and stop() may be called from any thread.
+class Transport {
+public:
+    // Callbacks made from the loop thread; implemented by the Communicator
+    class Handler {
+    public:
+        virtual ~Handler() = default;
+
+        // Bytes read from the device; only valid during the call
+        virtual void onReceived(Span<const uint8_t> bytes) = 0;
+
+        // Fill segments with up to maxSegments spans of queued output,
+        // oldest first. Returns the number of segments filled, 0 when
+        // nothing is queued.
+        // The segments are only valid until the next call into the handler,
+        // so a transport that writes asynchronously copies them first; the
+        // output stays queued, in order, until outputWritten consumes it
+        virtual size_t pendingOutput(Span<const uint8_t>* segments, size_t maxSegments) = 0;
+
+        // The first bytes of the pending output have been written
+        virtual void outputWritten(size_t bytes) = 0;
+
+        // notify() woke the loop; called even while the device cannot take
+        // output, before any pendingOutput call the wake leads to
+        virtual void onNotified() {}
+    };
+
+    virtual ~Transport() = default;
+
+    // Run the event loop on the calling thread until stop() is called.
+    // Throws std::system_error if the device fails
+    virtual void run(Handler& handler) = 0;
+
+    // Wake the loop to collect newly queued output
+    virtual void notify() = 0;
+
+    // Make run() return. A stop requested before run() starts makes the
+    // next run() return at once
+    virtual void stop() = 0;
+};
+
+#ifdef __linux__
+// The fastest transport this system supports for a device: a UringTransport
+// where io_uring is available, otherwise an EpollTransport
+std::unique_ptr<Transport> createTransport(SerialDevice device);
+std::unique_ptr<Transport> createTransport(SerialDevice input, SerialDevice output);
+#endif
+
+} // namespace SCALPEL
+
+#endif // TRANSPORT_HPP
@@ -0,0 +1,480 @@
+#include "UringTransport.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <system_error>
+
+// The build only compiles this file on Linux; without the io_uring UAPI
+// header the transport is left out and always reports itself unsupported
+#if __has_include(<linux/io_uring.h>)
+#define NOVALINK_HAVE_IO_URING 1
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace SCALPEL {
+
+namespace {
+
+[[noreturn]] void throwErrno(const char* what, int error = errno) {
+    throw std::system_error(error, std::generic_category(), what);
+}
+
+#ifdef NOVALINK_HAVE_IO_URING
+
+// IORING_OP_READ_MULTISHOT, Linux 6.7; newer than some installed UAPI headers,
+// so support is probed at run time instead
+constexpr uint8_t OP_READ_MULTISHOT = 49;
+constexpr uint16_t BUFFER_GROUP = 0;
+constexpr unsigned PROBE_OPS = 256;
+constexpr uint64_t CURRENT_POSITION = ~0ull;
+
+// user_data tags telling completions apart
+enum : uint64_t { WAKE_REQUEST = 1, READ_REQUEST = 2, WRITE_REQUEST = 3 };
+
+int setupRing(unsigned entries, io_uring_params& params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int enterRing(int fd, unsigned submit, unsigned wait, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, submit, wait, flags, nullptr, 0));
+}
+
+int registerRing(int fd, unsigned opcode, const void* arg, unsigned count) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+template <typename T>
+T loadAcquire(const T* value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+template <typename T>
+void storeRelease(T* value, T next) {
+    __atomic_store_n(value, next, __ATOMIC_RELEASE);
+}
+
+// io_uring waits for readiness itself; on a non-blocking file a plain read
+// or write would complete with EAGAIN instead
+void makeBlocking(int fd) {
+    int flags = ::fcntl(fd, F_GETFL);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags & ~O_NONBLOCK) < 0) {
+        throwErrno("fcntl failed");
+    }
+}
+
+#endif
+
+} // namespace
+
+#ifdef NOVALINK_HAVE_IO_URING
+
+// Kernel-shared state: the mapped submission and completion queues and the
+// registered memory, laid out as the provided buffer ring (page aligned),
+// the send buffer and then the read buffers
+struct UringTransport::Ring {
+    int fd = -1;
+    void* queueMemory = MAP_FAILED;
+    size_t queueSize = 0;
+    void* completionMemory = MAP_FAILED; // Only without IORING_FEAT_SINGLE_MMAP
+    size_t completionSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned sqLocalTail = 0;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    void* bufferMemory = MAP_FAILED;
+    size_t bufferSize = 0;
+    io_uring_buf_ring* bufferRing = nullptr;
+    uint8_t* sendBuffer = nullptr;
+    uint8_t* readBuffers = nullptr;
+    uint16_t bufferTail = 0;
+
+    ~Ring() {
+        // Closing the ring cancels its requests before their memory goes
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        if (sqes != MAP_FAILED) {
+            ::munmap(sqes, sqesSize);
+        }
+        if (completionMemory != MAP_FAILED) {
+            ::munmap(completionMemory, completionSize);
+        }
+        if (queueMemory != MAP_FAILED) {
+            ::munmap(queueMemory, queueSize);
+        }
+        if (bufferMemory != MAP_FAILED) {
+            ::munmap(bufferMemory, bufferSize);
+        }
+    }
+
+    // Next free submission entry, cleared; published by submit()
+    io_uring_sqe* nextSqe() {
+        if (sqLocalTail - loadAcquire(sqHead) == sqEntries) {
+            throw std::system_error(EBUSY, std::generic_category(), "io_uring submission queue full");
+        }
+        unsigned index = sqLocalTail & sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray[index] = index;
+        sqLocalTail++;
+        return sqe;
+    }
+
+    // Publish new entries; returns how many the kernel has yet to consume
+    unsigned submit() {
+        storeRelease(sqTail, sqLocalTail);
+        return sqLocalTail - loadAcquire(sqHead);
+    }
+};
+
+bool UringTransport::isSupported() {
+    static const bool supported = [] {
+        io_uring_params params{};
+        int fd = setupRing(2, params);
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+        return true;
+    }();
+    return supported;
+}
+
+
+
+void UringTransport::setup() {
+    std::unique_ptr<Ring> state(new Ring());
+
+    makeBlocking(input.fd());
+    if (output.isOpen()) {
+        makeBlocking(output.fd());
+    }
+
+    io_uring_params params{};
+    state->fd = setupRing(RING_ENTRIES, params);
+    if (state->fd < 0) {
+        throwErrno("io_uring_setup failed");
+    }
+
+    state->queueSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t completionSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        state->queueSize = std::max(state->queueSize, completionSize);
+    }
+    state->queueMemory = ::mmap(nullptr, state->queueSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                state->fd, IORING_OFF_SQ_RING);
+    if (state->queueMemory == MAP_FAILED) {
+        throwErrno("mmap failed");
+    }
+    uint8_t* completionBase = static_cast<uint8_t*>(state->queueMemory);
+    if (!singleMap) {
+        state->completionSize = completionSize;
+        state->completionMemory = ::mmap(nullptr, completionSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                         state->fd, IORING_OFF_CQ_RING);
+        if (state->completionMemory == MAP_FAILED) {
+            throwErrno("mmap failed");
+        }
+        completionBase = static_cast<uint8_t*>(state->completionMemory);
+    }
+    state->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, state->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        state->fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        throwErrno("mmap failed");
+    }
+    state->sqes = static_cast<io_uring_sqe*>(sqes);
+
+    uint8_t* queueBase = static_cast<uint8_t*>(state->queueMemory);
+    state->sqHead = reinterpret_cast<unsigned*>(queueBase + params.sq_off.head);
+    state->sqTail = reinterpret_cast<unsigned*>(queueBase + params.sq_off.tail);
+    state->sqArray = reinterpret_cast<unsigned*>(queueBase + params.sq_off.array);
+    state->sqMask = *reinterpret_cast<unsigned*>(queueBase + params.sq_off.ring_mask);
+    state->sqEntries = params.sq_entries;
+    state->sqLocalTail = *state->sqTail;
+    state->cqHead = reinterpret_cast<unsigned*>(completionBase + params.cq_off.head);
+    state->cqTail = reinterpret_cast<unsigned*>(completionBase + params.cq_off.tail);
+    state->cqMask = *reinterpret_cast<unsigned*>(completionBase + params.cq_off.ring_mask);
+    state->cqes = reinterpret_cast<io_uring_cqe*>(completionBase + params.cq_off.cqes);
+
+    // Registered memory
+    size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    state->bufferSize = page + SEND_BUFFER_SIZE + PROVIDED_BUFFERS * READ_BUFFER_SIZE;
+    state->bufferMemory = ::mmap(nullptr, state->bufferSize, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (state->bufferMemory == MAP_FAILED) {
+        throwErrno("mmap failed");
+    }
+    uint8_t* bufferBase = static_cast<uint8_t*>(state->bufferMemory);
+    state->bufferRing = reinterpret_cast<io_uring_buf_ring*>(bufferBase);
+    state->sendBuffer = bufferBase + page;
+    state->readBuffers = state->sendBuffer + SEND_BUFFER_SIZE;
+
+    // Fixed buffers: 0 is the send buffer, 1 the first read buffer
+    iovec fixed[2] = {{state->sendBuffer, SEND_BUFFER_SIZE}, {state->readBuffers, READ_BUFFER_SIZE}};
+    if (registerRing(state->fd, IORING_REGISTER_BUFFERS, fixed, 2) != 0) {
+        throwErrno("io_uring buffer registration failed");
+    }
+
+    // Multishot reads need the opcode and a provided buffer ring
+    std::unique_ptr<uint8_t[]> probeMemory(new uint8_t[sizeof(io_uring_probe) + PROBE_OPS * sizeof(io_uring_probe_op)]());
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(probeMemory.get());
+    if (registerRing(state->fd, IORING_REGISTER_PROBE, probe, PROBE_OPS) == 0 &&
+        probe->last_op >= OP_READ_MULTISHOT && (probe->ops[OP_READ_MULTISHOT].flags & IO_URING_OP_SUPPORTED) != 0) {
+        io_uring_buf_reg registration{};
+        registration.ring_addr = reinterpret_cast<uint64_t>(state->bufferRing);
+        registration.ring_entries = PROVIDED_BUFFERS;
+        registration.bgid = BUFFER_GROUP;
+        multishot = registerRing(state->fd, IORING_REGISTER_PBUF_RING, &registration, 1) == 0;
+    }
+
+    wakeFd = ::eventfd(0, EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        throwErrno("eventfd failed");
+    }
+
+    ring = state.release();
+    if (multishot) {
+        for (uint16_t id = 0; id < PROVIDED_BUFFERS; ++id) {
+            recycleBuffer(id);
+        }
+    }
+}
+
+void UringTransport::recycleBuffer(uint16_t id) {
+    // Index the ring memory directly: in C++ the header's flexible array
+    // member sits behind an empty struct and would be read at offset 8
+    io_uring_buf* slots = reinterpret_cast<io_uring_buf*>(ring->bufferRing);
+    io_uring_buf& slot = slots[ring->bufferTail & (PROVIDED_BUFFERS - 1)];
+    slot.addr = reinterpret_cast<uint64_t>(ring->readBuffers + id * READ_BUFFER_SIZE);
+    slot.len = READ_BUFFER_SIZE;
+    slot.bid = id;
+    ring->bufferTail++;
+    storeRelease(&ring->bufferRing->tail, ring->bufferTail);
+}
+
+void UringTransport::armWake() {
+    if (wakeArmed) {
+        return;
+    }
+    io_uring_sqe* sqe = ring->nextSqe();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = wakeFd;
+    sqe->addr = reinterpret_cast<uint64_t>(&wakeValue);
+    sqe->len = sizeof(wakeValue);
+    sqe->user_data = WAKE_REQUEST;
+    wakeArmed = true;
+}
+
+void UringTransport::armRead() {
+    if (readArmed || !inputOpen) {
+        return;
+    }
+    io_uring_sqe* sqe = ring->nextSqe();
+    sqe->fd = input.fd();
+    sqe->off = CURRENT_POSITION;
+    sqe->user_data = READ_REQUEST;
+    if (multishot) {
+        sqe->opcode = OP_READ_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BUFFER_GROUP;
+    } else {
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->addr = reinterpret_cast<uint64_t>(ring->readBuffers);
+        sqe->len = READ_BUFFER_SIZE;
+        sqe->buf_index = 1;
+    }
+    readArmed = true;
+}
+
+void UringTransport::stageWrite(Handler& handler) {
+    if (writeInFlight) {
+        return;
+    }
+    // Copy as much pending output as fits; whatever is left, including the
+    // tail of a segment, is offered again after this write completes
+    Span<const uint8_t> segments[MAX_WRITE_SEGMENTS];
+    size_t count = handler.pendingOutput(segments, MAX_WRITE_SEGMENTS);
+    size_t staged = 0;
+    for (size_t i = 0; i < count && staged < SEND_BUFFER_SIZE; ++i) {
+        size_t length = std::min(segments[i].size(), SEND_BUFFER_SIZE - staged);
+        std::memcpy(ring->sendBuffer + staged, segments[i].data(), length);
+        staged += length;
+    }
+    if (staged == 0) {
+        return;
+    }
+    io_uring_sqe* sqe = ring->nextSqe();
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = output.isOpen() ? output.fd() : input.fd();
+    sqe->off = CURRENT_POSITION;
+    sqe->addr = reinterpret_cast<uint64_t>(ring->sendBuffer);
+    sqe->len = static_cast<uint32_t>(staged);
+    sqe->buf_index = 0;
+    sqe->user_data = WRITE_REQUEST;
+    writeInFlight = true;
+}
+
+void UringTransport::reapCompletions(Handler& handler) {
+    unsigned head = *ring->cqHead;
+    unsigned tail = loadAcquire(ring->cqTail);
+    while (head != tail) {
+        // Copy the entry and release its slot before acting on it, so an
+        // exception leaves the queue consistent
+        io_uring_cqe cqe = ring->cqes[head & ring->cqMask];
+        storeRelease(ring->cqHead, ++head);
+
+        if (cqe.user_data == WAKE_REQUEST) {
+            wakeArmed = false;
+            handler.onNotified();
+        } else if (cqe.user_data == READ_REQUEST) {
+            if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+                readArmed = false;
+            }
+            if (cqe.res > 0) {
+                const uint8_t* data = ring->readBuffers;
+                uint16_t id = 0;
+                bool provided = (cqe.flags & IORING_CQE_F_BUFFER) != 0;
+                if (provided) {
+                    id = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                    data += id * READ_BUFFER_SIZE;
+                }
+                reads.fetch_add(1, std::memory_order_relaxed);
+                bytesRead.fetch_add(static_cast<uint64_t>(cqe.res), std::memory_order_relaxed);
+                handler.onReceived(Span<const uint8_t>(data, static_cast<size_t>(cqe.res)));
+                if (provided) {
+                    recycleBuffer(id);
+                }
+            } else if (cqe.res == 0 || cqe.res == -EIO) {
+                // End of file, or a pty whose other end has closed
+                inputOpen = false;
+            } else if (cqe.res != -ENOBUFS && cqe.res != -EAGAIN && cqe.res != -EINTR && cqe.res != -ECANCELED) {
+                throwErrno("io_uring read failed", -cqe.res);
+            }
+        } else if (cqe.user_data == WRITE_REQUEST) {
+            writeInFlight = false;
+            if (cqe.res > 0) {
+                writes.fetch_add(1, std::memory_order_relaxed);
+                bytesWritten.fetch_add(static_cast<uint64_t>(cqe.res), std::memory_order_relaxed);
+                handler.outputWritten(static_cast<size_t>(cqe.res));
+            } else if (cqe.res < 0 && cqe.res != -EAGAIN && cqe.res != -EINTR) {
+                throwErrno("io_uring write failed", -cqe.res);
+            }
+        }
+    }
+}
+
+void UringTransport::run(Handler& handler) {
+    while (!stopping.load(std::memory_order_acquire)) {
+        armWake();
+        armRead();
+        stageWrite(handler);
+
+        // Submit everything queued this round and wait in the same call
+        unsigned pending = ring->submit();
+        int result = enterRing(ring->fd, pending, 1, IORING_ENTER_GETEVENTS);
+        enters.fetch_add(1, std::memory_order_relaxed);
+        if (result < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                continue;
+            }
+            throwErrno("io_uring_enter failed");
+        }
+        submissions.fetch_add(static_cast<uint64_t>(result), std::memory_order_relaxed);
+        reapCompletions(handler);
+    }
+    stopping.store(false, std::memory_order_release);
+}
+
+UringTransport::UringTransport(SerialDevice device) : input(std::move(device)) {
+    setup();
+}
+
+UringTransport::UringTransport(SerialDevice inputDevice, SerialDevice outputDevice)
+    : input(std::move(inputDevice)), output(std::move(outputDevice)) {
+    setup();
+}
+
+UringTransport::~UringTransport() {
+    delete ring;
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+    }
+}
+
+void UringTransport::notify() {
+    uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+void UringTransport::stop() {
+    stopping.store(true, std::memory_order_release);
+    notify();
+}
+
+#else
+
+struct UringTransport::Ring {};
+
+bool UringTransport::isSupported() {
+    return false;
+}
+
+UringTransport::UringTransport(SerialDevice device) : input(std::move(device)) {
+    setup();
+}
+
+UringTransport::UringTransport(SerialDevice inputDevice, SerialDevice outputDevice)
+    : input(std::move(inputDevice)), output(std::move(outputDevice)) {
+    setup();
+}
+
+UringTransport::~UringTransport() = default;
+
+void UringTransport::setup() {
+    throwErrno("io_uring unavailable", ENOSYS);
+}
+
+void UringTransport::run(Handler&) {
+    throwErrno("io_uring unavailable", ENOSYS);
+}
+
+void UringTransport::notify() {}
+
+void UringTransport::stop() {
+    stopping.store(true, std::memory_order_release);
+}
+
+#endif
+
+UringTransport::Stats UringTransport::getStats() const {
+    Stats stats;
+    stats.enters = enters.load(std::memory_order_relaxed);
+    stats.submissions = submissions.load(std::memory_order_relaxed);
+    stats.reads = reads.load(std::memory_order_relaxed);
+    stats.writes = writes.load(std::memory_order_relaxed);
+    stats.bytesRead = bytesRead.load(std::memory_order_relaxed);
+    stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace SCALPEL
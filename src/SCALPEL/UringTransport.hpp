@@ -0,0 +1,108 @@
+#ifndef URINGTRANSPORT_HPP
+#define URINGTRANSPORT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "SerialDevice.hpp"
+#include "Transport.hpp"
+
+namespace SCALPEL {
+
+// Transport driven by an io_uring instance, so one io_uring_enter both
+// submits the loop's queued requests and waits for their completions.
+//
+// Reads use a multishot read fed from a registered ring of provided
+// buffers, so a single request keeps delivering data; kernels without
+// multishot reads get a fixed-buffer read re-armed after each completion.
+// Queued output is copied into a registered send buffer, as many pending
+// frames as fit, and written with one fixed-buffer write; only one write is
+// in flight, which keeps the stream in order. notify() and stop() signal an
+// eventfd the ring keeps a read posted on.
+//
+// The kernel interface is used directly, without liburing. Construction
+// throws std::system_error where io_uring is unavailable; check
+// isSupported() first, or use createTransport() to fall back to epoll.
+class UringTransport : public Transport {
+public:
+    // Counts since construction, for benchmarks and diagnostics
+    struct Stats {
+        uint64_t enters = 0;       // io_uring_enter calls, the loop's only I/O syscalls
+        uint64_t submissions = 0;  // Requests submitted
+        uint64_t reads = 0;        // Read completions carrying data
+        uint64_t writes = 0;       // Write completions
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+    };
+
+    // Whether this kernel lets the process create an io_uring instance
+    static bool isSupported();
+
+    // Read and write the same descriptor, e.g. a serial port or pty
+    explicit UringTransport(SerialDevice device);
+
+    // Read from input and write to output, e.g. the ends of two pipes
+    UringTransport(SerialDevice input, SerialDevice output);
+
+    ~UringTransport() override;
+
+    UringTransport(const UringTransport&) = delete;
+    UringTransport& operator=(const UringTransport&) = delete;
+
+    void run(Handler& handler) override;
+    void notify() override;
+    void stop() override;
+
+    // Whether reads use a multishot request
+    bool usesMultishotRead() const { return multishot; }
+
+    // Safe to call while the loop runs
+    Stats getStats() const;
+
+private:
+    static constexpr unsigned RING_ENTRIES = 16;
+    static constexpr size_t SEND_BUFFER_SIZE = 16384;
+    static constexpr size_t READ_BUFFER_SIZE = 4096;
+    static constexpr size_t MAX_WRITE_SEGMENTS = 64;
+    static constexpr unsigned PROVIDED_BUFFERS = 8;
+
+    struct Ring;
+
+    // Set up the ring, eventfd and registered buffers
+    void setup();
+
+    // Post the eventfd read, the input read and a write of pending output
+    // when each is needed and not already in flight
+    void armWake();
+    void armRead();
+    void stageWrite(Handler& handler);
+
+    // Handle every completion the kernel has posted
+    void reapCompletions(Handler& handler);
+
+    // Hand a provided buffer back to the kernel
+    void recycleBuffer(uint16_t id);
+
+    Ring* ring = nullptr;
+    SerialDevice input;
+    SerialDevice output;  // Unused when input is also the output
+    int wakeFd = -1;
+    bool multishot = false;
+    bool inputOpen = true;
+    bool wakeArmed = false;
+    bool readArmed = false;
+    bool writeInFlight = false;
+    uint64_t wakeValue = 0;
+    std::atomic<bool> stopping{false};
+
+    std::atomic<uint64_t> enters{0};
+    std::atomic<uint64_t> submissions{0};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> writes{0};
+    std::atomic<uint64_t> bytesRead{0};
+    std::atomic<uint64_t> bytesWritten{0};
+};
+
+} // namespace SCALPEL
+
+#endif // URINGTRANSPORT_HPP
@@ -0,0 +1,76 @@
+#include "CpuFeatures.hpp"
+#include <cstdint>
+
+#if defined(NOVALINK_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+
+#if defined(NOVALINK_X86)
+void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<uint32_t>(out[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Reads XCR0 to find out which register states the OS saves on context switch.
+uint64_t readXCR0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+CpuFeatures detect() {
+    CpuFeatures features;
+#if defined(NOVALINK_X86)
+    uint32_t regs[4] = {0, 0, 0, 0};
+    cpuid(0, 0, regs);
+    const uint32_t maxLeaf = regs[0];
+    if (maxLeaf < 1) {
+        return features;
+    }
+
+    cpuid(1, 0, regs);
+    const uint32_t ecx = regs[2];
+    const uint32_t edx = regs[3];
+    features.sse2 = (edx & (1u << 26)) != 0;
+    features.pclmul = (ecx & (1u << 1)) != 0;
+    features.ssse3 = (ecx & (1u << 9)) != 0;
+    features.sse41 = (ecx & (1u << 19)) != 0;
+    features.sse42 = (ecx & (1u << 20)) != 0;
+    features.popcnt = (ecx & (1u << 23)) != 0;
+
+    const bool osxsave = (ecx & (1u << 27)) != 0;
+    const bool avx = (ecx & (1u << 28)) != 0;
+    const bool ymmEnabled = osxsave && avx && (readXCR0() & 0x6) == 0x6;
+    if (ymmEnabled && maxLeaf >= 7) {
+        cpuid(7, 0, regs);
+        features.avx2 = (regs[1] & (1u << 5)) != 0;
+    }
+#endif
+    return features;
+}
+
+} // namespace
+
+const CpuFeatures& CpuFeatures::get() {
+    static const CpuFeatures features = detect();
+    return features;
+}
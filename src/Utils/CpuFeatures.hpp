@@ -0,0 +1,38 @@
+#ifndef CPUFEATURES_HPP
+#define CPUFEATURES_HPP
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NOVALINK_X86 1
+#endif
+
+// Compiles a single function for an instruction set extension (e.g. "avx2") so
+// the library can ship SIMD kernels without building everything with -m flags.
+// Callers must check CpuFeatures before invoking such a function.
+#if defined(NOVALINK_X86) && (defined(__GNUC__) || defined(__clang__))
+#define NOVALINK_TARGET(isa) __attribute__((target(isa)))
+#else
+#define NOVALINK_TARGET(isa)
+#endif
+
+/**
+ * @brief Instruction set extensions available on the running CPU.
+ *
+ * Detected once via cpuid (and xgetbv for AVX state) on first use. On
+ * non-x86 targets every flag is false and callers use their portable paths.
+ */
+struct CpuFeatures {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool popcnt = false;
+    bool pclmul = false;
+    bool avx2 = false;
+
+    /**
+     * @brief Returns the features of the running CPU.
+     */
+    static const CpuFeatures& get();
+};
+
+#endif // CPUFEATURES_HPP
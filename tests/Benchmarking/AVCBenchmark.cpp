@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include "AVC/Fragmentation.hpp"
+#include <algorithm>
+#include <random>
+
+// Fragments of `count` messages of `length` bytes, shuffled within a window of
+// `reorder` fragments and with `lossPercent` of them dropped and as many duplicated
+static std::vector<SCALPEL::Packet> makeFragmentStream(size_t count, size_t length, size_t reorder,
+                                                       unsigned lossPercent) {
+    RocketLink::AVC::Fragmenter fragmenter;
+    std::vector<uint8_t> message(length, 0xA5);
+    std::vector<SCALPEL::Packet> stream;
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<SCALPEL::Packet> fragments = fragmenter.fragment(0x12, message);
+        stream.insert(stream.end(), fragments.begin(), fragments.end());
+    }
+
+    std::mt19937 rng(7);
+    if (lossPercent != 0) {
+        std::uniform_int_distribution<unsigned> percent(0, 99);
+        std::vector<SCALPEL::Packet> impaired;
+        for (const SCALPEL::Packet& packet : stream) {
+            unsigned roll = percent(rng);
+            if (roll < lossPercent) {
+                continue;
+            }
+            impaired.push_back(packet);
+            if (roll < 2 * lossPercent) {
+                impaired.push_back(packet);
+            }
+        }
+        stream.swap(impaired);
+    }
+    if (reorder > 1) {
+        for (size_t offset = 0; offset < stream.size(); offset += reorder) {
+            auto end = stream.begin() + static_cast<std::ptrdiff_t>(std::min(offset + reorder, stream.size()));
+            std::shuffle(stream.begin() + static_cast<std::ptrdiff_t>(offset), end, rng);
+        }
+    }
+    return stream;
+}
+
+// Reassembly throughput; args are message length, reorder window and loss percent
+static void BM_Reassembler_Throughput(benchmark::State& state) {
+    const size_t messages = 256;
+    const size_t length = static_cast<size_t>(state.range(0));
+    std::vector<SCALPEL::Packet> stream = makeFragmentStream(messages, length, static_cast<size_t>(state.range(1)),
+                                                             static_cast<unsigned>(state.range(2)));
+
+    size_t delivered = 0;
+    size_t bytes = 0;
+    RocketLink::AVC::Reassembler reassembler(8, 1024, std::chrono::seconds(1),
+                                             [&](SCALPEL::Span<const uint8_t> message, uint8_t) {
+        delivered++;
+        bytes += message.size();
+    });
+
+    // One fragment per millisecond; a full table evicts the oldest partial message
+    RocketLink::AVC::Reassembler::Clock::time_point now{};
+    for (auto _ : state) {
+        for (const SCALPEL::Packet& fragment : stream) {
+            now += std::chrono::milliseconds(1);
+            reassembler.accept(fragment.getPayload(), now);
+        }
+        now += std::chrono::seconds(2);
+        reassembler.expire(now);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.counters["delivered"] = static_cast<double>(delivered) / (static_cast<double>(state.iterations()) * messages);
+    const RocketLink::AVC::Reassembler::Stats& stats = reassembler.getStats();
+    state.counters["evicted"] = static_cast<double>(stats.messagesEvicted + stats.messagesTimedOut) /
+                                static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_Reassembler_Throughput)
+    ->ArgsProduct({{64, 255, 1024}, {1, 16}, {0}})
+    ->ArgsProduct({{255, 1024}, {16}, {5, 10}});
+
+// Fragmentation cost per message
+static void BM_Fragmenter_Fragment(benchmark::State& state) {
+    RocketLink::AVC::Fragmenter fragmenter;
+    std::vector<uint8_t> message(static_cast<size_t>(state.range(0)), 0xA5);
+    for (auto _ : state) {
+        std::vector<SCALPEL::Packet> fragments = fragmenter.fragment(0x12, message);
+        benchmark::DoNotOptimize(fragments.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Fragmenter_Fragment)->Arg(64)->Arg(255)->Arg(1024);
+
+#ifndef COMBINED_BENCHMARK
+BENCHMARK_MAIN();
+#endif
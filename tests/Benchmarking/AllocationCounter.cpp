@@ -0,0 +1,46 @@
+#include "AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> allocationBytes{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace AllocationCounter {
+
+uint64_t allocations() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t bytesAllocated() {
+    return allocationBytes.load(std::memory_order_relaxed);
+}
+
+void report(benchmark::State& state, uint64_t allocationsBefore) {
+    double total = static_cast<double>(allocations() - allocationsBefore);
+    state.counters["allocs/iter"] = benchmark::Counter(
+        state.iterations() == 0 ? 0.0 : total / static_cast<double>(state.iterations()));
+}
+
+} // namespace AllocationCounter
@@ -0,0 +1,23 @@
+#ifndef ALLOCATIONCOUNTER_HPP
+#define ALLOCATIONCOUNTER_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+// Counts heap allocations made through the global operator new, which
+// AllocationCounter.cpp replaces for every benchmark binary.
+namespace AllocationCounter {
+
+// Total allocations since program start
+uint64_t allocations();
+
+// Total bytes requested since program start
+uint64_t bytesAllocated();
+
+// Records allocations per iteration since the given starting count as the
+// "allocs/iter" counter of the benchmark
+void report(benchmark::State& state, uint64_t allocationsBefore);
+
+} // namespace AllocationCounter
+
+#endif // ALLOCATIONCOUNTER_HPP
@@ -0,0 +1,411 @@
+#include <benchmark/benchmark.h>
+#include "SCALPEL/Communicator.hpp"
+#include "SCALPEL/EpollTransport.hpp"
+#include "SCALPEL/FrameRing.hpp"
+#include "SCALPEL/SerialDevice.hpp"
+#include "SCALPEL/UringTransport.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+// Fraction q of the sorted samples, in microseconds
+double percentile(std::vector<double>& samples, double q) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = std::min(samples.size() - 1, static_cast<size_t>(q * static_cast<double>(samples.size())));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+    return samples[index];
+}
+
+enum Backend { EPOLL = 0, URING = 1 };
+enum Link { PTY = 0, PIPE = 1 };
+
+// Two connected transports of the requested backend over a pty pair or a
+// pair of pipes; nullptr if the backend is unavailable
+std::pair<std::unique_ptr<SCALPEL::Transport>, std::unique_ptr<SCALPEL::Transport>> makeLink(int backend, int link) {
+    if (backend == URING && !SCALPEL::UringTransport::isSupported()) {
+        return {};
+    }
+    auto make = [backend](SCALPEL::SerialDevice input, SCALPEL::SerialDevice output) -> std::unique_ptr<SCALPEL::Transport> {
+        if (backend == URING) {
+            return output.isOpen() ? std::make_unique<SCALPEL::UringTransport>(std::move(input), std::move(output))
+                                   : std::make_unique<SCALPEL::UringTransport>(std::move(input));
+        }
+        return output.isOpen() ? std::make_unique<SCALPEL::EpollTransport>(std::move(input), std::move(output))
+                               : std::make_unique<SCALPEL::EpollTransport>(std::move(input));
+    };
+    if (link == PTY) {
+        auto pty = SCALPEL::SerialDevice::openPtyPair();
+        return {make(std::move(pty.first), SCALPEL::SerialDevice()), make(std::move(pty.second), SCALPEL::SerialDevice())};
+    }
+    int up[2];
+    int down[2];
+    if (::pipe(up) != 0 || ::pipe(down) != 0) {
+        return {};
+    }
+    return {make(SCALPEL::SerialDevice(down[0]), SCALPEL::SerialDevice(up[1])),
+            make(SCALPEL::SerialDevice(up[0]), SCALPEL::SerialDevice(down[1]))};
+}
+
+// I/O syscalls a transport's loop has made: epoll_wait, read and writev for
+// epoll, io_uring_enter for io_uring. The eventfd write behind notify() is
+// made by the sending thread and is the same for both
+uint64_t loopSyscalls(const SCALPEL::Transport* transport) {
+    if (auto epoll = dynamic_cast<const SCALPEL::EpollTransport*>(transport)) {
+        SCALPEL::EpollTransport::Stats stats = epoll->getStats();
+        return stats.waits + stats.reads + stats.writes;
+    }
+    if (auto uring = dynamic_cast<const SCALPEL::UringTransport*>(transport)) {
+        return uring->getStats().enters;
+    }
+    return 0;
+}
+
+const char* backendName(int backend) {
+    return backend == URING ? "io_uring" : "epoll";
+}
+
+} // namespace
+
+// Round trip of one frame: the ground side sends, the rocket side echoes
+// from its receive callback, and the ground side waits for the last echoed
+// byte. Arguments are the backend (0 epoll, 1 io_uring), the link (0 pty,
+// 1 pipes) and the frame length. Reports latency percentiles and syscalls
+// per round trip across both loops
+static void BM_Communicator_RoundTrip(benchmark::State& state) {
+    auto link = makeLink(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+    if (!link.first) {
+        state.SkipWithError("transport unavailable");
+        return;
+    }
+    state.SetLabel(backendName(static_cast<int>(state.range(0))));
+    const SCALPEL::Transport* groundLoop = link.first.get();
+    const SCALPEL::Transport* rocketLoop = link.second.get();
+
+    std::atomic<size_t> echoed{0};
+    SCALPEL::Communicator* rocketPtr = nullptr;
+    SCALPEL::Communicator ground([&](const std::vector<uint8_t>& data) {
+        echoed.fetch_add(data.size(), std::memory_order_release);
+    }, std::move(link.first));
+    SCALPEL::Communicator rocket([&](const std::vector<uint8_t>& data) {
+        rocketPtr->send(data);
+    }, std::move(link.second));
+    rocketPtr = &rocket;
+    ground.start();
+    rocket.start();
+
+    std::vector<uint8_t> frame(static_cast<size_t>(state.range(2)), 0x5A);
+    std::vector<double> samples;
+    samples.reserve(1 << 16);
+    size_t expected = 0;
+    uint64_t syscallsBefore = loopSyscalls(groundLoop) + loopSyscalls(rocketLoop);
+
+    for (auto _ : state) {
+        expected += frame.size();
+        BenchClock::time_point sent = BenchClock::now();
+        ground.send(frame);
+        while (echoed.load(std::memory_order_acquire) < expected) {
+            std::this_thread::yield();
+        }
+        samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - sent).count());
+    }
+
+    ground.stop();
+    rocket.stop();
+
+    uint64_t syscalls = loopSyscalls(groundLoop) + loopSyscalls(rocketLoop) - syscallsBefore;
+    state.counters["syscalls/rt"] =
+        benchmark::Counter(static_cast<double>(syscalls), benchmark::Counter::kAvgIterations);
+    state.counters["p50_us"] = percentile(samples, 0.50);
+    state.counters["p99_us"] = percentile(samples, 0.99);
+    state.counters["max_us"] = percentile(samples, 1.0);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(2) * 2);
+}
+BENCHMARK(BM_Communicator_RoundTrip)
+    ->ArgNames({"uring", "pipe", "bytes"})
+    ->ArgsProduct({{EPOLL, URING}, {PTY, PIPE}, {8, 255}})
+    ->UseRealTime();
+
+// One-way stream of 32-byte frames sent back to back, as at a high packet
+// rate; each iteration sends a burst and waits for all of it to arrive.
+// Reports syscalls per packet across both loops
+static void BM_Communicator_Stream(benchmark::State& state) {
+    constexpr size_t FRAME_LENGTH = 32;
+    const size_t burst = static_cast<size_t>(state.range(2));
+    auto link = makeLink(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+    if (!link.first) {
+        state.SkipWithError("transport unavailable");
+        return;
+    }
+    state.SetLabel(backendName(static_cast<int>(state.range(0))));
+    const SCALPEL::Transport* groundLoop = link.first.get();
+    const SCALPEL::Transport* rocketLoop = link.second.get();
+
+    std::atomic<size_t> received{0};
+    SCALPEL::Communicator ground([](const std::vector<uint8_t>&) {}, std::move(link.first));
+    SCALPEL::Communicator rocket([&](const std::vector<uint8_t>& data) {
+        received.fetch_add(data.size(), std::memory_order_release);
+    }, std::move(link.second));
+    ground.start();
+    rocket.start();
+
+    std::vector<uint8_t> frame(FRAME_LENGTH, 0xA5);
+    size_t expected = 0;
+    uint64_t syscallsBefore = loopSyscalls(groundLoop) + loopSyscalls(rocketLoop);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < burst; ++i) {
+            ground.send(frame);
+        }
+        expected += burst * FRAME_LENGTH;
+        while (received.load(std::memory_order_acquire) < expected) {
+            std::this_thread::yield();
+        }
+    }
+
+    ground.stop();
+    rocket.stop();
+
+    uint64_t syscalls = loopSyscalls(groundLoop) + loopSyscalls(rocketLoop) - syscallsBefore;
+    double packets = static_cast<double>(state.iterations() * burst);
+    state.counters["syscalls/pkt"] = packets > 0 ? static_cast<double>(syscalls) / packets : 0;
+    state.counters["pkts/s"] = benchmark::Counter(packets, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Communicator_Stream)
+    ->ArgNames({"uring", "pipe", "burst"})
+    ->ArgsProduct({{EPOLL, URING}, {PTY, PIPE}, {64}})
+    ->UseRealTime();
+
+namespace {
+
+constexpr size_t QUEUE_FRAME_LENGTH = 32;
+constexpr size_t QUEUE_FRAMES_PER_PRODUCER = 20000;
+
+int64_t nowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now().time_since_epoch()).count();
+}
+
+// Runs producers sending timestamped frames through enqueue while the
+// calling thread dequeues them with dequeue, which returns the dequeued
+// frame's timestamp or -1 after waiting for more. Returns enqueue-to-dequeue
+// latencies in microseconds
+template <typename Enqueue, typename Dequeue>
+std::vector<double> runQueue(int producers, Enqueue enqueue, Dequeue dequeue) {
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&enqueue] {
+            uint8_t frame[QUEUE_FRAME_LENGTH] = {};
+            for (size_t i = 0; i < QUEUE_FRAMES_PER_PRODUCER; ++i) {
+                int64_t stamp = nowNanoseconds();
+                std::memcpy(frame, &stamp, sizeof(stamp));
+                enqueue(frame);
+            }
+        });
+    }
+    std::vector<double> latencies;
+    latencies.reserve(producers * QUEUE_FRAMES_PER_PRODUCER);
+    while (latencies.size() < producers * QUEUE_FRAMES_PER_PRODUCER) {
+        int64_t stamp = dequeue();
+        if (stamp >= 0) {
+            latencies.push_back(static_cast<double>(nowNanoseconds() - stamp) / 1000.0);
+        }
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return latencies;
+}
+
+void reportQueue(benchmark::State& state, std::vector<double>& latencies, double frames) {
+    state.counters["frames/s"] = benchmark::Counter(frames, benchmark::Counter::kIsRate);
+    state.counters["p50_us"] = percentile(latencies, 0.50);
+    state.counters["p99_us"] = percentile(latencies, 0.99);
+}
+
+} // namespace
+
+// The send queue as it was before the frame ring: a std::queue of vectors
+// behind a mutex, a condition variable to wake the consumer, and the front
+// frame copied out under the lock. Argument is the producer count
+static void BM_SendQueue_MutexCV(benchmark::State& state) {
+    const int producers = static_cast<int>(state.range(0));
+    std::vector<double> latencies;
+    for (auto _ : state) {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::queue<std::vector<uint8_t>> queue;
+        std::vector<double> run = runQueue(producers,
+            [&](const uint8_t* frame) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queue.emplace(frame, frame + QUEUE_FRAME_LENGTH);
+                }
+                ready.notify_one();
+            },
+            [&]() -> int64_t {
+                std::vector<uint8_t> frame;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [&] { return !queue.empty(); });
+                    frame = queue.front();
+                    queue.pop();
+                }
+                int64_t stamp;
+                std::memcpy(&stamp, frame.data(), sizeof(stamp));
+                return stamp;
+            });
+        latencies.insert(latencies.end(), run.begin(), run.end());
+    }
+    reportQueue(state, latencies, static_cast<double>(state.iterations() * producers * QUEUE_FRAMES_PER_PRODUCER));
+}
+BENCHMARK(BM_SendQueue_MutexCV)->ArgName("producers")->Arg(1)->Arg(4)->UseRealTime();
+
+// The Communicator's send queue: a FrameRing written in place, with an
+// eventfd wake only when the consumer has declared itself idle, as the
+// Communicator's loop does. Argument is the producer count
+static void BM_SendQueue_Ring(benchmark::State& state) {
+    using Ring = SCALPEL::FrameRing<SCALPEL::Communicator::MAX_FRAME_LENGTH, SCALPEL::Communicator::SEND_QUEUE_SLOTS>;
+    const int producers = static_cast<int>(state.range(0));
+    std::unique_ptr<Ring> ring(new Ring());
+    int wake = ::eventfd(0, EFD_CLOEXEC);
+    std::atomic<uint64_t> wakes{0};
+    std::vector<double> latencies;
+    for (auto _ : state) {
+        std::atomic<bool> idle{false};
+        std::vector<double> run = runQueue(producers,
+            [&](const uint8_t* frame) {
+                Ring::Reservation slot = ring->tryReserve();
+                while (!slot) {
+                    std::this_thread::yield();
+                    slot = ring->tryReserve();
+                }
+                std::memcpy(slot.data(), frame, QUEUE_FRAME_LENGTH);
+                ring->commit(slot, QUEUE_FRAME_LENGTH);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (idle.load(std::memory_order_relaxed) && idle.exchange(false)) {
+                    uint64_t one = 1;
+                    (void)!::write(wake, &one, sizeof(one));
+                    wakes.fetch_add(1, std::memory_order_relaxed);
+                }
+            },
+            [&]() -> int64_t {
+                SCALPEL::Span<const uint8_t> frame = ring->peek();
+                if (frame.empty()) {
+                    idle.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (ring->empty()) {
+                        uint64_t count;
+                        (void)!::read(wake, &count, sizeof(count));
+                    }
+                    idle.store(false, std::memory_order_relaxed);
+                    return -1;
+                }
+                int64_t stamp;
+                std::memcpy(&stamp, frame.data(), sizeof(stamp));
+                ring->pop();
+                return stamp;
+            });
+        latencies.insert(latencies.end(), run.begin(), run.end());
+    }
+    ::close(wake);
+    double frames = static_cast<double>(state.iterations() * producers * QUEUE_FRAMES_PER_PRODUCER);
+    reportQueue(state, latencies, frames);
+    state.counters["wakes/frame"] = frames > 0 ? static_cast<double>(wakes.load()) / frames : 0;
+}
+BENCHMARK(BM_SendQueue_Ring)->ArgName("producers")->Arg(1)->Arg(4)->UseRealTime();
+
+// Telemetry offered faster than a slow link drains it: a reader empties at
+// most 4 KiB from a 4 KiB pipe per millisecond, about 128k 32-byte frames/s.
+// Each iteration offers 1024 frames. Argument is the QueueFullPolicy
+// (0 block, 1 drop oldest telemetry, 2 reject). Reports accepted and
+// delivered frames/s, enqueue latency percentiles and the share of frames
+// dropped or rejected
+static void BM_Communicator_Overload(benchmark::State& state) {
+    constexpr size_t FRAME_LENGTH = 32;
+    constexpr size_t OFFERED = 1024;
+    using Policy = SCALPEL::Communicator::QueueFullPolicy;
+    int up[2];
+    int down[2];
+    if (::pipe(up) != 0 || ::pipe(down) != 0) {
+        state.SkipWithError("pipe failed");
+        return;
+    }
+    ::fcntl(up[0], F_SETPIPE_SZ, 4096);
+    ::fcntl(up[0], F_SETFL, O_NONBLOCK);
+
+    std::atomic<bool> reading{true};
+    std::atomic<size_t> delivered{0};
+    std::thread reader([&] {
+        std::vector<uint8_t> buffer(4096);
+        while (reading.load(std::memory_order_relaxed)) {
+            ssize_t got = ::read(up[0], buffer.data(), buffer.size());
+            if (got > 0) {
+                delivered.fetch_add(static_cast<size_t>(got), std::memory_order_relaxed);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    SCALPEL::Communicator ground([](const std::vector<uint8_t>&) {},
+        std::make_unique<SCALPEL::EpollTransport>(SCALPEL::SerialDevice(down[0]), SCALPEL::SerialDevice(up[1])));
+    ground.setQueueFullPolicy(static_cast<Policy>(state.range(0)));
+    ground.start();
+
+    std::vector<uint8_t> frame(FRAME_LENGTH, 0x3C);
+    std::vector<double> samples;
+    samples.reserve(1 << 20);
+    size_t accepted = 0;
+    size_t deliveredBefore = delivered.load();
+    BenchClock::time_point started = BenchClock::now();
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < OFFERED; ++i) {
+            BenchClock::time_point before = BenchClock::now();
+            SCALPEL::Communicator::SendResult result = ground.send(frame, SCALPEL::Communicator::FrameClass::Telemetry);
+            samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - before).count());
+            accepted += result == SCALPEL::Communicator::SendResult::Queued ? 1 : 0;
+        }
+    }
+
+    double elapsed = std::chrono::duration<double>(BenchClock::now() - started).count();
+    double deliveredFrames = static_cast<double>(delivered.load() - deliveredBefore) / FRAME_LENGTH;
+    SCALPEL::Communicator::QueueStats stats = ground.getQueueStats();
+    ground.stop();
+    reading = false;
+    reader.join();
+    ::close(up[0]);
+    ::close(down[1]);
+
+    double offered = static_cast<double>(state.iterations() * OFFERED);
+    state.counters["accepted/s"] = benchmark::Counter(static_cast<double>(accepted), benchmark::Counter::kIsRate);
+    state.counters["delivered/s"] = elapsed > 0 ? deliveredFrames / elapsed : 0;
+    state.counters["p50_us"] = percentile(samples, 0.50);
+    state.counters["p99_us"] = percentile(samples, 0.99);
+    state.counters["p999_us"] = percentile(samples, 0.999);
+    state.counters["max_us"] = percentile(samples, 1.0);
+    state.counters["dropped"] = offered > 0 ? static_cast<double>(stats.dropped) / offered : 0;
+    state.counters["rejected"] = offered > 0 ? static_cast<double>(stats.rejected) / offered : 0;
+    state.counters["high_water"] = static_cast<double>(stats.highWater);
+}
+BENCHMARK(BM_Communicator_Overload)
+    ->ArgName("policy")
+    ->DenseRange(0, 2)
+    ->UseRealTime();
+
+#ifndef COMBINED_BENCHMARK
+BENCHMARK_MAIN();
+#endif
@@ -0,0 +1,216 @@
+#include <benchmark/benchmark.h>
+#include "RocketLink.hpp"
+#include "API/Callbacks.hpp"
+#include "AVC/AVCProtocol.hpp"
+#include "AVC/Command.hpp"
+#include "AVC/Telemetry.hpp"
+#include "PhysicalLayer/TransportRadio.hpp"
+#include "SCALPEL/Communicator.hpp"
+#include "SCALPEL/LoopbackTransport.hpp"
+#include "SCALPEL/Packet.hpp"
+#include "Utils/Logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+using RocketLink::AVC::AVCProtocol;
+using RocketLink::AVC::Command;
+using RocketLink::AVC::CommandNumber;
+using RocketLink::AVC::Telemetry;
+using RocketLink::AVC::TelemetryDescriptor;
+using RocketLink::Radio::TransportRadio;
+
+constexpr uint8_t GROUND_ID = 1;
+constexpr uint8_t ROCKET_ID = 2;
+
+// Fraction q of the sorted samples, in microseconds
+double percentile(std::vector<double>& samples, double q) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = std::min(samples.size() - 1, static_cast<size_t>(q * static_cast<double>(samples.size())));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+    return samples[index];
+}
+
+// Link conditions selected by the benchmark argument; the model applies in
+// both directions
+struct Impairment {
+    const char* name;
+    int64_t latencyUs;
+    int64_t jitterUs;
+    double lossRate;
+    double bitErrorRate;
+};
+
+const Impairment IMPAIRMENTS[] = {
+    {"perfect", 0, 0, 0, 0},
+    {"500us", 500, 100, 0, 0},
+    {"500us 1% loss", 500, 100, 0.01, 0},
+    {"500us BER 1e-5", 500, 100, 0, 1e-5},
+};
+
+SCALPEL::LoopbackTransport::LinkModel linkModel(const Impairment& impairment) {
+    SCALPEL::LoopbackTransport::LinkModel model;
+    model.latency = std::chrono::microseconds(impairment.latencyUs);
+    model.jitter = std::chrono::microseconds(impairment.jitterUs);
+    model.lossRate = impairment.lossRate;
+    model.bitErrorRate = impairment.bitErrorRate;
+    return model;
+}
+
+} // namespace
+
+// Command round trip through AVCProtocol on both ends, each on a
+// Communicator over one end of the link: the ground sends an AVC command,
+// the rocket's protocol decodes it and acknowledges it, and the round trip
+// ends when the ground's protocol handles that acknowledgment. Lost or
+// damaged commands and acknowledgments are recovered by the protocol's own
+// retransmission. The argument picks the link conditions. Reports round
+// trip percentiles with retransmissions included, and commands the
+// protocol gave up on
+static void BM_EndToEnd_CommandRoundTrip(benchmark::State& state) {
+    const Impairment& impairment = IMPAIRMENTS[state.range(0)];
+    state.SetLabel(impairment.name);
+    auto pair = SCALPEL::LoopbackTransport::createPair(linkModel(impairment));
+
+    AVCProtocol ground(std::make_shared<SCALPEL::Communicator>(nullptr, std::move(pair.first)));
+    AVCProtocol rocket(std::make_shared<SCALPEL::Communicator>(nullptr, std::move(pair.second)));
+    std::atomic<uint64_t> acknowledged{0};
+    ground.setAcknowledgmentCallback([&acknowledged](uint8_t) {
+        acknowledged.fetch_add(1, std::memory_order_release);
+    });
+    ground.start();
+    rocket.start();
+
+    // Longer than the protocol spends on every retransmission of a command
+    const auto giveUpAfter = std::chrono::seconds(10);
+    const Command command(GROUND_ID, ROCKET_ID, CommandNumber::FIN_TEST, {1, 2, 3, 4});
+    std::vector<double> samples;
+    samples.reserve(1 << 16);
+    uint64_t expected = 0;
+    uint64_t lost = 0;
+
+    for (auto _ : state) {
+        BenchClock::time_point sent = BenchClock::now();
+        ground.sendCommand(command);
+        expected++;
+        while (acknowledged.load(std::memory_order_acquire) < expected) {
+            if (BenchClock::now() - sent >= giveUpAfter) {
+                lost++;
+                break;
+            }
+            std::this_thread::yield();
+        }
+        samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - sent).count());
+        // A retransmitted command may be acknowledged twice; the extra
+        // acknowledgment must not end the next round trip
+        expected = std::max(expected, acknowledged.load(std::memory_order_acquire));
+    }
+
+    ground.stop();
+    rocket.stop();
+
+    state.counters["p50_us"] = percentile(samples, 0.50);
+    state.counters["p99_us"] = percentile(samples, 0.99);
+    state.counters["p999_us"] = percentile(samples, 0.999);
+    state.counters["max_us"] = percentile(samples, 1.0);
+    state.counters["lost"] = static_cast<double>(lost);
+}
+BENCHMARK(BM_EndToEnd_CommandRoundTrip)
+    ->ArgName("link")
+    ->DenseRange(0, static_cast<int>(std::size(IMPAIRMENTS)) - 1)
+    ->UseRealTime();
+
+// Telemetry downlink into a ground station: the rocket encodes a burst of
+// AVC telemetry records into packets and sends them through a TransportRadio,
+// and on the ground a Core::RocketLink over another TransportRadio decodes
+// whatever survives the link and hands it to the registered telemetry
+// callback. An iteration ends once the link has delivered everything the
+// rocket put on it and the ground has handed on every packet its radio
+// received. The argument picks the link conditions. Reports decoded packets
+// per second, the share delivered and packets the ground's radio rejected
+static void BM_EndToEnd_Telemetry(benchmark::State& state) {
+    constexpr int BURST = 256;
+    const Impairment& impairment = IMPAIRMENTS[state.range(0)];
+    state.SetLabel(impairment.name);
+    auto pair = SCALPEL::LoopbackTransport::createPair(linkModel(impairment));
+    const SCALPEL::LoopbackTransport* groundLink = pair.first.get();
+    const SCALPEL::LoopbackTransport* rocketLink = pair.second.get();
+
+    // The callbacks outlive the station, whose receive thread calls them
+    std::atomic<uint64_t> decoded{0};
+    RocketLink::API::Callbacks callbacks;
+    callbacks.setTelemetryCallback([&decoded](const Telemetry& telemetry) {
+        benchmark::DoNotOptimize(telemetry);
+        decoded.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    auto groundRadio = std::make_shared<TransportRadio>(std::move(pair.first));
+    TransportRadio rocketRadio(std::move(pair.second));
+    RocketLink::Core::RocketLink station(groundRadio);
+    Logger::getInstance().setLogLevel(LogLevel::WARNING);
+    station.registerCallbacks(&callbacks);
+    if (!station.initialize()) {
+        state.SkipWithError("RocketLink failed to initialize");
+        return;
+    }
+    rocketRadio.initialize();
+
+    auto receivedByRadio = [&groundRadio]() {
+        RocketLink::Radio::RadioStatus status;
+        groundRadio->getStatus(status);
+        return static_cast<uint64_t>(status.packetsReceived);
+    };
+
+    uint8_t memoryLog[3] = {10, 20, 30};
+    std::vector<SCALPEL::Packet> burst(BURST);
+    uint64_t sent = 0;
+    for (auto _ : state) {
+        for (SCALPEL::Packet& packet : burst) {
+            int16_t sample = static_cast<int16_t>(sent & 0x7FFF);
+            Telemetry telemetry(ROCKET_ID, GROUND_ID, TelemetryDescriptor::TELEMETRY_A, 3700, 3650, sample, sample,
+                                sample, 1, 2, 3, 4, 5, 6, memoryLog, 0x01);
+            packet = SCALPEL::Packet(telemetry.encode());
+            sent++;
+        }
+        rocketRadio.sendPackets(burst);
+
+        // Everything queued has been taken by the rocket's loop once the
+        // queue is empty, and delivered once the ground has read it all
+        while (rocketRadio.getQueueDepth() > 0 || groundLink->getStats().bytesReceived < rocketLink->getStats().bytesSent) {
+            std::this_thread::yield();
+        }
+        // Then the ground station hands on what its radio received; a
+        // damaged packet that passes the checks fails to decode and is
+        // never handed on, so give up waiting after a while
+        BenchClock::time_point drained = BenchClock::now();
+        while (decoded.load(std::memory_order_relaxed) < receivedByRadio() &&
+               BenchClock::now() - drained < std::chrono::milliseconds(100)) {
+            std::this_thread::yield();
+        }
+    }
+
+    RocketLink::Radio::RadioStatus status;
+    groundRadio->getStatus(status);
+    uint64_t delivered = decoded.load(std::memory_order_relaxed);
+    state.counters["pkts/s"] = benchmark::Counter(static_cast<double>(delivered), benchmark::Counter::kIsRate);
+    state.counters["delivered%"] = sent > 0 ? 100.0 * static_cast<double>(delivered) / static_cast<double>(sent) : 0;
+    state.counters["rejected"] = static_cast<double>(status.receptionErrors);
+    state.SetBytesProcessed(static_cast<int64_t>(rocketLink->getStats().bytesSent));
+}
+BENCHMARK(BM_EndToEnd_Telemetry)
+    ->ArgName("link")
+    ->DenseRange(0, static_cast<int>(std::size(IMPAIRMENTS)) - 1)
+    ->UseRealTime();
+
+#ifndef COMBINED_BENCHMARK
+BENCHMARK_MAIN();
+#endif
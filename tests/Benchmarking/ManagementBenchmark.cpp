@@ -4,24 +4,32 @@
 #include "AVC/AVCProtocol.hpp"
 #include "AVC/Command.hpp"
 #include "SCALPEL/Communicator.hpp"
+#include "SCALPEL/LoopbackTransport.hpp"
 #include <memory>
 #include <vector>
 
-// Mock Communicator for testing purposes
-namespace SCALPEL {
+namespace {
 
-class MockCommunicator : public Communicator {
-public:
-    MockCommunicator() : Communicator([](const std::vector<uint8_t>&){}) {}
+// A Communicator on one end of a loopback link whose far end discards what
+// it receives, so the protocol sends through the real path. AVCProtocol
+// starts and stops the near end itself
+struct LoopbackCommunicator {
+    LoopbackCommunicator() {
+        auto pair = SCALPEL::LoopbackTransport::createPair();
+        communicator = std::make_shared<SCALPEL::Communicator>([](const std::vector<uint8_t>&) {}, std::move(pair.first));
+        sink = std::make_unique<SCALPEL::Communicator>([](const std::vector<uint8_t>&) {}, std::move(pair.second));
+        sink->start();
+    }
 
-    void send(const std::vector<uint8_t>& data) {
-        // Mock send implementation (no operation)
+    ~LoopbackCommunicator() {
+        sink->stop();
     }
 
-    // Note: receive() is likely private in the base class, so we don't override it here
+    std::shared_ptr<SCALPEL::Communicator> communicator;
+    std::unique_ptr<SCALPEL::Communicator> sink;
 };
 
-} // namespace SCALPEL
+} // namespace
 
 // Benchmark for TelemetryBuffer::addTelemetry
 static void BM_TelemetryBuffer_AddTelemetry(benchmark::State& state) {
@@ -47,8 +55,8 @@ BENCHMARK(BM_TelemetryBuffer_GetLatestTelemetry)->Range(8, 8<<10);
 
 // Benchmark for CommandManager::addCommand
 static void BM_CommandManager_AddCommand(benchmark::State& state) {
-    auto communicator = std::make_shared<SCALPEL::MockCommunicator>();
-    auto avcProtocol = std::make_shared<RocketLink::AVC::AVCProtocol>(communicator);
+    LoopbackCommunicator link;
+    auto avcProtocol = std::make_shared<RocketLink::AVC::AVCProtocol>(link.communicator);
     RocketLink::AVC::CommandManager cmdManager(avcProtocol);
     cmdManager.start();
     RocketLink::AVC::Command command; // Assume default constructible
@@ -61,8 +69,8 @@ BENCHMARK(BM_CommandManager_AddCommand)->Range(8, 8<<10);
 
 // Benchmark for CommandManager::handleAcknowledgment
 static void BM_CommandManager_HandleAcknowledgment(benchmark::State& state) {
-    auto communicator = std::make_shared<SCALPEL::MockCommunicator>();
-    auto avcProtocol = std::make_shared<RocketLink::AVC::AVCProtocol>(communicator);
+    LoopbackCommunicator link;
+    auto avcProtocol = std::make_shared<RocketLink::AVC::AVCProtocol>(link.communicator);
     RocketLink::AVC::CommandManager cmdManager(avcProtocol);
     cmdManager.start();
     RocketLink::AVC::Command command; // Assume default constructible
@@ -76,8 +84,8 @@ BENCHMARK(BM_CommandManager_HandleAcknowledgment)->Range(8, 8<<10);
 
 // Benchmark for CommandManager::getNextCommand
 static void BM_CommandManager_GetNextCommand(benchmark::State& state) {
-    auto communicator = std::make_shared<SCALPEL::MockCommunicator>();
-    auto avcProtocol = std::make_shared<RocketLink::AVC::AVCProtocol>(communicator);
+    LoopbackCommunicator link;
+    auto avcProtocol = std::make_shared<RocketLink::AVC::AVCProtocol>(link.communicator);
     RocketLink::AVC::CommandManager cmdManager(avcProtocol);
     cmdManager.start();
     RocketLink::AVC::Command command; // Assume default constructible
@@ -2,6 +2,26 @@
 #include "SCALPEL/Checksum.hpp"
 #include "SCALPEL/COBS.hpp"
 #include "SCALPEL/Packet.hpp"
+#include "SCALPEL/PacketView.hpp"
+#include "SCALPEL/FrameParser.hpp"
+#include "SCALPEL/ReedSolomon.hpp"
+#include "SCALPEL/Interleaver.hpp"
+#include "SCALPEL/FrameAggregator.hpp"
+#include "SCALPEL/CaptureDecoder.hpp"
+#include "SCALPEL/FixedPacketCodec.hpp"
+#include "SCALPEL/HeaderCode.hpp"
+#include "SCALPEL/GatherFrame.hpp"
+#include "Tools/CaptureGenerator.hpp"
+#include "Utils/CpuFeatures.hpp"
+#include "AllocationCounter.hpp"
+#include <array>
+#include <random>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 // Benchmark for Checksum::calculateCRC8
 static void BM_CalculateCRC8(benchmark::State& state) {
@@ -13,6 +33,62 @@ static void BM_CalculateCRC8(benchmark::State& state) {
 }
 BENCHMARK(BM_CalculateCRC8)->Range(8, 8<<10);
 
+// Benchmarks for the individual CRC-8 engines behind calculateCRC8
+static void BM_CalculateCRC8_Bitwise(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0), 0xAB);
+    for (auto _ : state) {
+        uint8_t crc = SCALPEL::Checksum::calculateCRC8Bitwise(data.data(), data.size());
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CalculateCRC8_Bitwise)->Range(8, 8<<10);
+
+static void BM_CalculateCRC8_Table(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0), 0xAB);
+    for (auto _ : state) {
+        uint8_t crc = SCALPEL::Checksum::calculateCRC8Table(data.data(), data.size());
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CalculateCRC8_Table)->Range(8, 8<<10);
+
+static void BM_CalculateCRC8_Sliced(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0), 0xAB);
+    for (auto _ : state) {
+        uint8_t crc = SCALPEL::Checksum::calculateCRC8Sliced(data.data(), data.size());
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CalculateCRC8_Sliced)->Range(8, 8<<10);
+
+static void BM_CalculateCRC8_CLMUL(benchmark::State& state) {
+    if (!CpuFeatures::get().pclmul) {
+        state.SkipWithError("CPU does not support PCLMULQDQ");
+        return;
+    }
+    std::vector<uint8_t> data(state.range(0), 0xAB);
+    for (auto _ : state) {
+        uint8_t crc = SCALPEL::Checksum::calculateCRC8CLMUL(data.data(), data.size());
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CalculateCRC8_CLMUL)->Range(8, 8<<10);
+
+// Crossover between slice-by-8 and the carry-less multiply kernel
+static void BM_CalculateCRC8_Crossover_Sliced(benchmark::State& state) {
+    BM_CalculateCRC8_Sliced(state);
+}
+BENCHMARK(BM_CalculateCRC8_Crossover_Sliced)->RangeMultiplier(2)->Range(64, 1<<20);
+
+static void BM_CalculateCRC8_Crossover_CLMUL(benchmark::State& state) {
+    BM_CalculateCRC8_CLMUL(state);
+}
+BENCHMARK(BM_CalculateCRC8_Crossover_CLMUL)->RangeMultiplier(2)->Range(64, 1<<20);
+
 // Benchmark for Checksum::validateCRC8
 static void BM_ValidateCRC8(benchmark::State& state) {
     std::vector<uint8_t> data(state.range(0), 0xCD);
@@ -24,6 +100,59 @@ static void BM_ValidateCRC8(benchmark::State& state) {
 }
 BENCHMARK(BM_ValidateCRC8)->Range(8, 8<<10);
 
+// Benchmarks for the wider payload CRCs; CRC-32C dispatches to the SSE4.2
+// crc32 instruction where available
+static void BM_CalculateCRC16(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0), 0xAB);
+    for (auto _ : state) {
+        uint16_t crc = SCALPEL::Checksum::calculateCRC16(data.data(), data.size());
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CalculateCRC16)->Range(8, 8<<10);
+
+static void BM_CalculateCRC32C(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0), 0xAB);
+    for (auto _ : state) {
+        uint32_t crc = SCALPEL::Checksum::calculateCRC32C(data.data(), data.size());
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CalculateCRC32C)->Range(8, 8<<10);
+
+static void BM_CalculateCRC32C_Table(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0), 0xAB);
+    for (auto _ : state) {
+        uint32_t crc = SCALPEL::Checksum::calculateCRC32CTable(data.data(), data.size());
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_CalculateCRC32C_Table)->Range(8, 8<<10);
+
+// Benchmarks for the multi-byte 2-bit checksum: word popcount vs. dispatched (AVX2)
+static void BM_Calculate2BitChecksum_Scalar(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0), 0x5A);
+    for (auto _ : state) {
+        uint8_t checksum = SCALPEL::Checksum::calculate2BitChecksumScalar(data.data(), data.size());
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Calculate2BitChecksum_Scalar)->Range(8, 8<<10);
+
+static void BM_Calculate2BitChecksum(benchmark::State& state) {
+    std::vector<uint8_t> data(state.range(0), 0x5A);
+    for (auto _ : state) {
+        uint8_t checksum = SCALPEL::Checksum::calculate2BitChecksum(data.data(), data.size());
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Calculate2BitChecksum)->Range(8, 8<<10);
+
 // Benchmark for COBS::encode
 static void BM_COBS_Encode(benchmark::State& state) {
     std::vector<uint8_t> input(state.range(0), 0x00);
@@ -47,29 +176,667 @@ static void BM_COBS_Decode(benchmark::State& state) {
 }
 BENCHMARK(BM_COBS_Decode)->Range(8, 8<<10);
 
+// Benchmark for COBS::encodeInto with a preallocated output buffer
+static void BM_COBS_EncodeInto(benchmark::State& state) {
+    std::vector<uint8_t> input(state.range(0), 0x00);
+    std::vector<uint8_t> output(SCALPEL::COBS::maxEncodedLength(input.size()));
+    SCALPEL::COBS cobs;
+    for (auto _ : state) {
+        SCALPEL::COBS::EncodeResult result = cobs.encodeInto(input, output);
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_COBS_EncodeInto)->Range(8, 8<<10);
+
+// Benchmark for COBS::decodeInto with a preallocated output buffer
+static void BM_COBS_DecodeInto(benchmark::State& state) {
+    std::vector<uint8_t> input(state.range(0), 0x00);
+    SCALPEL::COBS cobs;
+    SCALPEL::COBS::COBSResult encoded = cobs.encode(input);
+    std::vector<uint8_t> output(input.size());
+    for (auto _ : state) {
+        size_t length = cobs.decodeInto(encoded.encodedPayload, encoded.index, output);
+        benchmark::DoNotOptimize(length);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_COBS_DecodeInto)->Range(8, 8<<10);
+
 // Benchmark for Packet::assemble
 static void BM_Packet_Assemble(benchmark::State& state) {
     std::vector<uint8_t> payload(state.range(0), 0xEF);
     SCALPEL::Packet packet(payload);
+    uint64_t allocations = AllocationCounter::allocations();
     for (auto _ : state) {
         std::vector<uint8_t> assembled = packet.assemble();
         benchmark::DoNotOptimize(assembled);
     }
+    AllocationCounter::report(state, allocations);
 }
 BENCHMARK(BM_Packet_Assemble)->Range(8, 28);
 
+// Benchmark for Packet::assembleInto writing into a stack buffer
+static void BM_Packet_AssembleInto(benchmark::State& state) {
+    std::vector<uint8_t> payload(state.range(0), 0xEF);
+    payload[payload.size() / 2] = SCALPEL::Packet::START_BYTE;
+    SCALPEL::Packet packet(payload);
+    std::array<uint8_t, SCALPEL::Packet::MAX_PACKET_LENGTH> buffer;
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        size_t length = packet.assembleInto(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(length);
+        benchmark::ClobberMemory();
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_Packet_AssembleInto)->Range(8, 28);
+
+// A burst of telemetry payloads assembled one packet at a time into one buffer
+static void BM_Packet_AssembleBurst(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> payload(SCALPEL::Packet::MAX_PAYLOAD_LENGTH, 0xEF);
+    payload[payload.size() / 2] = SCALPEL::Packet::START_BYTE;
+    std::vector<uint8_t> out;
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        out.clear();
+        for (size_t i = 0; i < count; ++i) {
+            std::vector<uint8_t> assembled = SCALPEL::Packet(payload).assemble();
+            out.insert(out.end(), assembled.begin(), assembled.end());
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["packets_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * count), benchmark::Counter::kIsRate);
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_Packet_AssembleBurst)->RangeMultiplier(4)->Range(1, 256);
+
+// The same burst through Packet::assembleBatch into a reused OutputBuffer
+static void BM_Packet_AssembleBatch(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> payload(SCALPEL::Packet::MAX_PAYLOAD_LENGTH, 0xEF);
+    payload[payload.size() / 2] = SCALPEL::Packet::START_BYTE;
+    std::vector<SCALPEL::Span<const uint8_t>> payloads(count, SCALPEL::Span<const uint8_t>(payload));
+    SCALPEL::Packet::OutputBuffer out;
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        size_t length = SCALPEL::Packet::assembleBatch(payloads, out);
+        benchmark::DoNotOptimize(length);
+        benchmark::ClobberMemory();
+    }
+    state.counters["packets_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * count), benchmark::Counter::kIsRate);
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_Packet_AssembleBatch)->RangeMultiplier(4)->Range(1, 256);
+
 // Benchmark for Packet::disassemble
 static void BM_Packet_Disassemble(benchmark::State& state) {
     std::vector<uint8_t> payload(state.range(0), 0xEF);
     SCALPEL::Packet packet(payload);
     std::vector<uint8_t> assembled = packet.assemble();
+    uint64_t allocations = AllocationCounter::allocations();
     for (auto _ : state) {
         SCALPEL::Packet pkt = SCALPEL::Packet::disassemble(assembled);
         benchmark::DoNotOptimize(pkt);
     }
+    AllocationCounter::report(state, allocations);
 }
 BENCHMARK(BM_Packet_Disassemble)->Range(8, 28);
 
+// Benchmark for validating a packet in place with PacketView and decoding
+// its payload into a scratch buffer
+static void BM_PacketView_ParseDecode(benchmark::State& state) {
+    std::vector<uint8_t> payload(state.range(0), 0xEF);
+    std::vector<uint8_t> assembled = SCALPEL::Packet(payload).assemble();
+    std::array<uint8_t, SCALPEL::Packet::MAX_PAYLOAD_LENGTH> scratch;
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        SCALPEL::PacketView view;
+        if (SCALPEL::PacketView::parse(assembled.data(), assembled.size(), view) == SCALPEL::PacketView::Status::Ok) {
+            benchmark::DoNotOptimize(view.decodePayload(scratch));
+        }
+        benchmark::ClobberMemory();
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_PacketView_ParseDecode)->Range(8, 28);
+
+// Per-frame cost of each integrity mode on a full 28-byte payload:
+// 0 = CRC-8, 1 = CRC-16, 2 = CRC-32C
+static void BM_Packet_AssembleIntoIntegrity(benchmark::State& state) {
+    SCALPEL::PacketFormat format;
+    format.integrity = static_cast<SCALPEL::PacketFormat::Integrity>(state.range(0));
+    SCALPEL::Packet packet(std::vector<uint8_t>(SCALPEL::Packet::MAX_PAYLOAD_LENGTH, 0xEF), format);
+    std::array<uint8_t, SCALPEL::Packet::MAX_PACKET_LENGTH> buffer;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(packet.assembleInto(buffer.data(), buffer.size()));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Packet_AssembleIntoIntegrity)->Arg(0)->Arg(1)->Arg(2);
+
+static void BM_PacketView_ParseIntegrity(benchmark::State& state) {
+    SCALPEL::PacketFormat format;
+    format.integrity = static_cast<SCALPEL::PacketFormat::Integrity>(state.range(0));
+    std::vector<uint8_t> assembled =
+        SCALPEL::Packet(std::vector<uint8_t>(SCALPEL::Packet::MAX_PAYLOAD_LENGTH, 0xEF), format).assemble();
+    for (auto _ : state) {
+        SCALPEL::PacketView view;
+        benchmark::DoNotOptimize(SCALPEL::PacketView::parse(assembled.data(), assembled.size(), view));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_PacketView_ParseIntegrity)->Arg(0)->Arg(1)->Arg(2);
+
+// Benchmark for FrameParser over a stream of 28-byte packets separated by
+// state.range(0) random noise bytes, fed in 64-byte serial reads
+static void BM_FrameParser_Stream(benchmark::State& state) {
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::vector<uint8_t> stream;
+    size_t packets = 0;
+    while (stream.size() < 16 << 10) {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            stream.push_back(static_cast<uint8_t>(byteDist(rng)));
+        }
+        std::vector<uint8_t> payload(28);
+        for (auto& byte : payload) {
+            byte = static_cast<uint8_t>(byteDist(rng));
+        }
+        std::vector<uint8_t> assembled = SCALPEL::Packet(payload).assemble();
+        stream.insert(stream.end(), assembled.begin(), assembled.end());
+        packets++;
+    }
+
+    uint64_t frames = 0;
+    SCALPEL::FrameParser parser([&frames](const SCALPEL::PacketView&, uint64_t) { frames++; });
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < stream.size(); offset += 64) {
+            parser.feed(SCALPEL::Span<const uint8_t>(stream.data() + offset, std::min<size_t>(64, stream.size() - offset)));
+        }
+    }
+    const SCALPEL::FrameParser::Stats& stats = parser.getStats();
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.counters["delivered"] = static_cast<double>(frames) / static_cast<double>(state.iterations() * packets);
+    state.counters["resyncs/pkt"] = static_cast<double>(stats.resyncs) / static_cast<double>(state.iterations() * packets);
+    state.counters["discarded"] = static_cast<double>(stats.bytesDiscarded) / static_cast<double>(stats.bytesConsumed);
+}
+BENCHMARK(BM_FrameParser_Stream)->Arg(0)->Arg(4)->Arg(32);
+
+// Benchmark for building a Packet from a payload view
+static void BM_Packet_Construct(benchmark::State& state) {
+    std::vector<uint8_t> payload(state.range(0), 0xEF);
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        SCALPEL::Packet packet{SCALPEL::Span<const uint8_t>(payload)};
+        benchmark::DoNotOptimize(packet);
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_Packet_Construct)->Range(8, 28);
+
+// Benchmark for copying packets into queue slots, which is now a flat
+// copy of the inline payload
+static void BM_Packet_Copy(benchmark::State& state) {
+    SCALPEL::Packet packet(std::vector<uint8_t>(28, 0xEF));
+    std::vector<SCALPEL::Packet> slots(64);
+    size_t slot = 0;
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        slots[slot] = packet;
+        slot = (slot + 1) % slots.size();
+        benchmark::ClobberMemory();
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_Packet_Copy);
+
+// Reed-Solomon parity for a full 28-byte FEC packet; state.range(0) parity bytes
+static void BM_ReedSolomon_Encode(benchmark::State& state) {
+    const SCALPEL::ReedSolomon& rs = SCALPEL::ReedSolomon::get(static_cast<uint8_t>(state.range(0)));
+    std::vector<uint8_t> message(33, 0xEF);
+    std::array<uint8_t, SCALPEL::ReedSolomon::MAX_PARITY> parity;
+    for (auto _ : state) {
+        rs.encode(message.data(), message.size(), parity.data());
+        benchmark::DoNotOptimize(parity);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * message.size()));
+}
+BENCHMARK(BM_ReedSolomon_Encode)->Arg(4)->Arg(8)->Arg(16);
+
+// Syndrome check of a clean codeword, the cost every received FEC packet pays
+static void BM_ReedSolomon_Syndromes(benchmark::State& state) {
+    const SCALPEL::ReedSolomon& rs = SCALPEL::ReedSolomon::get(static_cast<uint8_t>(state.range(0)));
+    std::vector<uint8_t> codeword(33 + rs.getParityBytes(), 0xEF);
+    rs.encode(codeword.data(), 33, codeword.data() + 33);
+    std::array<uint8_t, SCALPEL::ReedSolomon::MAX_PARITY> syndromes;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rs.computeSyndromes(codeword.data(), codeword.size(), syndromes.data()));
+    }
+}
+BENCHMARK(BM_ReedSolomon_Syndromes)->Arg(4)->Arg(8)->Arg(16);
+
+static void BM_ReedSolomon_SyndromesScalar(benchmark::State& state) {
+    const SCALPEL::ReedSolomon& rs = SCALPEL::ReedSolomon::get(static_cast<uint8_t>(state.range(0)));
+    std::vector<uint8_t> codeword(33 + rs.getParityBytes(), 0xEF);
+    rs.encode(codeword.data(), 33, codeword.data() + 33);
+    std::array<uint8_t, SCALPEL::ReedSolomon::MAX_PARITY> syndromes;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rs.computeSyndromesScalar(codeword.data(), codeword.size(), syndromes.data()));
+    }
+}
+BENCHMARK(BM_ReedSolomon_SyndromesScalar)->Arg(4)->Arg(8)->Arg(16);
+
+// Full correction of parity / 2 byte errors in a 28-byte FEC packet
+static void BM_ReedSolomon_DecodeWorstCase(benchmark::State& state) {
+    const SCALPEL::ReedSolomon& rs = SCALPEL::ReedSolomon::get(static_cast<uint8_t>(state.range(0)));
+    std::vector<uint8_t> clean(33 + rs.getParityBytes(), 0xEF);
+    rs.encode(clean.data(), 33, clean.data() + 33);
+    std::vector<uint8_t> damaged = clean;
+    for (size_t i = 0; i < rs.getParityBytes() / 2u; ++i) {
+        damaged[i * 3] ^= 0x5A;
+    }
+    std::vector<uint8_t> codeword(clean.size());
+    for (auto _ : state) {
+        std::copy(damaged.begin(), damaged.end(), codeword.begin());
+        benchmark::DoNotOptimize(rs.decode(codeword.data(), codeword.size()));
+    }
+}
+BENCHMARK(BM_ReedSolomon_DecodeWorstCase)->Arg(4)->Arg(8)->Arg(16);
+
+// Assemble and parse a 28-byte packet with state.range(0) parity bytes, the
+// per-packet cost of enabling FEC on a clean link
+static void BM_Packet_FecRoundTrip(benchmark::State& state) {
+    SCALPEL::Packet packet(std::vector<uint8_t>(28, 0xEF));
+    packet.setFormat(SCALPEL::PacketFormat{static_cast<uint8_t>(state.range(0))});
+    std::array<uint8_t, SCALPEL::Packet::MAX_PACKET_LENGTH> wire;
+    std::array<uint8_t, SCALPEL::Packet::MAX_PAYLOAD_LENGTH> scratch;
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        size_t length = packet.assembleInto(wire.data(), wire.size());
+        SCALPEL::PacketView view;
+        if (SCALPEL::PacketView::correct(wire.data(), length, packet.getFormat()) >= 0 &&
+            SCALPEL::PacketView::parse(wire.data(), length, view) == SCALPEL::PacketView::Status::Ok) {
+            benchmark::DoNotOptimize(view.decodePayload(scratch));
+        }
+        benchmark::ClobberMemory();
+    }
+    AllocationCounter::report(state, allocations);
+}
+BENCHMARK(BM_Packet_FecRoundTrip)->Arg(0)->Arg(4)->Arg(8)->Arg(16);
+
+// Gilbert-Elliott channel: bytes are corrupted with probability badErrorRate
+// while in the bad state, which is entered with probability enterBad per byte
+// and left with probability leaveBad (mean burst 1 / leaveBad bytes)
+static void applyBurstChannel(std::vector<uint8_t>& stream, uint32_t seed,
+                              double enterBad, double leaveBad, double badErrorRate) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    bool bad = false;
+    for (auto& byte : stream) {
+        bad = bad ? uniform(rng) >= leaveBad : uniform(rng) < enterBad;
+        if (bad && uniform(rng) < badErrorRate) {
+            byte ^= static_cast<uint8_t>(1 + rng() % 255);
+        }
+    }
+}
+
+// Frame delivery through interleaving depth state.range(0) on a bursty link.
+// Packets carry 28-byte payloads and 8 parity bytes (4 correctable bytes);
+// bursts average 12 bytes. state.range(1) enables slot correction in the
+// deinterleaver. latency_ms is the worst-case delay the interleaver adds at
+// 57600 baud: a packet can wait for depth - 1 later packets to be sent
+// before the receiver can restore it.
+static void BM_Interleaver_BurstChannel(benchmark::State& state) {
+    const size_t depth = static_cast<size_t>(state.range(0));
+    SCALPEL::PacketFormat format{8};
+    std::mt19937 rng(17);
+    const size_t packets = 2048;
+    size_t slotLength = SCALPEL::Packet(std::vector<uint8_t>(28), format).getAssembledLength();
+
+    std::vector<uint8_t> stream;
+    SCALPEL::Interleaver interleaver(depth, slotLength, [&stream](SCALPEL::Span<const uint8_t> block) {
+        stream.insert(stream.end(), block.begin(), block.end());
+    });
+    for (size_t i = 0; i < packets; ++i) {
+        std::vector<uint8_t> payload(28);
+        for (auto& byte : payload) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        interleaver.push(SCALPEL::Packet(payload, format).assemble());
+    }
+    interleaver.flush();
+    applyBurstChannel(stream, 23, 0.004, 1.0 / 12, 0.5);
+
+    uint64_t frames = 0;
+    SCALPEL::FrameParser parser([&frames](const SCALPEL::PacketView&, uint64_t) { frames++; });
+    SCALPEL::Deinterleaver deinterleaver(depth, slotLength, [&parser](SCALPEL::Span<const uint8_t> data) {
+        parser.feed(data);
+    });
+    if (state.range(1) != 0) {
+        deinterleaver.setSlotFormat(format);
+    }
+    std::vector<uint8_t> received(stream.size());
+    for (auto _ : state) {
+        // Frame parsing repairs packets in place, so start from the damaged copy
+        std::copy(stream.begin(), stream.end(), received.begin());
+        for (size_t offset = 0; offset < received.size(); offset += 64) {
+            deinterleaver.feed(SCALPEL::Span<const uint8_t>(received.data() + offset,
+                                                            std::min<size_t>(64, received.size() - offset)));
+        }
+        parser.reset();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.counters["delivered"] = static_cast<double>(frames) / static_cast<double>(state.iterations() * packets);
+    state.counters["latency_ms"] = static_cast<double>((depth - 1) * slotLength * 10) / 57600.0 * 1000.0;
+}
+BENCHMARK(BM_Interleaver_BurstChannel)->ArgsProduct({{1, 2, 4, 8, 16}, {0, 1}});
+
+// Messages per second an XBee link at 57600 baud can carry when packets wait
+// up to state.range(0) microseconds to share a Transmit Request. The offered
+// load alternates 28-byte telemetry with 4-byte commands and ACKs, one message
+// every 2 ms; every Transmit Request adds 18 bytes of API framing. The
+// measured time is the aggregator's own CPU cost per message.
+static void BM_FrameAggregator_XBeeLink(benchmark::State& state) {
+    using Clock = SCALPEL::FrameAggregator::Clock;
+    const size_t transmitRequestOverhead = 18;
+    const size_t rfDataLength = 256;
+    const double bytesPerSecond = 57600.0 / 10.0; // 8N1
+    const size_t messages = 4096;
+    const Clock::duration interval = std::chrono::milliseconds(2);
+
+    SCALPEL::Packet telemetry(std::vector<uint8_t>(28, 0x5A));
+    SCALPEL::Packet command(std::vector<uint8_t>(4, 0x11));
+
+    std::vector<Clock::time_point> added(messages);
+    size_t wireBytes = 0;
+    size_t sent = 0;
+    double waitedSeconds = 0.0;
+    Clock::time_point now{};
+    SCALPEL::FrameAggregator aggregator(rfDataLength, std::chrono::microseconds(state.range(0)),
+                                        [&](SCALPEL::Span<const SCALPEL::Packet> packets) {
+        wireBytes += transmitRequestOverhead;
+        for (const SCALPEL::Packet& packet : packets) {
+            wireBytes += packet.getAssembledLength();
+            waitedSeconds += std::chrono::duration<double>(now - added[sent++]).count();
+        }
+    });
+
+    for (auto _ : state) {
+        wireBytes = 0;
+        sent = 0;
+        waitedSeconds = 0.0;
+        Clock::time_point start{};
+        for (size_t i = 0; i < messages; ++i) {
+            Clock::time_point arrival = start + interval * static_cast<int64_t>(i);
+            // The send loop wakes at the deadline of a pending batch
+            if (aggregator.pending() != 0 && aggregator.deadline() <= arrival) {
+                now = aggregator.deadline();
+                aggregator.poll(now);
+            }
+            now = arrival;
+            added[i] = arrival;
+            aggregator.add(i % 2 == 0 ? telemetry : command, now);
+        }
+        aggregator.flush();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages));
+    state.counters["msgs/s@57600"] = static_cast<double>(messages) * bytesPerSecond / static_cast<double>(wireBytes);
+    state.counters["wait_ms"] = waitedSeconds * 1000.0 / static_cast<double>(messages);
+}
+BENCHMARK(BM_FrameAggregator_XBeeLink)->Arg(0)->Arg(2000)->Arg(5000)->Arg(20000)->Arg(50000);
+
+// Offline decoding of a recorded capture with a varying number of threads
+static void BM_CaptureDecoder_Threads(benchmark::State& state) {
+    static const std::vector<uint8_t> capture = [] {
+        std::vector<uint8_t> bytes;
+        CaptureGenerator().generate(bytes, size_t{64} << 20);
+        return bytes;
+    }();
+    SCALPEL::CaptureDecoder::Options options;
+    options.threads = static_cast<size_t>(state.range(0));
+    options.chunkLength = size_t{1} << 20;
+    SCALPEL::CaptureDecoder decoder(options);
+
+    uint64_t packets = 0;
+    for (auto _ : state) {
+        SCALPEL::FrameParser::Stats stats = decoder.decode(capture, nullptr);
+        packets += stats.framesParsed;
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * capture.size()));
+    state.counters["packets_per_second"] = benchmark::Counter(static_cast<double>(packets), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_CaptureDecoder_Threads)
+    ->RangeMultiplier(2)
+    ->Range(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Payload of length N with a START_BYTE in the middle, as telemetry often has
+template <size_t N>
+static std::array<uint8_t, N> makeFixedPayload() {
+    std::array<uint8_t, N> payload;
+    for (size_t i = 0; i < N; ++i) {
+        payload[i] = static_cast<uint8_t>(0x31 * i + 7);
+    }
+    payload[N / 2] = SCALPEL::Packet::START_BYTE;
+    return payload;
+}
+
+// Generic path: build a Packet from the payload and assemble it
+template <size_t N>
+static void BM_Generic_Encode(benchmark::State& state) {
+    std::array<uint8_t, N> payload = makeFixedPayload<N>();
+    std::array<uint8_t, SCALPEL::Packet::MAX_PACKET_LENGTH> frame;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(payload.data());
+        SCALPEL::Packet packet{SCALPEL::Span<const uint8_t>(payload)};
+        size_t length = packet.assembleInto(frame.data(), frame.size());
+        benchmark::DoNotOptimize(length);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_Generic_Encode, 4);
+BENCHMARK_TEMPLATE(BM_Generic_Encode, 12);
+BENCHMARK_TEMPLATE(BM_Generic_Encode, 28);
+
+template <size_t N>
+static void BM_FixedPacketCodec_Encode(benchmark::State& state) {
+    std::array<uint8_t, N> payload = makeFixedPayload<N>();
+    typename SCALPEL::FixedPacketCodec<N>::Frame frame;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(payload.data());
+        SCALPEL::FixedPacketCodec<N>::encode(payload.data(), frame.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_FixedPacketCodec_Encode, 4);
+BENCHMARK_TEMPLATE(BM_FixedPacketCodec_Encode, 12);
+BENCHMARK_TEMPLATE(BM_FixedPacketCodec_Encode, 28);
+
+// Generic path: validate with PacketView and decode the payload
+template <size_t N>
+static void BM_Generic_Decode(benchmark::State& state) {
+    typename SCALPEL::FixedPacketCodec<N>::Frame frame = SCALPEL::FixedPacketCodec<N>::encode(makeFixedPayload<N>());
+    std::array<uint8_t, N> payload;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frame.data());
+        SCALPEL::PacketView view;
+        if (SCALPEL::PacketView::parse(frame.data(), frame.size(), view) == SCALPEL::PacketView::Status::Ok) {
+            view.decodePayload(SCALPEL::Span<uint8_t>(payload));
+        }
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_Generic_Decode, 4);
+BENCHMARK_TEMPLATE(BM_Generic_Decode, 12);
+BENCHMARK_TEMPLATE(BM_Generic_Decode, 28);
+
+template <size_t N>
+static void BM_FixedPacketCodec_Decode(benchmark::State& state) {
+    typename SCALPEL::FixedPacketCodec<N>::Frame frame = SCALPEL::FixedPacketCodec<N>::encode(makeFixedPayload<N>());
+    std::array<uint8_t, N> payload;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frame.data());
+        SCALPEL::PacketView::Status status = SCALPEL::FixedPacketCodec<N>::decode(frame.data(), payload.data());
+        benchmark::DoNotOptimize(status);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_FixedPacketCodec_Decode, 4);
+BENCHMARK_TEMPLATE(BM_FixedPacketCodec_Decode, 12);
+BENCHMARK_TEMPLATE(BM_FixedPacketCodec_Decode, 28);
+
+// Table-driven SECDED header decode, including a correction
+static void BM_HeaderCode_Decode(benchmark::State& state) {
+    std::array<std::array<uint8_t, 2>, 64> headers;
+    for (size_t i = 0; i < headers.size(); ++i) {
+        SCALPEL::HeaderCode::encode(static_cast<uint8_t>(i % 29), static_cast<uint8_t>(i % 7), headers[i].data());
+        headers[i][i % 2] ^= static_cast<uint8_t>(1u << (i % 8));
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        uint8_t lengthField;
+        uint8_t cobsIndex;
+        int corrected = SCALPEL::HeaderCode::decode(headers[i++ % headers.size()].data(), lengthField, cobsIndex);
+        benchmark::DoNotOptimize(corrected);
+        benchmark::DoNotOptimize(lengthField);
+        benchmark::DoNotOptimize(cobsIndex);
+    }
+}
+BENCHMARK(BM_HeaderCode_Decode);
+
+// Frames delivered on a link flipping header bits; args are the header
+// protection (0 checksum, 1 SECDED) and the chance per packet of a flipped
+// header bit in percent
+static void BM_FrameParser_HeaderErrors(benchmark::State& state) {
+    auto protection = state.range(0) != 0 ? SCALPEL::PacketFormat::HeaderProtection::Secded
+                                          : SCALPEL::PacketFormat::HeaderProtection::Checksum;
+    SCALPEL::PacketFormat format;
+    format.headerProtection = protection;
+
+    const size_t packets = 1024;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<unsigned> bit(0, 15);
+    std::vector<uint8_t> stream;
+    for (size_t i = 0; i < packets; ++i) {
+        std::vector<uint8_t> frame = SCALPEL::Packet(std::vector<uint8_t>(20, static_cast<uint8_t>(i)), format).assemble();
+        if (percent(rng) < state.range(1)) {
+            unsigned flip = bit(rng);
+            frame[1 + flip / 8] ^= static_cast<uint8_t>(1u << (flip % 8));
+        }
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+
+    size_t delivered = 0;
+    for (auto _ : state) {
+        SCALPEL::FrameParser parser([&delivered](const SCALPEL::PacketView&, uint64_t) { delivered++; }, protection);
+        parser.feed(stream);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.counters["delivered"] = static_cast<double>(delivered) / static_cast<double>(state.iterations() * packets);
+}
+BENCHMARK(BM_FrameParser_HeaderErrors)->ArgsProduct({{0, 1}, {0, 1, 10}});
+
+#if defined(__unix__) || defined(__APPLE__)
+// Transmit path for a radio frame of state.range(0) packets, written to
+// /dev/null. "copied/frame" counts bytes moved between user-space buffers
+// without being transformed, i.e. everything but the COBS encode itself.
+//
+// Layered: each layer allocates a vector and copies the inner one into it
+static void BM_TransmitPath_Layered(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> payload(SCALPEL::Packet::MAX_PAYLOAD_LENGTH, 0xEF);
+    int fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    size_t copied = 0;
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        std::vector<uint8_t> frame(17, 0xFF);
+        for (size_t i = 0; i < count; ++i) {
+            SCALPEL::Packet packet(payload);
+            std::vector<uint8_t> assembled = packet.assemble();
+            frame.insert(frame.end(), assembled.begin(), assembled.end());
+            copied += payload.size() + assembled.size();
+        }
+        uint8_t checksum = 0;
+        for (size_t i = 3; i < frame.size(); ++i) {
+            checksum = static_cast<uint8_t>(checksum + frame[i]);
+        }
+        frame.push_back(static_cast<uint8_t>(0xFF - checksum));
+        benchmark::DoNotOptimize(::write(fd, frame.data(), frame.size()));
+    }
+    AllocationCounter::report(state, allocations);
+    state.counters["copied/frame"] = static_cast<double>(copied) / static_cast<double>(state.iterations());
+    ::close(fd);
+}
+BENCHMARK(BM_TransmitPath_Layered)->Arg(1)->Arg(8);
+
+// Gather: header, packets assembled in place and trailer as segments of one
+// GatherFrame, checksummed as they are added and sent with one writev
+static void BM_TransmitPath_Gather(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> payload(SCALPEL::Packet::MAX_PAYLOAD_LENGTH, 0xEF);
+    int fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    size_t copied = 0;
+    SCALPEL::GatherFrame frame;
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        frame.clear();
+        SCALPEL::Span<uint8_t> header = frame.reserve(17);
+        std::fill(header.begin(), header.end(), 0xFF);
+        uint8_t checksum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            SCALPEL::Packet packet(payload);
+            copied += payload.size();
+            for (uint8_t byte : frame.appendPacket(packet)) {
+                checksum = static_cast<uint8_t>(checksum + byte);
+            }
+        }
+        uint8_t trailer = static_cast<uint8_t>(0xFF - checksum);
+        frame.append(SCALPEL::Span<const uint8_t>(&trailer, 1));
+        benchmark::DoNotOptimize(frame.writeTo(fd));
+    }
+    AllocationCounter::report(state, allocations);
+    state.counters["copied/frame"] = static_cast<double>(copied) / static_cast<double>(state.iterations());
+    ::close(fd);
+}
+BENCHMARK(BM_TransmitPath_Gather)->Arg(1)->Arg(8);
+
+// Gather over a burst already assembled by assembleBatch: the packets are
+// referenced in place between an inline header and trailer
+static void BM_TransmitPath_GatherReference(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> payload(SCALPEL::Packet::MAX_PAYLOAD_LENGTH, 0xEF);
+    std::vector<SCALPEL::Span<const uint8_t>> payloads(count, SCALPEL::Span<const uint8_t>(payload));
+    SCALPEL::Packet::OutputBuffer assembled;
+    int fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    SCALPEL::GatherFrame frame;
+    uint64_t allocations = AllocationCounter::allocations();
+    for (auto _ : state) {
+        SCALPEL::Packet::assembleBatch(payloads, assembled);
+        frame.clear();
+        SCALPEL::Span<uint8_t> header = frame.reserve(17);
+        std::fill(header.begin(), header.end(), 0xFF);
+        frame.appendReference(assembled.bytes);
+        uint8_t checksum = 0;
+        for (uint8_t byte : assembled.bytes) {
+            checksum = static_cast<uint8_t>(checksum + byte);
+        }
+        uint8_t trailer = static_cast<uint8_t>(0xFF - checksum);
+        frame.append(SCALPEL::Span<const uint8_t>(&trailer, 1));
+        benchmark::DoNotOptimize(frame.writeTo(fd));
+    }
+    AllocationCounter::report(state, allocations);
+    state.counters["copied/frame"] = 0;
+    ::close(fd);
+}
+BENCHMARK(BM_TransmitPath_GatherReference)->Arg(1)->Arg(8);
+#endif
+
 #ifndef COMBINED_BENCHMARK
 BENCHMARK_MAIN();
 #endif
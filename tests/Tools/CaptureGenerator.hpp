@@ -0,0 +1,65 @@
+#ifndef CAPTUREGENERATOR_HPP
+#define CAPTUREGENERATOR_HPP
+
+#include "SCALPEL/Packet.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Synthetic recorded link streams for the offline decoder: assembled packets
+// of random length and content, with the damage a real capture shows. Some
+// packets get one byte flipped and some are followed by line noise.
+class CaptureGenerator {
+public:
+    struct Options {
+        uint32_t seed = 1;
+        uint8_t fecParity = 0;     // Reed-Solomon parity of every packet
+        double corruptRate = 0.01; // Fraction of packets with a flipped byte
+        double noiseRate = 0.01;   // Fraction of packets followed by noise
+    };
+
+    CaptureGenerator() : CaptureGenerator(Options()) {}
+    explicit CaptureGenerator(Options options)
+        : options(options), rng(options.seed), format{options.fecParity} {}
+
+    // Append packets to out until it holds at least length bytes
+    void generate(std::vector<uint8_t>& out, size_t length) {
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::uniform_int_distribution<int> payloadLength(1, SCALPEL::Packet::MAX_PAYLOAD_LENGTH);
+        std::uniform_int_distribution<int> noiseLength(1, 16);
+        std::uniform_real_distribution<double> roll(0.0, 1.0);
+        uint8_t payload[SCALPEL::Packet::MAX_PAYLOAD_LENGTH];
+        uint8_t packet[SCALPEL::Packet::MAX_PACKET_LENGTH];
+
+        while (out.size() < length) {
+            size_t payloadSize = static_cast<size_t>(payloadLength(rng));
+            for (size_t i = 0; i < payloadSize; ++i) {
+                payload[i] = static_cast<uint8_t>(byte(rng));
+            }
+            SCALPEL::Packet assembled(SCALPEL::Span<const uint8_t>(payload, payloadSize), format);
+            size_t packetSize = assembled.assembleInto(packet, sizeof(packet));
+            if (roll(rng) < options.corruptRate) {
+                std::uniform_int_distribution<size_t> position(1, packetSize - 1);
+                packet[position(rng)] ^= static_cast<uint8_t>(1 + byte(rng) % 255);
+            }
+            out.insert(out.end(), packet, packet + packetSize);
+            packetsGenerated++;
+
+            if (roll(rng) < options.noiseRate) {
+                for (int i = noiseLength(rng); i > 0; --i) {
+                    out.push_back(static_cast<uint8_t>(byte(rng)));
+                }
+            }
+        }
+    }
+
+    uint64_t getPacketsGenerated() const { return packetsGenerated; }
+
+private:
+    Options options;
+    std::mt19937 rng;
+    SCALPEL::PacketFormat format;
+    uint64_t packetsGenerated = 0;
+};
+
+#endif // CAPTUREGENERATOR_HPP
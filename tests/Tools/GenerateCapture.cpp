@@ -0,0 +1,51 @@
+// Writes a synthetic capture for the offline decoder, e.g.
+//   GenerateCapture capture.bin 1024
+// for a 1 GB stream of packets with occasional damage and line noise.
+
+#include "Tools/CaptureGenerator.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output> <megabytes> [seed] [fec parity]" << std::endl;
+        return 1;
+    }
+
+    std::ofstream output(argv[1], std::ios::binary | std::ios::trunc);
+    if (!output) {
+        std::cerr << "Cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    const size_t total = std::stoull(argv[2]) << 20;
+    CaptureGenerator::Options options;
+    if (argc > 3) {
+        options.seed = static_cast<uint32_t>(std::stoul(argv[3]));
+    }
+    if (argc > 4) {
+        options.fecParity = static_cast<uint8_t>(std::stoul(argv[4]));
+    }
+    CaptureGenerator generator(options);
+
+    // Generate in blocks so a large capture never sits in memory
+    const size_t blockLength = size_t{1} << 20;
+    std::vector<uint8_t> block;
+    size_t written = 0;
+    while (written < total) {
+        block.clear();
+        generator.generate(block, std::min(blockLength, total - written));
+        output.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+        written += block.size();
+    }
+    if (!output) {
+        std::cerr << "Write to " << argv[1] << " failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << written << " bytes, " << generator.getPacketsGenerated() << " packets" << std::endl;
+    return 0;
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "SCALPEL/COBS.hpp"
 #include "SCALPEL/Packet.hpp"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <stdexcept>
 
 using namespace SCALPEL;
 
@@ -126,3 +130,105 @@ TEST_F(COBSTest, EncodeLargeInput) {
     EXPECT_EQ(result.encodedPayload.size(), 1003);
     EXPECT_EQ(result.index, 1);
 }
+
+TEST_F(COBSTest, EncodeIntoMatchesEncode) {
+    std::vector<uint8_t> input{Packet::START_BYTE, 1, 2, Packet::START_BYTE, 3, Packet::START_BYTE};
+    std::array<uint8_t, COBS::maxEncodedLength(6)> buffer;
+    auto result = cobs.encodeInto(input, buffer);
+    auto expected = cobs.encode(input);
+    EXPECT_EQ(std::vector<uint8_t>(buffer.begin(), buffer.begin() + result.length), expected.encodedPayload);
+    EXPECT_EQ(result.index, expected.index);
+}
+
+TEST_F(COBSTest, EncodeIntoBufferTooSmall) {
+    std::vector<uint8_t> input{1, 2, 3, 4, 5};
+    std::array<uint8_t, 5> buffer;
+    EXPECT_THROW(cobs.encodeInto(input, buffer), std::length_error);
+}
+
+TEST_F(COBSTest, MaxEncodedLengthBoundsEncoding) {
+    for (size_t length : {0u, 1u, 253u, 254u, 255u, 508u, 1000u}) {
+        std::vector<uint8_t> input(length, 1);
+        EXPECT_LE(cobs.encode(input).encodedPayload.size(), COBS::maxEncodedLength(length));
+    }
+}
+
+TEST_F(COBSTest, DecodeIntoRoundTrip) {
+    std::vector<uint8_t> input{1, Packet::START_BYTE, 2, 3, Packet::START_BYTE, 4};
+    auto encoded = cobs.encode(input);
+    std::array<uint8_t, 16> buffer;
+    size_t length = cobs.decodeInto(encoded.encodedPayload, encoded.index, buffer);
+    EXPECT_EQ(std::vector<uint8_t>(buffer.begin(), buffer.begin() + length), input);
+}
+
+TEST_F(COBSTest, DecodeIntoBufferTooSmall) {
+    std::vector<uint8_t> encoded{6, 1, 2, 3, 4, 5};
+    std::array<uint8_t, 4> buffer;
+    EXPECT_THROW(cobs.decodeInto(encoded, 0, buffer), std::length_error);
+}
+
+// Byte-at-a-time encoder the vectorized one replaced, kept as a reference.
+static bool referenceEncode(const std::vector<uint8_t>& input, std::vector<uint8_t>& output, uint8_t& index) {
+    output.assign(1, 0);
+    size_t code_ptr = 0;
+    uint8_t code = 1;
+    index = 0;
+    for (uint8_t byte : input) {
+        if (byte == Packet::START_BYTE) {
+            output[code_ptr] = code;
+            code = 1;
+            code_ptr = output.size();
+            output.push_back(0);
+            index++;
+        } else {
+            output.push_back(byte);
+            code++;
+            if (code == 0xFF) {
+                output[code_ptr] = code;
+                code = 1;
+                code_ptr = output.size();
+                output.push_back(0);
+            }
+        }
+    }
+    output[code_ptr] = code;
+    for (uint8_t byte : output) {
+        if (byte == Packet::START_BYTE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_F(COBSTest, EncodeMatchesReferenceOnRandomInput) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::uniform_int_distribution<size_t> lengthDist(0, 2048);
+    // Vary how often START_BYTE appears so both short and maximum length runs occur
+    const int startPercents[] = {0, 1, 5, 50};
+
+    for (int trial = 0; trial < 400; ++trial) {
+        std::bernoulli_distribution isStart(startPercents[trial % 4] / 100.0);
+        std::vector<uint8_t> input(lengthDist(rng));
+        for (auto& byte : input) {
+            byte = isStart(rng) ? Packet::START_BYTE : static_cast<uint8_t>(byteDist(rng));
+        }
+
+        std::vector<uint8_t> expected;
+        uint8_t expectedIndex = 0;
+        if (referenceEncode(input, expected, expectedIndex)) {
+            auto result = cobs.encode(input);
+            EXPECT_EQ(result.encodedPayload, expected);
+            EXPECT_EQ(result.index, expectedIndex);
+        } else {
+            EXPECT_THROW(cobs.encode(input), std::runtime_error);
+        }
+    }
+}
+
+TEST_F(COBSTest, EncodeRejectsRunEncodingToStartByte) {
+    // A block of START_BYTE - 1 data bytes gets START_BYTE as its code
+    std::vector<uint8_t> input(Packet::START_BYTE - 1, 0x01);
+    EXPECT_THROW(cobs.encode(input), std::runtime_error);
+}
+
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/CaptureDecoder.hpp"
+#include "Tools/CaptureGenerator.hpp"
+#include <cstdio>
+#include <fstream>
+
+namespace SCALPEL {
+namespace {
+
+class CaptureDecoderTest : public ::testing::Test {
+protected:
+    struct Decoded {
+        std::vector<std::vector<uint8_t>> payloads;
+        std::vector<uint64_t> offsets;
+        FrameParser::Stats stats;
+    };
+
+    static std::vector<uint8_t> makeCapture(size_t length, uint8_t fecParity = 0) {
+        CaptureGenerator::Options options;
+        options.fecParity = fecParity;
+        options.corruptRate = 0.05;
+        options.noiseRate = 0.05;
+        CaptureGenerator generator(options);
+        std::vector<uint8_t> capture;
+        generator.generate(capture, length);
+        return capture;
+    }
+
+    // One FrameParser over the whole capture, as the decoder must reproduce
+    static Decoded decodeSequentially(const std::vector<uint8_t>& capture) {
+        Decoded decoded;
+        FrameParser parser([&decoded](const PacketView& frame, uint64_t offset) {
+            decoded.payloads.push_back(frame.toPacket().getPayloadVector());
+            decoded.offsets.push_back(offset);
+        });
+        parser.feed(capture);
+        parser.reset();
+        decoded.stats = parser.getStats();
+        return decoded;
+    }
+
+    static Decoded decodeInParallel(const std::vector<uint8_t>& capture, CaptureDecoder::Options options,
+                                    std::vector<size_t>* order = nullptr) {
+        Decoded decoded;
+        CaptureDecoder decoder(options);
+        decoded.stats = decoder.decode(capture, [&](CaptureDecoder::ChunkResult& chunk) {
+            if (order != nullptr) {
+                order->push_back(chunk.index);
+            }
+            for (size_t i = 0; i < chunk.packets.size(); ++i) {
+                decoded.payloads.push_back(chunk.packets[i].getPayloadVector());
+                decoded.offsets.push_back(chunk.packetOffsets[i]);
+            }
+        });
+        return decoded;
+    }
+
+    static void expectSameDecoding(const Decoded& actual, const Decoded& expected) {
+        EXPECT_EQ(actual.payloads, expected.payloads);
+        EXPECT_EQ(actual.offsets, expected.offsets);
+        EXPECT_EQ(actual.stats.bytesConsumed, expected.stats.bytesConsumed);
+        EXPECT_EQ(actual.stats.framesParsed, expected.stats.framesParsed);
+        EXPECT_EQ(actual.stats.bytesDiscarded, expected.stats.bytesDiscarded);
+        EXPECT_EQ(actual.stats.resyncs, expected.stats.resyncs);
+        EXPECT_EQ(actual.stats.bytesCorrected, expected.stats.bytesCorrected);
+    }
+};
+
+TEST_F(CaptureDecoderTest, MatchesSequentialParser) {
+    std::vector<uint8_t> capture = makeCapture(200000);
+    Decoded expected = decodeSequentially(capture);
+    ASSERT_GT(expected.stats.resyncs, 0u);
+
+    // Small chunks put many boundaries inside packets and noise
+    for (size_t threads : {1u, 2u, 4u}) {
+        for (size_t chunkLength : {size_t{37}, size_t{1000}, size_t{65536}}) {
+            CaptureDecoder::Options options;
+            options.threads = threads;
+            options.chunkLength = chunkLength;
+            expectSameDecoding(decodeInParallel(capture, options), expected);
+        }
+    }
+}
+
+TEST_F(CaptureDecoderTest, MatchesSequentialParserWithFec) {
+    std::vector<uint8_t> capture = makeCapture(100000, 8);
+    Decoded expected = decodeSequentially(capture);
+    ASSERT_GT(expected.stats.bytesCorrected, 0u);
+
+    CaptureDecoder::Options options;
+    options.threads = 4;
+    options.chunkLength = 500;
+    expectSameDecoding(decodeInParallel(capture, options), expected);
+}
+
+TEST_F(CaptureDecoderTest, DeliversChunksInOrder) {
+    std::vector<uint8_t> capture = makeCapture(100000);
+    CaptureDecoder::Options options;
+    options.threads = 4;
+    options.chunkLength = 1000;
+    options.maxChunksInFlight = 3;
+
+    std::vector<size_t> order;
+    decodeInParallel(capture, options, &order);
+    CaptureDecoder decoder(options);
+    std::vector<uint64_t> boundaries = decoder.chunkBoundaries(capture);
+    ASSERT_EQ(order.size(), boundaries.size() - 1);
+    for (size_t i = 0; i < order.size(); ++i) {
+        EXPECT_EQ(order[i], i);
+        EXPECT_EQ(capture[boundaries[i]], i == 0 ? capture[0] : Packet::START_BYTE);
+    }
+}
+
+TEST_F(CaptureDecoderTest, EmptyCapture) {
+    CaptureDecoder decoder;
+    size_t chunks = 0;
+    FrameParser::Stats stats = decoder.decode(Span<const uint8_t>(), [&chunks](CaptureDecoder::ChunkResult&) {
+        chunks++;
+    });
+    EXPECT_EQ(chunks, 0u);
+    EXPECT_EQ(stats.bytesConsumed, 0u);
+}
+
+TEST_F(CaptureDecoderTest, CallbackExceptionStopsDecoding) {
+    std::vector<uint8_t> capture = makeCapture(100000);
+    CaptureDecoder::Options options;
+    options.threads = 4;
+    options.chunkLength = 1000;
+    CaptureDecoder decoder(options);
+
+    size_t chunks = 0;
+    EXPECT_THROW(decoder.decode(capture, [&chunks](CaptureDecoder::ChunkResult&) {
+        if (++chunks == 5) {
+            throw std::runtime_error("stop");
+        }
+    }), std::runtime_error);
+    EXPECT_EQ(chunks, 5u);
+}
+
+TEST_F(CaptureDecoderTest, DecodesMappedFile) {
+    std::vector<uint8_t> capture = makeCapture(50000);
+    std::string path = ::testing::TempDir() + "capture_decoder_test.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(capture.data()), static_cast<std::streamsize>(capture.size()));
+    }
+
+    CaptureDecoder::Options options;
+    options.threads = 2;
+    options.chunkLength = 4096;
+    CaptureDecoder decoder(options);
+    FrameParser::Stats stats = decoder.decodeFile(path, nullptr);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(stats.framesParsed, decodeSequentially(capture).stats.framesParsed);
+    EXPECT_THROW(decoder.decodeFile(path, nullptr), std::runtime_error);
+}
+
+TEST_F(CaptureDecoderTest, RejectsZeroChunkLength) {
+    CaptureDecoder::Options options;
+    options.chunkLength = 0;
+    EXPECT_THROW(CaptureDecoder decoder(options), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace SCALPEL
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "SCALPEL/Checksum.hpp"
+#include <bitset>
+#include <random>
+#include <vector>
 
 namespace SCALPEL {
 namespace {
@@ -22,6 +25,82 @@ TEST_F(ChecksumTest, ValidateCRC8) {
     EXPECT_FALSE(Checksum::validateCRC8(incorrectCRC, testData, sizeof(testData)));
 }
 
+TEST_F(ChecksumTest, CRC8EnginesMatchBitwise) {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> dis(0, 255);
+    std::vector<uint8_t> buffer(600);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(dis(gen));
+    }
+
+    // Cover every tail length of the slice loops and unaligned starts.
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t length = 0; length <= 520; ++length) {
+            const uint8_t* data = buffer.data() + offset;
+            uint8_t expected = Checksum::calculateCRC8Bitwise(data, length);
+            ASSERT_EQ(Checksum::calculateCRC8Table(data, length), expected) << "length " << length;
+            ASSERT_EQ(Checksum::calculateCRC8Sliced(data, length), expected) << "length " << length;
+            ASSERT_EQ(Checksum::calculateCRC8(data, length), expected) << "length " << length;
+        }
+    }
+}
+
+TEST_F(ChecksumTest, CRC8CarrylessMultiplyMatchesBitwise) {
+    std::mt19937 gen(4321);
+    std::uniform_int_distribution<int> dis(0, 255);
+    std::vector<uint8_t> buffer(4200);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(dis(gen));
+    }
+
+    // Lengths around every fold boundary plus long runs through the 4-way loop.
+    for (size_t offset = 0; offset < 3; ++offset) {
+        for (size_t length = 0; length <= 4096; length += (length < 600 ? 1 : 61)) {
+            const uint8_t* data = buffer.data() + offset;
+            uint8_t expected = Checksum::calculateCRC8Bitwise(data, length);
+            ASSERT_EQ(Checksum::calculateCRC8CLMUL(data, length), expected) << "length " << length;
+            ASSERT_EQ(Checksum::calculateCRC8(data, length), expected) << "length " << length;
+        }
+    }
+}
+
+TEST_F(ChecksumTest, WideCRCCheckValues) {
+    // Standard check values over the ASCII digits "123456789"
+    const uint8_t digits[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    EXPECT_EQ(Checksum::calculateCRC16(digits, sizeof(digits)), 0x29B1);
+    EXPECT_EQ(Checksum::calculateCRC32C(digits, sizeof(digits)), 0xE3069283u);
+    EXPECT_EQ(Checksum::calculateCRC32CTable(digits, sizeof(digits)), 0xE3069283u);
+    EXPECT_EQ(Checksum::calculate(PacketFormat::Integrity::Crc16, digits, sizeof(digits)), 0x29B1u);
+    EXPECT_EQ(Checksum::calculate(PacketFormat::Integrity::Crc32c, digits, sizeof(digits)), 0xE3069283u);
+    EXPECT_EQ(Checksum::calculate(PacketFormat::Integrity::Crc8, digits, sizeof(digits)),
+              Checksum::calculateCRC8(digits, sizeof(digits)));
+}
+
+TEST_F(ChecksumTest, CRC32CEnginesMatchAndUpdatesChain) {
+    std::mt19937 gen(77);
+    std::uniform_int_distribution<int> dis(0, 255);
+    std::vector<uint8_t> buffer(300);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(dis(gen));
+    }
+
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t length = 0; length <= 260; ++length) {
+            const uint8_t* data = buffer.data() + offset;
+            uint32_t expected = Checksum::calculateCRC32CTable(data, length);
+            ASSERT_EQ(Checksum::calculateCRC32C(data, length), expected) << "length " << length;
+
+            // Feeding the data in two pieces gives the same result
+            size_t split = length / 3;
+            uint32_t crc32c = Checksum::updateCRC32C(0xFFFFFFFF, data, split);
+            ASSERT_EQ(~Checksum::updateCRC32C(crc32c, data + split, length - split), expected);
+            uint16_t crc16 = Checksum::updateCRC16(0xFFFF, data, split);
+            ASSERT_EQ(Checksum::updateCRC16(crc16, data + split, length - split),
+                      Checksum::calculateCRC16(data, length));
+        }
+    }
+}
+
 TEST_F(ChecksumTest, Calculate2BitChecksumSingleByte) {
     EXPECT_EQ(Checksum::calculate2BitChecksum(0x00), 0);  // No bits set
     EXPECT_EQ(Checksum::calculate2BitChecksum(0xFF), 0);  // All bits set (8 % 4 = 0)
@@ -56,6 +135,32 @@ TEST_F(ChecksumTest, Calculate2BitChecksumMultipleBytes) {
     EXPECT_EQ(Checksum::calculate2BitChecksum(mixedData, sizeof(mixedData)), 2);
 }
 
+TEST_F(ChecksumTest, Calculate2BitChecksumMatchesBitCount) {
+    std::mt19937 gen(99);
+    std::uniform_int_distribution<int> dis(0, 255);
+    std::vector<uint8_t> buffer(400);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(dis(gen));
+    }
+
+    for (size_t offset = 0; offset < 4; ++offset) {
+        size_t bits = 0;
+        for (size_t length = 0; offset + length <= buffer.size(); ++length) {
+            const uint8_t* data = buffer.data() + offset;
+            ASSERT_EQ(Checksum::calculate2BitChecksum(data, length), bits % 4) << "length " << length;
+            ASSERT_EQ(Checksum::calculate2BitChecksumScalar(data, length), bits % 4) << "length " << length;
+            if (offset + length < buffer.size()) {
+                bits += std::bitset<8>(data[length]).count();
+            }
+        }
+    }
+
+    for (int byte = 0; byte < 256; ++byte) {
+        EXPECT_EQ(Checksum::calculate2BitChecksum(static_cast<uint8_t>(byte)),
+                  std::bitset<8>(byte).count() % 4);
+    }
+}
+
 TEST_F(ChecksumTest, EdgeCases) {
     // Test with empty data
     EXPECT_EQ(Checksum::calculateCRC8(nullptr, 0), 0x00);
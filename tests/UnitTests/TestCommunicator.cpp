@@ -0,0 +1,466 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/Communicator.hpp"
+#include "SCALPEL/EpollTransport.hpp"
+#include "SCALPEL/SerialDevice.hpp"
+#include "SCALPEL/UringTransport.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace SCALPEL {
+namespace {
+
+// Collects everything a Communicator receives
+class Received {
+public:
+    Communicator::ReceiveCallback callback() {
+        return [this](const std::vector<uint8_t>& data) {
+            std::lock_guard<std::mutex> lock(mutex);
+            bytes.insert(bytes.end(), data.begin(), data.end());
+            arrived.notify_all();
+        };
+    }
+
+    // Wait until count bytes have arrived and return them
+    std::vector<uint8_t> waitFor(size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        arrived.wait_for(lock, std::chrono::seconds(5), [&] { return bytes.size() >= count; });
+        return bytes;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable arrived;
+    std::vector<uint8_t> bytes;
+};
+
+std::pair<SerialDevice, SerialDevice> openPipe() {
+    int fds[2];
+    EXPECT_EQ(::pipe(fds), 0);
+    return {SerialDevice(fds[0]), SerialDevice(fds[1])};
+}
+
+// Writes a transport's loop has made to its device
+uint64_t writesMade(const Transport* transport) {
+    if (auto epoll = dynamic_cast<const EpollTransport*>(transport)) {
+        return epoll->getStats().writes;
+    }
+    if (auto uring = dynamic_cast<const UringTransport*>(transport)) {
+        return uring->getStats().writes;
+    }
+    return 0;
+}
+
+// Wait until the loop has finished with every queued frame
+void waitForEmptyQueue(const Communicator& communicator) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (communicator.getQueueDepth() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+// A transport whose device fails as soon as its loop starts
+class FailingTransport : public Transport {
+public:
+    void run(Handler&) override {
+        throw std::system_error(EIO, std::generic_category(), "device lost");
+    }
+    void notify() override {}
+    void stop() override {}
+};
+
+// A transport whose device never takes output, so the queue only fills
+class StalledTransport : public Transport {
+public:
+    void run(Handler&) override {
+        std::unique_lock<std::mutex> lock(mutex);
+        stopped.wait(lock, [this] { return stopping; });
+        stopping = false;
+    }
+    void notify() override {}
+    void stop() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        stopped.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable stopped;
+    bool stopping = false;
+};
+
+enum class Backend { Epoll, Uring };
+
+// Runs each test against every transport backend
+class CommunicatorTest : public ::testing::TestWithParam<Backend> {
+protected:
+    void SetUp() override {
+        if (GetParam() == Backend::Uring && !UringTransport::isSupported()) {
+            GTEST_SKIP() << "io_uring unavailable";
+        }
+    }
+
+    std::unique_ptr<Transport> makeTransport(SerialDevice device) {
+        if (GetParam() == Backend::Uring) {
+            return std::make_unique<UringTransport>(std::move(device));
+        }
+        return std::make_unique<EpollTransport>(std::move(device));
+    }
+
+    std::unique_ptr<Transport> makeTransport(SerialDevice input, SerialDevice output) {
+        if (GetParam() == Backend::Uring) {
+            return std::make_unique<UringTransport>(std::move(input), std::move(output));
+        }
+        return std::make_unique<EpollTransport>(std::move(input), std::move(output));
+    }
+};
+
+TEST_P(CommunicatorTest, ExchangesDataOverPty) {
+    auto pty = SerialDevice::openPtyPair();
+    Received atGround;
+    Received atRocket;
+    Communicator ground(atGround.callback(), makeTransport(std::move(pty.first)));
+    Communicator rocket(atRocket.callback(), makeTransport(std::move(pty.second)));
+    ground.start();
+    rocket.start();
+
+    // Bytes a tty would normally translate or act on must pass unchanged
+    std::vector<uint8_t> command = {0x7E, '\r', '\n', 0x03, 0x11, 0x13, 0x00, 0xFF};
+    std::vector<uint8_t> telemetry = {1, 2, 3, 4, 5};
+    ground.send(command);
+    ground.send(telemetry);
+    rocket.send(telemetry);
+
+    std::vector<uint8_t> expected = command;
+    expected.insert(expected.end(), telemetry.begin(), telemetry.end());
+    EXPECT_EQ(atRocket.waitFor(expected.size()), expected);
+    EXPECT_EQ(atGround.waitFor(telemetry.size()), telemetry);
+
+    ground.stop();
+    rocket.stop();
+}
+
+TEST_P(CommunicatorTest, WritesLargeQueueThroughFullPipe) {
+    // Each side writes one pipe and reads the other
+    auto up = openPipe();
+    auto down = openPipe();
+    int rocketInput = up.first.fd();
+    Received atGround;
+    Received atRocket;
+    Communicator ground(atGround.callback(), makeTransport(std::move(down.first), std::move(up.second)));
+    Communicator rocket(atRocket.callback(), makeTransport(std::move(up.first), std::move(down.second)));
+
+    // Queued before start and far beyond the shrunken pipe's capacity, so
+    // the loop has to wait for write readiness part way through
+    ASSERT_GE(::fcntl(rocketInput, F_SETPIPE_SZ, 4096), 0);
+    std::vector<uint8_t> expected;
+    for (int i = 0; i < 200; ++i) {
+        std::vector<uint8_t> frame(Communicator::MAX_FRAME_LENGTH - i % 7, static_cast<uint8_t>(i));
+        ground.send(frame);
+        expected.insert(expected.end(), frame.begin(), frame.end());
+    }
+    ground.start();
+    rocket.start();
+
+    // More than the queue holds, sent while the loop drains it
+    for (int i = 0; i < 1000; ++i) {
+        std::vector<uint8_t> frame(100, static_cast<uint8_t>(i));
+        ground.send(frame);
+        expected.insert(expected.end(), frame.begin(), frame.end());
+    }
+
+    EXPECT_EQ(atRocket.waitFor(expected.size()), expected);
+
+    ground.stop();
+    rocket.stop();
+}
+
+TEST_P(CommunicatorTest, DeliversEveryFrameFromConcurrentSenders) {
+    constexpr int SENDERS = 4;
+    constexpr uint32_t FRAMES = 5000;
+    auto pty = SerialDevice::openPtyPair();
+    Received atRocket;
+    Communicator ground([](const std::vector<uint8_t>&) {}, makeTransport(std::move(pty.first)));
+    Communicator rocket(atRocket.callback(), makeTransport(std::move(pty.second)));
+    ground.start();
+    rocket.start();
+
+    // Fixed 5-byte frames: sender id, then that sender's frame number
+    std::vector<std::thread> senders;
+    for (int id = 0; id < SENDERS; ++id) {
+        senders.emplace_back([&ground, id] {
+            for (uint32_t i = 0; i < FRAMES; ++i) {
+                uint8_t frame[5] = {static_cast<uint8_t>(id)};
+                std::memcpy(frame + 1, &i, sizeof(i));
+                ground.send(Span<const uint8_t>(frame, sizeof(frame)));
+            }
+        });
+    }
+    for (std::thread& sender : senders) {
+        sender.join();
+    }
+
+    std::vector<uint8_t> bytes = atRocket.waitFor(SENDERS * FRAMES * 5);
+    ASSERT_EQ(bytes.size(), SENDERS * FRAMES * 5);
+    std::vector<uint32_t> next(SENDERS, 0);
+    for (size_t offset = 0; offset < bytes.size(); offset += 5) {
+        uint32_t number;
+        std::memcpy(&number, &bytes[offset + 1], sizeof(number));
+        ASSERT_LT(bytes[offset], SENDERS);
+        ASSERT_EQ(number, next[bytes[offset]]++);
+    }
+
+    ground.stop();
+    rocket.stop();
+}
+
+TEST_P(CommunicatorTest, RestartsAfterStop) {
+    auto pty = SerialDevice::openPtyPair();
+    Received atRocket;
+    Communicator ground([](const std::vector<uint8_t>&) {}, makeTransport(std::move(pty.first)));
+    Communicator rocket(atRocket.callback(), makeTransport(std::move(pty.second)));
+    rocket.start();
+
+    ground.start();
+    ground.stop();
+    ground.send({1, 2});
+    ground.start();
+    EXPECT_EQ(atRocket.waitFor(2), (std::vector<uint8_t>{1, 2}));
+
+    ground.stop();
+    rocket.stop();
+}
+
+TEST_P(CommunicatorTest, CoalescesQueuedFramesUpToWriteBudget) {
+    auto up = openPipe();
+    auto down = openPipe();
+    Received atRocket;
+    std::unique_ptr<Transport> groundTransport = makeTransport(std::move(down.first), std::move(up.second));
+    const Transport* groundLoop = groundTransport.get();
+    Communicator ground([](const std::vector<uint8_t>&) {}, std::move(groundTransport));
+    Communicator rocket(atRocket.callback(), makeTransport(std::move(up.first), std::move(down.second)));
+    rocket.start();
+
+    // 64 short frames queued before start go out in a single write
+    std::vector<uint8_t> frame(32, 0x5A);
+    for (int i = 0; i < 64; ++i) {
+        ground.send(frame);
+    }
+    ground.start();
+    EXPECT_EQ(atRocket.waitFor(64 * frame.size()).size(), 64 * frame.size());
+    waitForEmptyQueue(ground);
+    EXPECT_EQ(writesMade(groundLoop), 1u);
+
+    // A smaller budget splits the same backlog into budget-sized writes
+    ground.stop();
+    ground.setWriteBudget(16 * frame.size());
+    for (int i = 0; i < 64; ++i) {
+        ground.send(frame);
+    }
+    ground.start();
+    EXPECT_EQ(atRocket.waitFor(128 * frame.size()).size(), 128 * frame.size());
+    waitForEmptyQueue(ground);
+    EXPECT_EQ(writesMade(groundLoop), 5u);
+
+    ground.stop();
+    rocket.stop();
+}
+
+TEST_P(CommunicatorTest, DropsOldestTelemetryWhenQueueFull) {
+    constexpr size_t FRAME_LENGTH = 64;
+    auto up = openPipe();
+    auto down = openPipe();
+    ASSERT_GE(::fcntl(up.first.fd(), F_SETPIPE_SZ, 4096), 0);
+    Received atRocket;
+    Communicator ground([](const std::vector<uint8_t>&) {}, makeTransport(std::move(down.first), std::move(up.second)));
+    Communicator rocket(atRocket.callback(), makeTransport(std::move(up.first), std::move(down.second)));
+
+    // Frames carry their class and a sequence number
+    uint32_t sequence = 0;
+    auto makeFrame = [&sequence](Communicator::FrameClass frameClass) {
+        std::vector<uint8_t> frame(FRAME_LENGTH, static_cast<uint8_t>(frameClass));
+        std::memcpy(&frame[1], &sequence, sizeof(sequence));
+        sequence++;
+        return frame;
+    };
+
+    // With nobody reading, fill the pipe and then the queue behind it
+    ground.setQueueFullPolicy(Communicator::QueueFullPolicy::Reject);
+    ground.start();
+    ASSERT_EQ(ground.send(makeFrame(Communicator::FrameClass::Command)), Communicator::SendResult::Queued);
+    size_t added;
+    do {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        added = 0;
+        while (ground.send(makeFrame(Communicator::FrameClass::Telemetry), Communicator::FrameClass::Telemetry) ==
+               Communicator::SendResult::Queued) {
+            added++;
+        }
+        sequence--;
+    } while (added > 0);
+    Communicator::QueueStats full = ground.getQueueStats();
+    EXPECT_EQ(full.depth, Communicator::SEND_QUEUE_SLOTS);
+    EXPECT_EQ(full.highWater, Communicator::SEND_QUEUE_SLOTS);
+    EXPECT_GE(full.rejected, 1u);
+
+    // The I/O thread evicts a telemetry frame for the command while the
+    // link is still stalled
+    ground.setQueueFullPolicy(Communicator::QueueFullPolicy::DropOldestTelemetry);
+    uint32_t last = sequence;
+    EXPECT_EQ(ground.send(makeFrame(Communicator::FrameClass::Command)), Communicator::SendResult::Queued);
+    EXPECT_EQ(ground.getQueueStats().dropped, 1u);
+
+    rocket.start();
+    std::vector<uint8_t> bytes = atRocket.waitFor(sequence * FRAME_LENGTH - FRAME_LENGTH);
+    ASSERT_EQ(bytes.size(), (sequence - 1) * FRAME_LENGTH);
+
+    // Everything but one telemetry frame arrives in order, commands included
+    uint32_t previous = 0;
+    uint32_t gaps = 0;
+    for (size_t offset = 0; offset < bytes.size(); offset += FRAME_LENGTH) {
+        uint32_t number;
+        std::memcpy(&number, &bytes[offset + 1], sizeof(number));
+        if (offset == 0) {
+            EXPECT_EQ(number, 0u);
+        } else {
+            ASSERT_GT(number, previous);
+            gaps += number - previous - 1;
+        }
+        previous = number;
+    }
+    EXPECT_EQ(gaps, 1u);
+    EXPECT_EQ(previous, last);
+    EXPECT_EQ(bytes[bytes.size() - FRAME_LENGTH], static_cast<uint8_t>(Communicator::FrameClass::Command));
+
+    ground.stop();
+    rocket.stop();
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, CommunicatorTest, ::testing::Values(Backend::Epoll, Backend::Uring),
+                         [](const ::testing::TestParamInfo<Backend>& info) {
+                             return info.param == Backend::Epoll ? "Epoll" : "Uring";
+                         });
+
+TEST(CommunicatorTest, RejectsOversizedFrame) {
+    auto pty = SerialDevice::openPtyPair();
+    Communicator communicator([](const std::vector<uint8_t>&) {},
+                              std::make_unique<EpollTransport>(std::move(pty.first)));
+    std::vector<uint8_t> frame(Communicator::MAX_FRAME_LENGTH + 1);
+    EXPECT_THROW(communicator.send(frame), std::length_error);
+    EXPECT_EQ(communicator.getQueueDepth(), 0u);
+}
+
+TEST(CommunicatorTest, RejectsWhenQueueFullAndTracksHighWater) {
+    auto pty = SerialDevice::openPtyPair();
+    Communicator communicator([](const std::vector<uint8_t>&) {},
+                              std::make_unique<EpollTransport>(std::move(pty.first)));
+    communicator.setQueueFullPolicy(Communicator::QueueFullPolicy::Reject);
+    EXPECT_EQ(communicator.getQueueFullPolicy(), Communicator::QueueFullPolicy::Reject);
+
+    // Not started, so nothing drains the queue
+    std::vector<uint8_t> frame = {1, 2, 3};
+    for (size_t i = 0; i < Communicator::SEND_QUEUE_SLOTS; ++i) {
+        ASSERT_EQ(communicator.send(frame), Communicator::SendResult::Queued);
+    }
+    EXPECT_EQ(communicator.send(frame), Communicator::SendResult::QueueFull);
+    EXPECT_EQ(communicator.send(frame), Communicator::SendResult::QueueFull);
+
+    Communicator::QueueStats stats = communicator.getQueueStats();
+    EXPECT_EQ(stats.depth, Communicator::SEND_QUEUE_SLOTS);
+    EXPECT_EQ(stats.highWater, Communicator::SEND_QUEUE_SLOTS);
+    EXPECT_EQ(stats.rejected, 2u);
+    EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST(CommunicatorTest, FullQueueOnStoppedCommunicatorDoesNotBlock) {
+    std::vector<uint8_t> frame = {1, 2, 3};
+
+    // Never started: frames queue for the first start() until the queue fills
+    Communicator idle([](const std::vector<uint8_t>&) {}, std::make_unique<StalledTransport>());
+    for (size_t i = 0; i < Communicator::SEND_QUEUE_SLOTS; ++i) {
+        ASSERT_EQ(idle.send(frame), Communicator::SendResult::Queued);
+    }
+    EXPECT_EQ(idle.send(frame), Communicator::SendResult::NotRunning);
+    idle.setQueueFullPolicy(Communicator::QueueFullPolicy::DropOldestTelemetry);
+    EXPECT_EQ(idle.send(frame), Communicator::SendResult::NotRunning);
+
+    // Stopped after running: the same once the queue is full
+    Communicator stopped([](const std::vector<uint8_t>&) {}, std::make_unique<StalledTransport>());
+    stopped.start();
+    stopped.stop();
+    for (size_t i = 0; i < Communicator::SEND_QUEUE_SLOTS; ++i) {
+        ASSERT_EQ(stopped.send(frame), Communicator::SendResult::Queued);
+    }
+    EXPECT_EQ(stopped.send(frame), Communicator::SendResult::NotRunning);
+}
+
+TEST(CommunicatorTest, StopReleasesBlockedSenders) {
+    Communicator communicator([](const std::vector<uint8_t>&) {}, std::make_unique<StalledTransport>());
+    communicator.start();
+    std::vector<uint8_t> frame = {1, 2, 3};
+    for (size_t i = 0; i < Communicator::SEND_QUEUE_SLOTS; ++i) {
+        ASSERT_EQ(communicator.send(frame), Communicator::SendResult::Queued);
+    }
+
+    std::atomic<bool> returned{false};
+    Communicator::SendResult result = Communicator::SendResult::Queued;
+    std::thread sender([&] {
+        result = communicator.send(frame);
+        returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(returned);
+
+    communicator.stop();
+    sender.join();
+    EXPECT_EQ(result, Communicator::SendResult::NotRunning);
+}
+
+TEST(CommunicatorTest, WithoutTransportDiscardsData) {
+    Communicator communicator([](const std::vector<uint8_t>&) {});
+    communicator.start();
+    EXPECT_EQ(communicator.send({1, 2, 3}), Communicator::SendResult::NoTransport);
+    EXPECT_THROW(communicator.setTransport(nullptr), std::logic_error);
+    EXPECT_THROW(communicator.setReceiveCallback(nullptr), std::logic_error);
+    communicator.stop();
+    EXPECT_NO_THROW(communicator.setTransport(nullptr));
+    EXPECT_NO_THROW(communicator.setReceiveCallback(nullptr));
+}
+
+TEST(CommunicatorTest, ReportsTransportFailureUntilRestarted) {
+    Communicator communicator([](const std::vector<uint8_t>&) {}, std::make_unique<FailingTransport>());
+    EXPECT_EQ(communicator.getLinkFailure(), nullptr);
+    communicator.start();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!communicator.getLinkFailure() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    ASSERT_NE(communicator.getLinkFailure(), nullptr);
+    EXPECT_THROW(std::rethrow_exception(communicator.getLinkFailure()), std::system_error);
+    EXPECT_EQ(communicator.send({1, 2, 3}), Communicator::SendResult::LinkFailed);
+    EXPECT_EQ(communicator.getQueueDepth(), 0u);
+
+    communicator.stop();
+    EXPECT_EQ(communicator.getLinkFailure(), nullptr);
+    EXPECT_EQ(communicator.send({1, 2, 3}), Communicator::SendResult::Queued);
+}
+
+TEST(CommunicatorTest, CreateTransportPrefersUring) {
+    std::unique_ptr<Transport> transport = createTransport(SerialDevice::openPtyPair().first);
+    EXPECT_EQ(dynamic_cast<UringTransport*>(transport.get()) != nullptr, UringTransport::isSupported());
+}
+
+TEST(SerialDeviceTest, RejectsUnsupportedBaudRate) {
+    EXPECT_THROW(SerialDevice::open("/dev/null", 12345), std::invalid_argument);
+    EXPECT_THROW(SerialDevice::open("/nonexistent/tty", 115200), std::system_error);
+}
+
+}  // namespace
+}  // namespace SCALPEL
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/FixedPacketCodec.hpp"
+#include <random>
+
+namespace SCALPEL {
+namespace {
+
+class FixedPacketCodecTest : public ::testing::Test {
+protected:
+    std::mt19937 rng{1234};
+
+    template <size_t N>
+    std::array<uint8_t, N> randomPayload(int startPercent) {
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::array<uint8_t, N> payload;
+        for (uint8_t& value : payload) {
+            value = percent(rng) < startPercent ? Packet::START_BYTE : static_cast<uint8_t>(byte(rng));
+        }
+        return payload;
+    }
+
+    // Encoding must match Packet byte for byte and decode back
+    template <size_t N>
+    void checkMatchesPacket() {
+        using Codec = FixedPacketCodec<N>;
+        for (int startPercent : {0, 10, 50, 100}) {
+            for (int trial = 0; trial < 50; ++trial) {
+                typename Codec::Payload payload = randomPayload<N>(startPercent);
+                typename Codec::Frame frame = Codec::encode(payload);
+                std::vector<uint8_t> expected = Packet(Span<const uint8_t>(payload)).assemble();
+                ASSERT_EQ(std::vector<uint8_t>(frame.begin(), frame.end()), expected);
+
+                typename Codec::Payload decoded{};
+                ASSERT_EQ(Codec::decode(frame, decoded), PacketView::Status::Ok);
+                EXPECT_EQ(decoded, payload);
+            }
+        }
+    }
+
+    // Damaged frames are accepted exactly when PacketView accepts them
+    template <size_t N>
+    void checkAgreesWithPacketView() {
+        using Codec = FixedPacketCodec<N>;
+        std::uniform_int_distribution<size_t> position(0, Codec::ASSEMBLED_LENGTH - 1);
+        std::uniform_int_distribution<int> byte(1, 255);
+        for (int trial = 0; trial < 2000; ++trial) {
+            typename Codec::Frame frame = Codec::encode(randomPayload<N>(20));
+            for (int damage = trial % 3; damage >= 0; --damage) {
+                frame[position(rng)] ^= static_cast<uint8_t>(byte(rng));
+            }
+
+            typename Codec::Payload decoded{};
+            PacketView view;
+            PacketView::Status expected = PacketView::parse(frame.data(), frame.size(), view);
+            if (expected == PacketView::Status::Ok && view.getPayloadLength() != N) {
+                expected = PacketView::Status::LengthMismatch;
+            }
+            PacketView::Status status = Codec::decode(frame, decoded);
+            ASSERT_EQ(status == PacketView::Status::Ok, expected == PacketView::Status::Ok);
+            if (status == PacketView::Status::Ok) {
+                std::array<uint8_t, N> viewPayload;
+                view.decodePayload(Span<uint8_t>(viewPayload));
+                EXPECT_EQ(decoded, viewPayload);
+            }
+        }
+    }
+};
+
+TEST_F(FixedPacketCodecTest, MatchesPacketAssemble) {
+    checkMatchesPacket<0>();
+    checkMatchesPacket<4>();
+    checkMatchesPacket<12>();
+    checkMatchesPacket<Packet::MAX_PAYLOAD_LENGTH>();
+}
+
+TEST_F(FixedPacketCodecTest, AgreesWithPacketViewOnDamage) {
+    checkAgreesWithPacketView<4>();
+    checkAgreesWithPacketView<12>();
+    checkAgreesWithPacketView<Packet::MAX_PAYLOAD_LENGTH>();
+}
+
+TEST_F(FixedPacketCodecTest, ReportsFailures) {
+    using Codec = FixedPacketCodec<4>;
+    const Codec::Frame frame = Codec::encode(Codec::Payload{0x01, Packet::START_BYTE, 0x03, 0x04});
+    Codec::Payload payload{0xEE, 0xEE, 0xEE, 0xEE};
+
+    Codec::Frame damaged = frame;
+    damaged[0] = 0x00;
+    EXPECT_EQ(Codec::decode(damaged, payload), PacketView::Status::BadStartByte);
+
+    damaged = frame;
+    damaged[1] ^= 0x01;
+    EXPECT_EQ(Codec::decode(damaged, payload), PacketView::Status::BadLengthChecksum);
+
+    // A valid header for another length
+    damaged = frame;
+    damaged[1] = static_cast<uint8_t>(5 << 2 | Checksum::calculate2BitChecksum(5));
+    EXPECT_EQ(Codec::decode(damaged, payload), PacketView::Status::LengthMismatch);
+
+    damaged = frame;
+    damaged[5] ^= 0x01;
+    EXPECT_EQ(Codec::decode(damaged, payload), PacketView::Status::BadCobsChecksum);
+
+    // Index off by one with the checksum left intact
+    damaged = frame;
+    damaged[2] = static_cast<uint8_t>(damaged[2] + (1 << 2));
+    EXPECT_EQ(Codec::decode(damaged, payload), PacketView::Status::BadCobsIndex);
+
+    damaged = frame;
+    damaged[Codec::ASSEMBLED_LENGTH - 1] ^= 0xFF;
+    EXPECT_EQ(Codec::decode(damaged, payload), PacketView::Status::BadPayloadChecksum);
+
+    // Failed decodes leave the payload alone
+    EXPECT_EQ(payload, (Codec::Payload{0xEE, 0xEE, 0xEE, 0xEE}));
+}
+
+}  // namespace
+}  // namespace SCALPEL
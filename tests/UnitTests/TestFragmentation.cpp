@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "AVC/Fragmentation.hpp"
+#include "AVC/Command.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace RocketLink::AVC;
+using SCALPEL::Packet;
+using SCALPEL::Span;
+
+class FragmentationTest : public ::testing::Test {
+protected:
+    using Clock = Reassembler::Clock;
+
+    std::vector<std::vector<uint8_t>> messages;
+    Clock::time_point start = Clock::now();
+
+    Reassembler makeReassembler(size_t maxMessages, size_t maxMessageLength,
+                                Clock::duration timeout = std::chrono::seconds(1)) {
+        return Reassembler(maxMessages, maxMessageLength, timeout,
+                           [this](Span<const uint8_t> message, uint8_t) {
+                               messages.emplace_back(message.begin(), message.end());
+                           });
+    }
+
+    static std::vector<uint8_t> makeMessage(size_t length) {
+        std::vector<uint8_t> message(length);
+        for (size_t i = 0; i < length; ++i) {
+            message[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+        return message;
+    }
+
+    static Span<const uint8_t> payloadOf(const Packet& packet) {
+        return packet.getPayload();
+    }
+};
+
+TEST_F(FragmentationTest, FragmentsFitInPackets) {
+    Fragmenter fragmenter;
+    std::vector<uint8_t> message = makeMessage(100);
+    std::vector<Packet> fragments = fragmenter.fragment(0x12, message);
+
+    ASSERT_EQ(fragments.size(), Fragmenter::fragmentCount(message.size()));
+    for (const Packet& fragment : fragments) {
+        Span<const uint8_t> payload = fragment.getPayload();
+        EXPECT_LE(payload.size(), Packet::MAX_PAYLOAD_LENGTH);
+        EXPECT_EQ(payload[0], 0x12);
+        EXPECT_EQ(payload[1], static_cast<uint8_t>(PayloadDescriptor::FRAGMENT));
+    }
+    EXPECT_EQ(fragments.back().getPayload().size(),
+              FragmentFormat::HEADER_LENGTH + message.size() % FragmentFormat::DATA_LENGTH);
+}
+
+TEST_F(FragmentationTest, RoundTripLongCommand) {
+    Command command(1, 2, CommandNumber::FIN_TEST, makeMessage(255));
+    std::vector<uint8_t> encoded = command.encode();
+    ASSERT_GT(encoded.size(), Packet::MAX_PAYLOAD_LENGTH);
+
+    Fragmenter fragmenter;
+    Reassembler reassembler = makeReassembler(4, 512);
+    for (const Packet& fragment : fragmenter.fragment(encoded[0], encoded)) {
+        EXPECT_TRUE(reassembler.accept(payloadOf(fragment), start));
+    }
+
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_EQ(messages[0], encoded);
+    EXPECT_EQ(reassembler.pending(), 0u);
+}
+
+TEST_F(FragmentationTest, OutOfOrderAndDuplicateFragments) {
+    Fragmenter fragmenter;
+    std::vector<uint8_t> message = makeMessage(200);
+    std::vector<Packet> fragments = fragmenter.fragment(0x34, message);
+    std::shuffle(fragments.begin(), fragments.end(), std::mt19937(42));
+
+    Reassembler reassembler = makeReassembler(2, 256);
+    for (size_t i = 0; i + 1 < fragments.size(); ++i) {
+        reassembler.accept(payloadOf(fragments[i]), start);
+        reassembler.accept(payloadOf(fragments[i]), start);
+    }
+    EXPECT_TRUE(messages.empty());
+    reassembler.accept(payloadOf(fragments.back()), start);
+
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_EQ(messages[0], message);
+    EXPECT_EQ(reassembler.getStats().fragmentsDuplicate, fragments.size() - 1);
+}
+
+TEST_F(FragmentationTest, InterleavedMessages) {
+    Fragmenter fragmenter;
+    std::vector<uint8_t> first = makeMessage(60);
+    std::vector<uint8_t> second(90, 0xEE);
+    std::vector<Packet> a = fragmenter.fragment(0x01, first);
+    std::vector<Packet> b = fragmenter.fragment(0x01, second);
+
+    Reassembler reassembler = makeReassembler(2, 128);
+    for (size_t i = 0; i < std::max(a.size(), b.size()); ++i) {
+        if (i < b.size()) reassembler.accept(payloadOf(b[i]), start);
+        if (i < a.size()) reassembler.accept(payloadOf(a[i]), start);
+    }
+
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0], first);
+    EXPECT_EQ(messages[1], second);
+}
+
+TEST_F(FragmentationTest, TimeoutEvictsPartialMessage) {
+    Fragmenter fragmenter;
+    std::vector<Packet> fragments = fragmenter.fragment(0x01, makeMessage(50));
+    Reassembler reassembler = makeReassembler(2, 128, std::chrono::milliseconds(100));
+
+    reassembler.accept(payloadOf(fragments[0]), start);
+    reassembler.expire(start + std::chrono::milliseconds(50));
+    EXPECT_EQ(reassembler.pending(), 1u);
+    reassembler.expire(start + std::chrono::milliseconds(100));
+    EXPECT_EQ(reassembler.pending(), 0u);
+    EXPECT_EQ(reassembler.getStats().messagesTimedOut, 1u);
+
+    // The remaining fragments start a new partial message that never completes
+    for (size_t i = 1; i < fragments.size(); ++i) {
+        reassembler.accept(payloadOf(fragments[i]), start + std::chrono::milliseconds(150));
+    }
+    EXPECT_TRUE(messages.empty());
+    EXPECT_EQ(reassembler.pending(), 1u);
+}
+
+TEST_F(FragmentationTest, FullTableEvictsOldest) {
+    Fragmenter fragmenter;
+    Reassembler reassembler = makeReassembler(2, 128);
+    std::vector<std::vector<Packet>> fragments;
+    for (int i = 0; i < 3; ++i) {
+        fragments.push_back(fragmenter.fragment(0x01, makeMessage(50)));
+        reassembler.accept(payloadOf(fragments.back()[0]), start + std::chrono::milliseconds(i));
+    }
+    EXPECT_EQ(reassembler.pending(), 2u);
+    EXPECT_EQ(reassembler.getStats().messagesEvicted, 1u);
+
+    // The first message lost its slot; the newer two still complete
+    for (int i = 1; i < 3; ++i) {
+        for (size_t j = 1; j < fragments[i].size(); ++j) {
+            reassembler.accept(payloadOf(fragments[i][j]), start + std::chrono::milliseconds(10));
+        }
+    }
+    EXPECT_EQ(messages.size(), 2u);
+}
+
+TEST_F(FragmentationTest, RejectsMalformedFragments) {
+    Reassembler reassembler = makeReassembler(2, 64);
+    const uint8_t fragment = static_cast<uint8_t>(PayloadDescriptor::FRAGMENT);
+
+    // Too short, wrong descriptor, misaligned offset, wrong length, too long
+    EXPECT_FALSE(reassembler.accept(std::vector<uint8_t>{0x01, fragment, 0, 0, 0, 0, 10}, start));
+    EXPECT_FALSE(reassembler.accept(std::vector<uint8_t>{0x01, 0x01, 0, 0, 0, 0, 1, 0xAA}, start));
+    EXPECT_FALSE(reassembler.accept(std::vector<uint8_t>{0x01, fragment, 0, 0, 5, 0, 30, 0xAA}, start));
+    EXPECT_FALSE(reassembler.accept(std::vector<uint8_t>{0x01, fragment, 0, 0, 0, 0, 10, 0xAA}, start));
+    EXPECT_FALSE(reassembler.accept(std::vector<uint8_t>{0x01, fragment, 0, 0, 0, 0, 65, 0xAA}, start));
+
+    EXPECT_EQ(reassembler.getStats().fragmentsRejected, 5u);
+    EXPECT_EQ(reassembler.pending(), 0u);
+}
+
+TEST_F(FragmentationTest, LengthLimits) {
+    Fragmenter fragmenter;
+    EXPECT_THROW(fragmenter.fragment(0x01, std::vector<uint8_t>{}), std::length_error);
+    EXPECT_THROW(fragmenter.fragment(0x01, std::vector<uint8_t>(FragmentFormat::MAX_MESSAGE_LENGTH + 1)),
+                 std::length_error);
+    EXPECT_THROW(makeReassembler(0, 64), std::invalid_argument);
+    EXPECT_THROW(makeReassembler(1, FragmentFormat::MAX_MESSAGE_LENGTH + 1), std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/FrameAggregator.hpp"
+#include "SCALPEL/FrameParser.hpp"
+
+namespace SCALPEL {
+namespace {
+
+using Clock = FrameAggregator::Clock;
+using std::chrono::milliseconds;
+
+class FrameAggregatorTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<Packet>> batches;
+    const Clock::time_point start{};
+
+    FrameAggregator makeAggregator(size_t maxBatchLength, Clock::duration budget) {
+        return FrameAggregator(maxBatchLength, budget, [this](Span<const Packet> packets) {
+            batches.emplace_back(packets.begin(), packets.end());
+        });
+    }
+
+    static Packet message(uint8_t id, size_t length = 4) {
+        std::vector<uint8_t> payload(length, id);
+        return Packet(payload);
+    }
+};
+
+TEST_F(FrameAggregatorTest, RejectsBatchSmallerThanPacket) {
+    EXPECT_THROW(makeAggregator(Packet::MAX_PACKET_LENGTH - 1, milliseconds(5)), std::invalid_argument);
+}
+
+TEST_F(FrameAggregatorTest, ZeroBudgetSendsImmediately) {
+    FrameAggregator aggregator = makeAggregator(256, Clock::duration::zero());
+    aggregator.add(message(1), start);
+    aggregator.add(message(2), start);
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_EQ(batches[0].size(), 1u);
+    EXPECT_EQ(aggregator.pending(), 0u);
+}
+
+TEST_F(FrameAggregatorTest, HoldsPacketsUntilBudgetExpires) {
+    FrameAggregator aggregator = makeAggregator(256, milliseconds(10));
+    aggregator.add(message(1), start);
+    aggregator.add(message(2), start + milliseconds(4));
+    EXPECT_TRUE(batches.empty());
+    EXPECT_EQ(aggregator.deadline(), start + milliseconds(10));
+
+    aggregator.poll(start + milliseconds(9));
+    EXPECT_TRUE(batches.empty());
+    aggregator.poll(start + milliseconds(10));
+    ASSERT_EQ(batches.size(), 1u);
+    ASSERT_EQ(batches[0].size(), 2u);
+    EXPECT_EQ(batches[0][0].getPayloadVector(), message(1).getPayloadVector());
+    EXPECT_EQ(batches[0][1].getPayloadVector(), message(2).getPayloadVector());
+}
+
+TEST_F(FrameAggregatorTest, SendsBatchBeforeItOverflows) {
+    // Each 28-byte payload assembles to 33 bytes; four fit in 140
+    FrameAggregator aggregator = makeAggregator(140, milliseconds(100));
+    for (uint8_t i = 0; i < 5; ++i) {
+        aggregator.add(message(i, Packet::MAX_PAYLOAD_LENGTH), start);
+    }
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0].size(), 4u);
+    EXPECT_EQ(aggregator.pending(), 1u);
+
+    aggregator.flush();
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_EQ(aggregator.getBatchesSent(), 2u);
+    EXPECT_EQ(aggregator.getPacketsSent(), 5u);
+}
+
+TEST_F(FrameAggregatorTest, SendsBatchAtPacketLimit) {
+    FrameAggregator aggregator = makeAggregator(4096, milliseconds(100));
+    for (size_t i = 0; i < FrameAggregator::MAX_BATCH_PACKETS; ++i) {
+        aggregator.add(message(static_cast<uint8_t>(i), 1), start);
+    }
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0].size(), FrameAggregator::MAX_BATCH_PACKETS);
+}
+
+TEST_F(FrameAggregatorTest, FrameParserSplitsBatch) {
+    FrameAggregator aggregator = makeAggregator(256, milliseconds(10));
+    for (uint8_t i = 0; i < 6; ++i) {
+        aggregator.add(message(i, 1 + i * 4), start);
+    }
+    aggregator.flush();
+    ASSERT_EQ(batches.size(), 1u);
+
+    // What a radio frame carries: the packets back to back
+    std::vector<uint8_t> radioPayload;
+    for (const Packet& packet : batches[0]) {
+        std::vector<uint8_t> assembled = packet.assemble();
+        radioPayload.insert(radioPayload.end(), assembled.begin(), assembled.end());
+    }
+
+    std::vector<std::vector<uint8_t>> received;
+    FrameParser parser([&received](const PacketView& frame, uint64_t) {
+        received.push_back(frame.toPacket().getPayloadVector());
+    });
+    parser.feed(radioPayload);
+    ASSERT_EQ(received.size(), 6u);
+    for (uint8_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(received[i], message(i, 1 + i * 4).getPayloadVector());
+    }
+}
+
+}  // namespace
+}  // namespace SCALPEL
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/FrameParser.hpp"
+#include <random>
+
+namespace SCALPEL {
+namespace {
+
+class FrameParserTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<uint8_t>> payloads;
+    std::vector<uint64_t> offsets;
+
+    FrameParser makeParser() {
+        return FrameParser([this](const PacketView& frame, uint64_t offset) {
+            std::vector<uint8_t> payload(frame.getPayloadLength());
+            frame.decodePayload(payload);
+            payloads.push_back(payload);
+            offsets.push_back(offset);
+        });
+    }
+
+    static void append(std::vector<uint8_t>& stream, const std::vector<uint8_t>& payload) {
+        std::vector<uint8_t> assembled = Packet(payload).assemble();
+        stream.insert(stream.end(), assembled.begin(), assembled.end());
+    }
+
+    const std::vector<uint8_t> first = {0x01, 0x02, 0x03};
+    const std::vector<uint8_t> second = {Packet::START_BYTE, 0x10, Packet::START_BYTE};
+    const std::vector<uint8_t> third = std::vector<uint8_t>(Packet::MAX_PAYLOAD_LENGTH, 0x42);
+};
+
+TEST_F(FrameParserTest, ParsesBackToBackPackets) {
+    std::vector<uint8_t> stream;
+    append(stream, first);
+    append(stream, second);
+    append(stream, third);
+
+    FrameParser parser = makeParser();
+    parser.feed(stream);
+
+    ASSERT_EQ(payloads.size(), 3u);
+    EXPECT_EQ(payloads[0], first);
+    EXPECT_EQ(payloads[1], second);
+    EXPECT_EQ(payloads[2], third);
+    EXPECT_EQ(offsets[0], 0u);
+    EXPECT_EQ(offsets[1], Packet(first).getAssembledLength());
+    EXPECT_EQ(offsets[2], Packet(first).getAssembledLength() + Packet(second).getAssembledLength());
+    EXPECT_EQ(parser.getStats().framesParsed, 3u);
+    EXPECT_EQ(parser.getStats().bytesDiscarded, 0u);
+    EXPECT_EQ(parser.getStats().resyncs, 0u);
+    EXPECT_EQ(parser.getStats().bytesConsumed, stream.size());
+}
+
+TEST_F(FrameParserTest, ParsesBytewiseFeed) {
+    std::vector<uint8_t> stream;
+    append(stream, first);
+    append(stream, second);
+
+    FrameParser parser = makeParser();
+    for (uint8_t byte : stream) {
+        parser.feed(Span<const uint8_t>(&byte, 1));
+    }
+
+    ASSERT_EQ(payloads.size(), 2u);
+    EXPECT_EQ(payloads[0], first);
+    EXPECT_EQ(payloads[1], second);
+}
+
+TEST_F(FrameParserTest, ParsesMixedIntegrityModes) {
+    // Each packet names its CRC width, so one stream can mix them
+    std::vector<uint8_t> stream;
+    std::vector<PacketFormat> formats(3);
+    formats[1].integrity = PacketFormat::Integrity::Crc16;
+    formats[2].integrity = PacketFormat::Integrity::Crc32c;
+    for (const PacketFormat& format : formats) {
+        for (const std::vector<uint8_t>* payload : {&first, &second, &third}) {
+            std::vector<uint8_t> assembled = Packet(*payload, format).assemble();
+            stream.insert(stream.end(), assembled.begin(), assembled.end());
+        }
+    }
+
+    FrameParser parser = makeParser();
+    for (uint8_t byte : stream) {
+        parser.feed(Span<const uint8_t>(&byte, 1));
+    }
+
+    ASSERT_EQ(payloads.size(), 9u);
+    for (size_t i = 0; i < payloads.size(); i += 3) {
+        EXPECT_EQ(payloads[i], first);
+        EXPECT_EQ(payloads[i + 1], second);
+        EXPECT_EQ(payloads[i + 2], third);
+    }
+    EXPECT_EQ(parser.getStats().bytesDiscarded, 0u);
+}
+
+TEST_F(FrameParserTest, SkipsGarbageBetweenPackets) {
+    std::vector<uint8_t> garbage = {0x00, 0x11, Packet::START_BYTE, Packet::START_BYTE, 0x22};
+    std::vector<uint8_t> stream = garbage;
+    append(stream, first);
+    stream.insert(stream.end(), garbage.begin(), garbage.end());
+    append(stream, second);
+
+    FrameParser parser = makeParser();
+    parser.feed(stream);
+
+    ASSERT_EQ(payloads.size(), 2u);
+    EXPECT_EQ(payloads[0], first);
+    EXPECT_EQ(payloads[1], second);
+    EXPECT_EQ(offsets[0], garbage.size());
+    EXPECT_EQ(parser.getStats().bytesDiscarded, 2 * garbage.size());
+    EXPECT_GE(parser.getStats().resyncs, 2u);
+}
+
+TEST_F(FrameParserTest, ResyncsAfterCorruptedPacket) {
+    std::vector<uint8_t> stream;
+    append(stream, third);
+    size_t corruptedLength = stream.size();
+    stream[10] ^= 0x04; // Corrupt a payload byte
+    append(stream, first);
+
+    FrameParser parser = makeParser();
+    parser.feed(stream);
+
+    ASSERT_EQ(payloads.size(), 1u);
+    EXPECT_EQ(payloads[0], first);
+    EXPECT_EQ(offsets[0], corruptedLength);
+    EXPECT_EQ(parser.getStats().bytesDiscarded, corruptedLength);
+    EXPECT_GE(parser.getStats().resyncs, 1u);
+}
+
+TEST_F(FrameParserTest, FindsPacketStartingInsideRejectedCandidate) {
+    // A stray START_BYTE makes the real packet's START look like a length byte
+    std::vector<uint8_t> stream = {Packet::START_BYTE};
+    append(stream, second);
+
+    FrameParser parser = makeParser();
+    parser.feed(stream);
+
+    ASSERT_EQ(payloads.size(), 1u);
+    EXPECT_EQ(payloads[0], second);
+    EXPECT_EQ(offsets[0], 1u);
+    EXPECT_EQ(parser.getStats().bytesDiscarded, 1u);
+    EXPECT_EQ(parser.getStats().resyncs, 1u);
+}
+
+TEST_F(FrameParserTest, ResetDropsPartialPacket) {
+    std::vector<uint8_t> stream;
+    append(stream, first);
+
+    FrameParser parser = makeParser();
+    parser.feed(Span<const uint8_t>(stream.data(), 4));
+    parser.reset();
+    parser.feed(Span<const uint8_t>(stream.data() + 4, stream.size() - 4));
+    append(stream, second);
+    parser.feed(Span<const uint8_t>(stream.data() + stream.size() - Packet(second).getAssembledLength(),
+                                    Packet(second).getAssembledLength()));
+
+    ASSERT_EQ(payloads.size(), 1u);
+    EXPECT_EQ(payloads[0], second);
+}
+
+TEST_F(FrameParserTest, RecoversPacketsFromNoisyStream) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::vector<uint8_t> stream;
+    const size_t packetCount = 200;
+    for (size_t i = 0; i < packetCount; ++i) {
+        std::vector<uint8_t> noise(byteDist(rng) % 8);
+        for (auto& byte : noise) {
+            byte = static_cast<uint8_t>(byteDist(rng));
+        }
+        stream.insert(stream.end(), noise.begin(), noise.end());
+        append(stream, {static_cast<uint8_t>(i), Packet::START_BYTE, static_cast<uint8_t>(i >> 8)});
+    }
+
+    FrameParser parser = makeParser();
+    for (size_t offset = 0; offset < stream.size(); offset += 13) {
+        parser.feed(Span<const uint8_t>(stream.data() + offset, std::min<size_t>(13, stream.size() - offset)));
+    }
+
+    EXPECT_EQ(payloads.size(), packetCount);
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        EXPECT_EQ(payloads[i][0], static_cast<uint8_t>(i));
+    }
+}
+
+TEST_F(FrameParserTest, CorrectsDamagedFecPackets) {
+    // Damage bytes after the header; the length and options bytes are what
+    // tell the parser how long the packet is
+    std::mt19937 rng(5);
+    PacketFormat format{8};
+    std::vector<uint8_t> stream;
+    const size_t packetCount = 100;
+    uint64_t damagedBytes = 0;
+    for (size_t i = 0; i < packetCount; ++i) {
+        std::vector<uint8_t> payload = {static_cast<uint8_t>(i), Packet::START_BYTE, 0x33, 0x44};
+        std::vector<uint8_t> assembled = Packet(payload, format).assemble();
+        for (size_t e = 0; e < i % 5; ++e) {
+            size_t position = 4 + 2 * e + rng() % 2;
+            assembled[position] ^= static_cast<uint8_t>(1 + rng() % 255);
+            damagedBytes++;
+        }
+        stream.insert(stream.end(), assembled.begin(), assembled.end());
+    }
+
+    FrameParser parser = makeParser();
+    for (size_t offset = 0; offset < stream.size(); offset += 7) {
+        parser.feed(Span<const uint8_t>(stream.data() + offset, std::min<size_t>(7, stream.size() - offset)));
+    }
+
+    ASSERT_EQ(payloads.size(), packetCount);
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        EXPECT_EQ(payloads[i][0], static_cast<uint8_t>(i));
+    }
+    EXPECT_EQ(parser.getStats().bytesCorrected, damagedBytes);
+    EXPECT_EQ(parser.getStats().bytesDiscarded, 0u);
+}
+
+}  // namespace
+}  // namespace SCALPEL
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/FrameRing.hpp"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace SCALPEL {
+namespace {
+
+using Ring = FrameRing<16, 4>;
+
+void push(Ring& ring, std::vector<uint8_t> frame) {
+    Ring::Reservation slot = ring.tryReserve();
+    ASSERT_TRUE(slot);
+    std::memcpy(slot.data(), frame.data(), frame.size());
+    ring.commit(slot, frame.size());
+}
+
+std::vector<uint8_t> front(const Ring& ring, size_t i = 0) {
+    Span<const uint8_t> frame = ring.peek(i);
+    return std::vector<uint8_t>(frame.begin(), frame.end());
+}
+
+TEST(FrameRingTest, DeliversFramesInOrder) {
+    Ring ring;
+    EXPECT_TRUE(ring.empty());
+    push(ring, {1});
+    push(ring, {2, 2});
+    EXPECT_EQ(ring.size(), 2u);
+    EXPECT_EQ(front(ring), (std::vector<uint8_t>{1}));
+    EXPECT_EQ(front(ring, 1), (std::vector<uint8_t>{2, 2}));
+    EXPECT_TRUE(ring.peek(2).empty());
+
+    ring.pop();
+    EXPECT_EQ(front(ring), (std::vector<uint8_t>{2, 2}));
+    ring.pop();
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(FrameRingTest, RefusesReservationsWhenFullAndWrapsAround) {
+    Ring ring;
+    for (uint8_t i = 0; i < Ring::CAPACITY; ++i) {
+        push(ring, {i});
+    }
+    EXPECT_FALSE(ring.tryReserve());
+
+    // Released slots are reused in order
+    for (uint8_t round = 0; round < 10; ++round) {
+        ring.pop();
+        push(ring, {static_cast<uint8_t>(100 + round)});
+        EXPECT_FALSE(ring.tryReserve());
+    }
+    for (uint8_t i = 0; i < Ring::CAPACITY; ++i) {
+        EXPECT_EQ(front(ring), (std::vector<uint8_t>{static_cast<uint8_t>(106 + i)}));
+        ring.pop();
+    }
+}
+
+TEST(FrameRingTest, UnpublishedSlotHoldsBackLaterFrames) {
+    Ring ring;
+    Ring::Reservation first = ring.tryReserve();
+    ASSERT_TRUE(first);
+    push(ring, {2});
+
+    // The consumer cannot skip a frame still being written
+    EXPECT_TRUE(ring.empty());
+    first.data()[0] = 1;
+    ring.commit(first, 1);
+    EXPECT_EQ(front(ring), (std::vector<uint8_t>{1}));
+    EXPECT_EQ(front(ring, 1), (std::vector<uint8_t>{2}));
+}
+
+TEST(FrameRingTest, EraseKeepsOrderAndFreesASlot) {
+    Ring ring;
+    for (uint8_t i = 0; i < Ring::CAPACITY; ++i) {
+        Ring::Reservation slot = ring.tryReserve();
+        ASSERT_TRUE(slot);
+        slot.data()[0] = i;
+        ring.commit(slot, 1, static_cast<uint8_t>(10 + i));
+    }
+    EXPECT_EQ(ring.tag(2), 12);
+
+    ring.erase(2);
+    EXPECT_EQ(ring.size(), Ring::CAPACITY - 1);
+    EXPECT_EQ(front(ring), (std::vector<uint8_t>{0}));
+    EXPECT_EQ(front(ring, 1), (std::vector<uint8_t>{1}));
+    EXPECT_EQ(front(ring, 2), (std::vector<uint8_t>{3}));
+    EXPECT_EQ(ring.tag(1), 11);
+
+    // The freed slot takes a new frame behind the survivors
+    push(ring, {4});
+    ring.erase(0);
+    EXPECT_EQ(front(ring), (std::vector<uint8_t>{1}));
+    EXPECT_EQ(front(ring, 2), (std::vector<uint8_t>{4}));
+    EXPECT_EQ(ring.size(), Ring::CAPACITY - 1);
+}
+
+TEST(FrameRingTest, ConcurrentProducersKeepTheirOwnOrder) {
+    constexpr int PRODUCERS = 4;
+    constexpr uint32_t FRAMES = 20000;
+    FrameRing<8, 64> ring;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (uint32_t i = 0; i < FRAMES; ++i) {
+                FrameRing<8, 64>::Reservation slot = ring.tryReserve();
+                while (!slot) {
+                    std::this_thread::yield();
+                    slot = ring.tryReserve();
+                }
+                slot.data()[0] = static_cast<uint8_t>(p);
+                std::memcpy(slot.data() + 1, &i, sizeof(i));
+                ring.commit(slot, 1 + sizeof(i));
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(PRODUCERS, 0);
+    uint32_t received = 0;
+    bool ordered = true;
+    while (received < PRODUCERS * FRAMES) {
+        Span<const uint8_t> frame = ring.peek();
+        if (frame.empty()) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t sequence;
+        std::memcpy(&sequence, frame.data() + 1, sizeof(sequence));
+        ordered = ordered && frame.size() == 5 && sequence == next[frame[0]];
+        next[frame[0]]++;
+        ring.pop();
+        received++;
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.empty());
+}
+
+}  // namespace
+}  // namespace SCALPEL
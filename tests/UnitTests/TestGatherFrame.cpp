@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/GatherFrame.hpp"
+#include "PhysicalLayer/GatherWrite.hpp"
+#include <algorithm>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace SCALPEL {
+namespace {
+
+class GatherFrameTest : public ::testing::Test {
+protected:
+    static std::vector<uint8_t> bytesOf(const GatherFrame& frame) {
+        std::vector<uint8_t> bytes(frame.size());
+        EXPECT_EQ(frame.copyTo(bytes.data()), frame.size());
+        return bytes;
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Everything readable from fd until it would block
+    static std::vector<uint8_t> drain(int fd) {
+        std::vector<uint8_t> bytes;
+        uint8_t chunk[4096];
+        ssize_t got;
+        while ((got = ::read(fd, chunk, sizeof(chunk))) > 0) {
+            bytes.insert(bytes.end(), chunk, chunk + got);
+        }
+        return bytes;
+    }
+#endif
+};
+
+// Asio synchronous write stream taking at most maxWrite bytes per call, so
+// writes end part way through a segment as on a busy serial port
+class ShortWriteStream {
+public:
+    explicit ShortWriteStream(size_t maxWrite) : maxWrite(maxWrite) {}
+
+    template <typename ConstBufferSequence>
+    size_t write_some(const ConstBufferSequence& buffers, boost::system::error_code& ec) {
+        ec = boost::system::error_code();
+        size_t taken = 0;
+        for (auto it = boost::asio::buffer_sequence_begin(buffers);
+             it != boost::asio::buffer_sequence_end(buffers) && taken < maxWrite; ++it) {
+            boost::asio::const_buffer buffer(*it);
+            size_t n = std::min(buffer.size(), maxWrite - taken);
+            const uint8_t* data = static_cast<const uint8_t*>(buffer.data());
+            written.insert(written.end(), data, data + n);
+            taken += n;
+        }
+        writeCalls++;
+        return taken;
+    }
+
+    template <typename ConstBufferSequence>
+    size_t write_some(const ConstBufferSequence& buffers) {
+        boost::system::error_code ec;
+        return write_some(buffers, ec);
+    }
+
+    std::vector<uint8_t> written;
+    size_t writeCalls = 0;
+
+private:
+    size_t maxWrite;
+};
+
+TEST_F(GatherFrameTest, AdjacentReservationsShareASegment) {
+    GatherFrame frame;
+    Span<uint8_t> header = frame.reserve(3);
+    header[0] = 1;
+    header[1] = 2;
+    header[2] = 3;
+    std::vector<uint8_t> payload = {4, 5};
+    frame.append(payload);
+
+    EXPECT_EQ(frame.segmentCount(), 1u);
+    EXPECT_EQ(frame.size(), 5u);
+    EXPECT_EQ(frame.inlineLength(), 5u);
+    EXPECT_EQ(bytesOf(frame), (std::vector<uint8_t>{1, 2, 3, 4, 5}));
+}
+
+TEST_F(GatherFrameTest, ReferencesAreNotCopied) {
+    GatherFrame frame;
+    uint8_t header[1] = {0x7E};
+    frame.append(header);
+    std::vector<uint8_t> body = {1, 2, 3, 4};
+    frame.appendReference(body);
+    uint8_t trailer[1] = {0xFF};
+    frame.append(trailer);
+
+    ASSERT_EQ(frame.segmentCount(), 3u);
+    EXPECT_EQ(frame.segment(1).data(), body.data());
+    EXPECT_EQ(frame.inlineLength(), 2u);
+
+    // Changes to referenced bytes show up until the frame is written
+    body[0] = 9;
+    EXPECT_EQ(bytesOf(frame), (std::vector<uint8_t>{0x7E, 9, 2, 3, 4, 0xFF}));
+}
+
+TEST_F(GatherFrameTest, AppendPacketMatchesAssemble) {
+    GatherFrame frame;
+    Packet packet(std::vector<uint8_t>{1, Packet::START_BYTE, 3});
+    Span<const uint8_t> bytes = frame.appendPacket(packet);
+    EXPECT_EQ(std::vector<uint8_t>(bytes.begin(), bytes.end()), packet.assemble());
+    EXPECT_EQ(bytesOf(frame), packet.assemble());
+}
+
+TEST_F(GatherFrameTest, ThrowsWhenFull) {
+    GatherFrame frame;
+    frame.reserve(GatherFrame::INLINE_CAPACITY);
+    EXPECT_THROW(frame.reserve(1), std::length_error);
+
+    GatherFrame references;
+    uint8_t bytes[2 * GatherFrame::MAX_SEGMENTS] = {};
+    for (size_t i = 0; i < GatherFrame::MAX_SEGMENTS; ++i) {
+        references.appendReference(Span<const uint8_t>(bytes + 2 * i, 1));
+    }
+    EXPECT_THROW(references.appendReference(Span<const uint8_t>(bytes + 1, 1)), std::length_error);
+
+    references.clear();
+    EXPECT_EQ(references.size(), 0u);
+    EXPECT_EQ(references.segmentCount(), 0u);
+}
+
+TEST_F(GatherFrameTest, AsioWriteResumesAfterShortWrites) {
+    std::vector<uint8_t> reference(1000, 0x33);
+    GatherFrame frame;
+    uint8_t header[3] = {0x7E, 0x01, 0x02};
+    frame.append(header);
+    frame.appendReference(reference);
+    uint8_t trailer[1] = {0x5A};
+    frame.append(trailer);
+
+    ShortWriteStream stream(64);
+    EXPECT_EQ(RocketLink::Radio::writeGatherFrame(stream, frame), frame.size());
+    EXPECT_EQ(stream.written, bytesOf(frame));
+    EXPECT_GT(stream.writeCalls, 1u);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_F(GatherFrameTest, WritesWholeFrameThroughFullPipe) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ASSERT_EQ(::fcntl(fds[0], F_SETFL, O_NONBLOCK), 0);
+    ASSERT_EQ(::fcntl(fds[1], F_SETFL, O_NONBLOCK), 0);
+
+    // Referenced segments larger than the pipe force partial writes that end
+    // part way through a segment
+    std::vector<uint8_t> first(200000, 0x11);
+    std::vector<uint8_t> second(100000, 0x22);
+    GatherFrame frame;
+    uint8_t header[2] = {0xAB, 0xCD};
+    frame.append(header);
+    frame.appendReference(first);
+    frame.appendReference(second);
+
+    std::vector<uint8_t> expected = bytesOf(frame);
+    std::vector<uint8_t> received;
+    std::thread reader([&] {
+        while (received.size() < expected.size()) {
+            std::vector<uint8_t> chunk = drain(fds[0]);
+            received.insert(received.end(), chunk.begin(), chunk.end());
+            std::this_thread::yield();
+        }
+    });
+    EXPECT_EQ(frame.writeTo(fds[1]), expected.size());
+    reader.join();
+    EXPECT_EQ(received, expected);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_F(GatherFrameTest, WriteErrorThrows) {
+    GatherFrame frame;
+    uint8_t byte[1] = {1};
+    frame.append(byte);
+    EXPECT_THROW(frame.writeTo(-1), std::system_error);
+}
+#endif
+
+}  // namespace
+}  // namespace SCALPEL
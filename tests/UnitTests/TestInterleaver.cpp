@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/Interleaver.hpp"
+#include "SCALPEL/FrameParser.hpp"
+
+namespace SCALPEL {
+namespace {
+
+class InterleaverTest : public ::testing::Test {
+protected:
+    std::vector<std::vector<uint8_t>> blocks;
+
+    Interleaver makeInterleaver(size_t depth, size_t slotLength) {
+        return Interleaver(depth, slotLength, [this](Span<const uint8_t> block) {
+            blocks.emplace_back(block.begin(), block.end());
+        });
+    }
+
+    static std::vector<uint8_t> concatenate(const std::vector<std::vector<uint8_t>>& parts) {
+        std::vector<uint8_t> all;
+        for (const auto& part : parts) {
+            all.insert(all.end(), part.begin(), part.end());
+        }
+        return all;
+    }
+};
+
+TEST_F(InterleaverTest, RejectsInvalidGeometry) {
+    EXPECT_THROW(makeInterleaver(0, 8), std::invalid_argument);
+    EXPECT_THROW(makeInterleaver(Interleaver::MAX_DEPTH + 1, 8), std::invalid_argument);
+    EXPECT_THROW(makeInterleaver(4, 0), std::invalid_argument);
+    EXPECT_THROW(Deinterleaver(0, 8, nullptr), std::invalid_argument);
+}
+
+TEST_F(InterleaverTest, TransposesBlock) {
+    Interleaver interleaver = makeInterleaver(3, 2);
+    interleaver.push(std::vector<uint8_t>{0x11, 0x12});
+    interleaver.push(std::vector<uint8_t>{0x21});
+    EXPECT_TRUE(blocks.empty());
+    EXPECT_EQ(interleaver.pending(), 2u);
+    interleaver.push(std::vector<uint8_t>{0x31, 0x32});
+
+    ASSERT_EQ(blocks.size(), 1u);
+    EXPECT_EQ(blocks[0], (std::vector<uint8_t>{0x11, 0x21, 0x31, 0x12, Interleaver::FILL_BYTE, 0x32}));
+    EXPECT_EQ(interleaver.pending(), 0u);
+}
+
+TEST_F(InterleaverTest, RejectsPacketLongerThanSlot) {
+    Interleaver interleaver = makeInterleaver(2, 2);
+    EXPECT_THROW(interleaver.push(std::vector<uint8_t>{1, 2, 3}), std::length_error);
+}
+
+TEST_F(InterleaverTest, RoundTripThroughFrameParser) {
+    PacketFormat format{8};
+    Interleaver interleaver = makeInterleaver(4, Packet::MAX_PACKET_LENGTH);
+    std::vector<std::vector<uint8_t>> payloads;
+    for (uint8_t i = 0; i < 10; ++i) {
+        payloads.push_back(std::vector<uint8_t>(i + 1u, Packet::START_BYTE));
+        interleaver.push(Packet(payloads.back(), format).assemble());
+    }
+    interleaver.flush();
+    ASSERT_EQ(blocks.size(), 3u);
+
+    std::vector<std::vector<uint8_t>> received;
+    FrameParser parser([&received](const PacketView& frame, uint64_t) {
+        received.push_back(frame.toPacket().getPayloadVector());
+    });
+    Deinterleaver deinterleaver(4, Packet::MAX_PACKET_LENGTH, [&parser](Span<const uint8_t> data) {
+        parser.feed(data);
+    });
+
+    // Feed in chunks that straddle block boundaries
+    std::vector<uint8_t> stream = concatenate(blocks);
+    for (size_t offset = 0; offset < stream.size(); offset += 37) {
+        deinterleaver.feed(Span<const uint8_t>(stream.data() + offset, std::min<size_t>(37, stream.size() - offset)));
+    }
+    EXPECT_EQ(received, payloads);
+}
+
+TEST_F(InterleaverTest, SpreadsBurstAcrossPackets) {
+    // A burst as long as the depth damages at most one byte of each packet
+    const size_t depth = 8;
+    PacketFormat format{2};
+    Interleaver interleaver = makeInterleaver(depth, Packet::MAX_PACKET_LENGTH);
+    for (uint8_t i = 0; i < depth; ++i) {
+        interleaver.push(Packet(std::vector<uint8_t>(20, i), format).assemble());
+    }
+    ASSERT_EQ(blocks.size(), 1u);
+    std::vector<uint8_t> block = blocks[0];
+    for (size_t i = 5 * depth; i < 6 * depth; ++i) {
+        block[i] ^= 0xFF;
+    }
+
+    size_t delivered = 0;
+    FrameParser parser([&delivered](const PacketView&, uint64_t) { delivered++; });
+    Deinterleaver deinterleaver(depth, Packet::MAX_PACKET_LENGTH, [&parser](Span<const uint8_t> data) {
+        parser.feed(data);
+    });
+    deinterleaver.feed(block);
+    EXPECT_EQ(delivered, depth);
+    EXPECT_EQ(parser.getStats().bytesCorrected, depth);
+}
+
+TEST_F(InterleaverTest, SlotFormatRepairsDamagedHeaders) {
+    const size_t depth = 4;
+    PacketFormat format{4};
+    std::vector<uint8_t> payload(16, 0x5A);
+    size_t slotLength = Packet(payload, format).getAssembledLength();
+    Interleaver interleaver = makeInterleaver(depth, slotLength);
+    for (size_t i = 0; i < depth; ++i) {
+        interleaver.push(Packet(payload, format).assemble());
+    }
+    ASSERT_EQ(blocks.size(), 1u);
+
+    // Wipe the START and length bytes of every packet
+    std::vector<uint8_t> block = blocks[0];
+    for (size_t i = 0; i < 2 * depth; ++i) {
+        block[i] = 0x00;
+    }
+
+    size_t delivered = 0;
+    FrameParser parser([&delivered](const PacketView&, uint64_t) { delivered++; });
+    Deinterleaver deinterleaver(depth, slotLength, [&parser](Span<const uint8_t> data) {
+        parser.feed(data);
+    });
+    deinterleaver.setSlotFormat(format);
+    deinterleaver.feed(block);
+    EXPECT_EQ(delivered, depth);
+    EXPECT_EQ(deinterleaver.getBytesCorrected(), 2 * depth);
+}
+
+TEST_F(InterleaverTest, FeedAtFillsLostBytes) {
+    Interleaver interleaver = makeInterleaver(3, 2);
+    interleaver.push(std::vector<uint8_t>{0x11, 0x12});
+    interleaver.push(std::vector<uint8_t>{0x21, 0x22});
+    interleaver.push(std::vector<uint8_t>{0x31, 0x32});
+    ASSERT_EQ(blocks.size(), 1u);
+
+    std::vector<std::vector<uint8_t>> restored;
+    Deinterleaver deinterleaver(3, 2, [&restored](Span<const uint8_t> data) {
+        restored.emplace_back(data.begin(), data.end());
+    });
+    Span<const uint8_t> block(blocks[0]);
+    EXPECT_TRUE(deinterleaver.feedAt(0, block.first(2)));
+    EXPECT_TRUE(deinterleaver.feedAt(4, block.subspan(4)));
+
+    // Bytes 2 and 3 on the air are column 0 of row 2 and column 1 of row 0
+    const uint8_t fill = Interleaver::FILL_BYTE;
+    ASSERT_EQ(restored.size(), 1u);
+    EXPECT_EQ(restored[0], (std::vector<uint8_t>{0x11, fill, 0x21, 0x22, fill, 0x32}));
+}
+
+TEST_F(InterleaverTest, FeedAtRealignsOnNewBlock) {
+    std::vector<std::vector<uint8_t>> restored;
+    Deinterleaver deinterleaver(2, 2, [&restored](Span<const uint8_t> data) {
+        restored.emplace_back(data.begin(), data.end());
+    });
+    const uint8_t fill = Interleaver::FILL_BYTE;
+
+    // The tail of the first block is lost; an offset behind the bytes
+    // received starts the next one
+    EXPECT_TRUE(deinterleaver.feedAt(0, std::vector<uint8_t>{0x11, 0x21}));
+    EXPECT_TRUE(deinterleaver.feedAt(0, std::vector<uint8_t>{0x31, 0x41, 0x32, 0x42}));
+    ASSERT_EQ(restored.size(), 2u);
+    EXPECT_EQ(restored[0], (std::vector<uint8_t>{0x11, fill, 0x21, fill}));
+    EXPECT_EQ(restored[1], (std::vector<uint8_t>{0x31, 0x32, 0x41, 0x42}));
+
+    // The tail of one block and the head of the next are lost, which only
+    // the sender's newBlock marker reveals
+    EXPECT_TRUE(deinterleaver.feedAt(0, std::vector<uint8_t>{0x51}));
+    EXPECT_TRUE(deinterleaver.feedAt(2, std::vector<uint8_t>{0x62, 0x72}, true));
+    ASSERT_EQ(restored.size(), 4u);
+    EXPECT_EQ(restored[2], (std::vector<uint8_t>{0x51, fill, fill, fill}));
+    EXPECT_EQ(restored[3], (std::vector<uint8_t>{fill, 0x62, fill, 0x72}));
+}
+
+TEST_F(InterleaverTest, FeedAtRejectsChunkOutsideBlock) {
+    size_t emitted = 0;
+    Deinterleaver deinterleaver(2, 2, [&emitted](Span<const uint8_t>) { emitted++; });
+    EXPECT_FALSE(deinterleaver.feedAt(4, std::vector<uint8_t>{1}));
+    EXPECT_FALSE(deinterleaver.feedAt(2, std::vector<uint8_t>{1, 2, 3}));
+    EXPECT_TRUE(deinterleaver.feedAt(0, std::vector<uint8_t>{1, 2, 3, 4}));
+    EXPECT_EQ(emitted, 1u);
+}
+
+TEST_F(InterleaverTest, DepthOnePassesPacketsThrough) {
+    Interleaver interleaver = makeInterleaver(1, Packet::MAX_PACKET_LENGTH);
+    std::vector<uint8_t> assembled = Packet(std::vector<uint8_t>{1, 2, 3}).assemble();
+    interleaver.push(assembled);
+    ASSERT_EQ(blocks.size(), 1u);
+    EXPECT_EQ(blocks[0], assembled);
+}
+
+TEST_F(InterleaverTest, SetDepthFlushesPartialBlock) {
+    Interleaver interleaver = makeInterleaver(4, 2);
+    interleaver.push(std::vector<uint8_t>{0xAA, 0xBB});
+    interleaver.setDepth(2);
+    ASSERT_EQ(blocks.size(), 1u);
+    EXPECT_EQ(blocks[0].size(), 8u);
+    EXPECT_EQ(interleaver.getBlockLength(), 4u);
+
+    interleaver.push(std::vector<uint8_t>{0x01, 0x02});
+    interleaver.push(std::vector<uint8_t>{0x03, 0x04});
+    ASSERT_EQ(blocks.size(), 2u);
+    EXPECT_EQ(blocks[1], (std::vector<uint8_t>{0x01, 0x03, 0x02, 0x04}));
+}
+
+}  // namespace
+}  // namespace SCALPEL
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/Communicator.hpp"
+#include "SCALPEL/LoopbackTransport.hpp"
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace SCALPEL {
+namespace {
+
+using Model = LoopbackTransport::LinkModel;
+
+// Collects everything a Communicator receives
+class Received {
+public:
+    Communicator::ReceiveCallback callback() {
+        return [this](const std::vector<uint8_t>& data) {
+            std::lock_guard<std::mutex> lock(mutex);
+            bytes.insert(bytes.end(), data.begin(), data.end());
+            arrived.notify_all();
+        };
+    }
+
+    // Wait until count bytes have arrived, or for the timeout, and return them
+    std::vector<uint8_t> waitFor(size_t count, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        std::unique_lock<std::mutex> lock(mutex);
+        arrived.wait_for(lock, timeout, [&] { return bytes.size() >= count; });
+        return bytes;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable arrived;
+    std::vector<uint8_t> bytes;
+};
+
+// Two Communicators joined by a loopback pair; the raw transports stay
+// reachable for their stats
+struct Stacks {
+    explicit Stacks(const Model& up = Model(), const Model& down = Model()) {
+        auto pair = LoopbackTransport::createPair(up, down);
+        groundLink = pair.first.get();
+        rocketLink = pair.second.get();
+        ground.setTransport(std::move(pair.first));
+        rocket.setTransport(std::move(pair.second));
+    }
+
+    Received atGround;
+    Received atRocket;
+    Communicator ground{atGround.callback()};
+    Communicator rocket{atRocket.callback()};
+    const LoopbackTransport* groundLink = nullptr;
+    const LoopbackTransport* rocketLink = nullptr;
+};
+
+std::vector<uint8_t> numberedFrame(uint32_t number, size_t length) {
+    std::vector<uint8_t> frame(length, 0);
+    std::memcpy(frame.data(), &number, sizeof(number));
+    return frame;
+}
+
+TEST(LoopbackTransportTest, ExchangesFramesBothWays) {
+    Stacks stacks;
+    stacks.ground.start();
+    stacks.rocket.start();
+
+    stacks.ground.send({1, 2, 3});
+    stacks.rocket.send({4, 5});
+    stacks.ground.send({6});
+    EXPECT_EQ(stacks.atRocket.waitFor(4), (std::vector<uint8_t>{1, 2, 3, 6}));
+    EXPECT_EQ(stacks.atGround.waitFor(2), (std::vector<uint8_t>{4, 5}));
+
+    LoopbackTransport::Stats stats = stacks.groundLink->getStats();
+    EXPECT_EQ(stats.framesSent, 2u);
+    EXPECT_EQ(stats.bytesSent, 4u);
+    EXPECT_EQ(stats.bytesReceived, 2u);
+
+    stacks.ground.stop();
+    stacks.rocket.stop();
+}
+
+TEST(LoopbackTransportTest, DelaysDeliveryAndKeepsOrderUnderJitter) {
+    Model model;
+    model.latency = std::chrono::milliseconds(20);
+    model.jitter = std::chrono::milliseconds(5);
+    Stacks stacks(model);
+    stacks.ground.start();
+    stacks.rocket.start();
+
+    constexpr uint32_t FRAMES = 200;
+    auto sent = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < FRAMES; ++i) {
+        stacks.ground.send(numberedFrame(i, 4));
+    }
+    EXPECT_EQ(stacks.atRocket.waitFor(1, std::chrono::milliseconds(15)).size(), 0u);
+    std::vector<uint8_t> bytes = stacks.atRocket.waitFor(FRAMES * 4);
+    EXPECT_GE(std::chrono::steady_clock::now() - sent, std::chrono::milliseconds(20));
+
+    ASSERT_EQ(bytes.size(), FRAMES * 4);
+    for (uint32_t i = 0; i < FRAMES; ++i) {
+        uint32_t number;
+        std::memcpy(&number, &bytes[i * 4], sizeof(number));
+        ASSERT_EQ(number, i);
+    }
+
+    stacks.ground.stop();
+    stacks.rocket.stop();
+}
+
+TEST(LoopbackTransportTest, LosesWholeFramesAtTheLossRate) {
+    Model model;
+    model.lossRate = 0.3;
+    model.seed = 11;
+    Stacks stacks(model);
+    stacks.ground.start();
+    stacks.rocket.start();
+
+    constexpr uint32_t FRAMES = 2000;
+    for (uint32_t i = 0; i < FRAMES; ++i) {
+        stacks.ground.send(numberedFrame(i, 8));
+    }
+    // Every frame has been taken by the loop once the queue is empty
+    while (stacks.ground.getQueueDepth() > 0) {
+        std::this_thread::yield();
+    }
+    LoopbackTransport::Stats stats = stacks.groundLink->getStats();
+    EXPECT_EQ(stats.framesSent, FRAMES);
+    EXPECT_GT(stats.framesLost, FRAMES / 5);
+    EXPECT_LT(stats.framesLost, FRAMES * 2 / 5);
+
+    size_t delivered = (FRAMES - stats.framesLost) * 8;
+    std::vector<uint8_t> bytes = stacks.atRocket.waitFor(delivered);
+    ASSERT_EQ(bytes.size(), delivered);
+    uint32_t previous = 0;
+    for (size_t offset = 0; offset < bytes.size(); offset += 8) {
+        uint32_t number;
+        std::memcpy(&number, &bytes[offset], sizeof(number));
+        ASSERT_TRUE(offset == 0 || number > previous);
+        previous = number;
+    }
+
+    stacks.ground.stop();
+    stacks.rocket.stop();
+}
+
+TEST(LoopbackTransportTest, FlipsBitsAtTheBitErrorRate) {
+    Model model;
+    model.bitErrorRate = 1e-3;
+    model.seed = 5;
+    Stacks stacks(model);
+    stacks.ground.start();
+    stacks.rocket.start();
+
+    // 200 kbit of zeros; every set bit that arrives was flipped on the way
+    constexpr size_t FRAMES = 1000;
+    for (size_t i = 0; i < FRAMES; ++i) {
+        stacks.ground.send(std::vector<uint8_t>(25, 0));
+    }
+    std::vector<uint8_t> bytes = stacks.atRocket.waitFor(FRAMES * 25);
+    ASSERT_EQ(bytes.size(), FRAMES * 25);
+    uint64_t setBits = 0;
+    for (uint8_t byte : bytes) {
+        setBits += std::bitset<8>(byte).count();
+    }
+    EXPECT_EQ(setBits, stacks.groundLink->getStats().bitsFlipped);
+    EXPECT_GT(setBits, 140u);
+    EXPECT_LT(setBits, 260u);
+
+    stacks.ground.stop();
+    stacks.rocket.stop();
+}
+
+TEST(LoopbackTransportTest, SenderWaitsForAPeerThatFallsBehind) {
+    Stacks stacks;
+    stacks.ground.start();
+
+    // Far more frames than the link holds, with nobody reading yet
+    constexpr uint32_t FRAMES = 3000;
+    std::thread sender([&stacks] {
+        for (uint32_t i = 0; i < FRAMES; ++i) {
+            stacks.ground.send(numberedFrame(i, 4));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    stacks.rocket.start();
+    sender.join();
+
+    std::vector<uint8_t> bytes = stacks.atRocket.waitFor(FRAMES * 4);
+    ASSERT_EQ(bytes.size(), FRAMES * 4);
+    uint32_t last;
+    std::memcpy(&last, &bytes[bytes.size() - 4], sizeof(last));
+    EXPECT_EQ(last, FRAMES - 1);
+
+    stacks.ground.stop();
+    stacks.rocket.stop();
+}
+
+TEST(LoopbackTransportTest, DecidesLossOncePerFrameWhileThePeerLags) {
+    Model model;
+    model.lossRate = 0.3;
+    model.seed = 17;
+    Stacks stacks(model);
+    stacks.ground.start();
+
+    // The link fills while nobody reads, so frames are offered again
+    constexpr uint32_t FRAMES = 3000;
+    std::thread sender([&stacks] {
+        for (uint32_t i = 0; i < FRAMES; ++i) {
+            stacks.ground.send(numberedFrame(i, 8));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    stacks.rocket.start();
+    sender.join();
+    while (stacks.ground.getQueueDepth() > 0) {
+        std::this_thread::yield();
+    }
+
+    LoopbackTransport::Stats stats = stacks.groundLink->getStats();
+    EXPECT_EQ(stats.framesSent, FRAMES);
+    EXPECT_GT(stats.framesLost, FRAMES / 5);
+    EXPECT_LT(stats.framesLost, FRAMES * 2 / 5);
+    size_t delivered = (FRAMES - stats.framesLost) * 8;
+    EXPECT_EQ(stats.bytesSent, delivered);
+    EXPECT_EQ(stacks.atRocket.waitFor(delivered).size(), delivered);
+
+    stacks.ground.stop();
+    stacks.rocket.stop();
+}
+
+TEST(LoopbackTransportTest, RejectsInvalidModels) {
+    Model negative;
+    negative.latency = std::chrono::nanoseconds(-1);
+    EXPECT_THROW(LoopbackTransport::createPair(negative), std::invalid_argument);
+    Model lossy;
+    lossy.lossRate = 1.5;
+    EXPECT_THROW(LoopbackTransport::createPair(Model(), lossy), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace SCALPEL
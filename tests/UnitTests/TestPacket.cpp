@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include "SCALPEL/Packet.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
 
 namespace SCALPEL {
 namespace {
@@ -18,7 +22,7 @@ TEST_F(PacketTest, DefaultConstructor) {
 TEST_F(PacketTest, PayloadConstructor) {
     Packet packet(samplePayload);
     EXPECT_EQ(packet.getPayloadLength(), samplePayload.size());
-    EXPECT_EQ(packet.getPayload(), samplePayload);
+    EXPECT_EQ(packet.getPayloadVector(), samplePayload);
 }
 
 TEST_F(PacketTest, PayloadConstructorMaxLength) {
@@ -38,7 +42,7 @@ TEST_F(PacketTest, AssembleAndDisassemble) {
     Packet reconstructedPacket = Packet::disassemble(assembledData);
     
     EXPECT_EQ(reconstructedPacket.getPayloadLength(), originalPacket.getPayloadLength());
-    EXPECT_EQ(reconstructedPacket.getPayload(), originalPacket.getPayload());
+    EXPECT_EQ(reconstructedPacket.getPayloadVector(), originalPacket.getPayloadVector());
 }
 
 TEST_F(PacketTest, AssembleStartByte) {
@@ -89,7 +93,7 @@ TEST_F(PacketTest, DisassembleCOBSDecoding) {
     std::vector<uint8_t> assembledData = originalPacket.assemble();
     Packet reconstructedPacket = Packet::disassemble(assembledData);
     
-    EXPECT_EQ(reconstructedPacket.getPayload(), payloadWithStartByte);
+    EXPECT_EQ(reconstructedPacket.getPayloadVector(), payloadWithStartByte);
 }
 
 TEST_F(PacketTest, AssemblePayloadChecksum) {
@@ -124,5 +128,178 @@ TEST_F(PacketTest, EmptyPayload) {
     EXPECT_TRUE(reconstructedPacket.getPayload().empty());
 }
 
+TEST_F(PacketTest, GetPayloadSpan) {
+    Packet packet(samplePayload);
+    Span<const uint8_t> view = packet.getPayload();
+    ASSERT_EQ(view.size(), samplePayload.size());
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), samplePayload.begin()));
+}
+
+TEST_F(PacketTest, SpanConstructor) {
+    const uint8_t raw[] = {0x0A, Packet::START_BYTE, 0x0B};
+    Packet packet{Span<const uint8_t>(raw)};
+    EXPECT_EQ(packet.getPayloadVector(), std::vector<uint8_t>(std::begin(raw), std::end(raw)));
+    EXPECT_EQ(Packet::disassemble(packet.assemble()).getPayloadVector(), packet.getPayloadVector());
+}
+
+TEST_F(PacketTest, CopyIsIndependentOfSource) {
+    static_assert(std::is_trivially_copyable<Packet>::value, "Packet should be trivially copyable");
+    Packet original(samplePayload);
+    Packet copy;
+    std::memcpy(static_cast<void*>(&copy), &original, sizeof(Packet));
+    original = Packet(std::vector<uint8_t>{0x09});
+
+    EXPECT_EQ(copy.getPayloadVector(), samplePayload);
+    EXPECT_EQ(copy.assemble(), Packet(samplePayload).assemble());
+}
+
+// Packet layout built from the standalone COBS and Checksum routines, used to
+// check the fused single-pass assembler
+static std::vector<uint8_t> referenceAssemble(const std::vector<uint8_t>& payload) {
+    COBS::COBSResult encoded = COBS().encode(payload);
+    uint8_t length = static_cast<uint8_t>(payload.size());
+    std::vector<uint8_t> packet{Packet::START_BYTE};
+    packet.push_back(static_cast<uint8_t>((length & 0x3F) << 2 | Checksum::calculate2BitChecksum(length)));
+    uint8_t cobsChk = Checksum::calculate2BitChecksum(encoded.encodedPayload.data(), encoded.encodedPayload.size());
+    packet.push_back(static_cast<uint8_t>((encoded.index & 0x3F) << 2 | cobsChk));
+    packet.insert(packet.end(), encoded.encodedPayload.begin(), encoded.encodedPayload.end());
+    packet.push_back(Checksum::calculateCRC8(payload.data(), payload.size()));
+    return packet;
+}
+
+TEST_F(PacketTest, AssembleIntoMatchesReference) {
+    std::vector<std::vector<uint8_t>> payloads = {
+        {},
+        samplePayload,
+        {Packet::START_BYTE},
+        {Packet::START_BYTE, 0x00, Packet::START_BYTE, Packet::START_BYTE, 0xFF},
+        std::vector<uint8_t>(Packet::MAX_PAYLOAD_LENGTH, Packet::START_BYTE),
+        std::vector<uint8_t>(Packet::MAX_PAYLOAD_LENGTH, 0x5A),
+    };
+    for (const auto& payload : payloads) {
+        Packet packet(payload);
+        std::array<uint8_t, Packet::MAX_PACKET_LENGTH> buffer;
+        size_t length = packet.assembleInto(buffer.data(), buffer.size());
+
+        EXPECT_EQ(length, packet.getAssembledLength());
+        EXPECT_EQ(std::vector<uint8_t>(buffer.begin(), buffer.begin() + length), referenceAssemble(payload));
+        EXPECT_EQ(packet.assemble(), referenceAssemble(payload));
+    }
+}
+
+TEST_F(PacketTest, AssembleIntoBufferTooSmall) {
+    Packet packet(samplePayload);
+    std::vector<uint8_t> buffer(packet.getAssembledLength() - 1);
+    EXPECT_THROW(packet.assembleInto(buffer.data(), buffer.size()), std::length_error);
+}
+
+TEST_F(PacketTest, SetFormatRejectsInvalidParity) {
+    Packet packet(samplePayload);
+    EXPECT_THROW(packet.setFormat(PacketFormat{3}), std::invalid_argument);
+    EXPECT_THROW(packet.setFormat(PacketFormat{PacketFormat::MAX_FEC_PARITY + 2}), std::invalid_argument);
+    EXPECT_EQ(packet.getFormat(), PacketFormat{});
+}
+
+TEST_F(PacketTest, AssembleWithFecParity) {
+    for (uint8_t parity : {uint8_t{2}, uint8_t{8}, PacketFormat::MAX_FEC_PARITY}) {
+        Packet packet(std::vector<uint8_t>(Packet::MAX_PAYLOAD_LENGTH, Packet::START_BYTE), PacketFormat{parity});
+        std::vector<uint8_t> assembled = packet.assemble();
+        ASSERT_EQ(assembled.size(), packet.getAssembledLength());
+        EXPECT_LE(assembled.size(), Packet::MAX_PACKET_LENGTH);
+
+        // Extended flag in the length field, parity / 2 in the options byte
+        EXPECT_EQ((assembled[1] >> 2) & 0x3F, Packet::MAX_PAYLOAD_LENGTH | PacketFormat::EXTENDED_FLAG);
+        EXPECT_EQ((assembled[3] >> 2) & 0x3F, parity / 2);
+
+        Packet disassembled = Packet::disassemble(assembled);
+        EXPECT_EQ(disassembled.getPayloadVector(), packet.getPayloadVector());
+        EXPECT_EQ(disassembled.getFormat(), packet.getFormat());
+        EXPECT_EQ(disassembled.assemble(), assembled);
+    }
+}
+
+TEST_F(PacketTest, AssembleWithWideCRC) {
+    using Integrity = PacketFormat::Integrity;
+    for (Integrity integrity : {Integrity::Crc16, Integrity::Crc32c}) {
+        for (uint8_t parity : {uint8_t{0}, uint8_t{8}}) {
+            PacketFormat format{parity};
+            format.integrity = integrity;
+            std::vector<uint8_t> payload = {0x01, Packet::START_BYTE, 0x03, 0x04, Packet::START_BYTE};
+            Packet packet(payload, format);
+            std::vector<uint8_t> assembled = packet.assemble();
+            ASSERT_EQ(assembled.size(), packet.getAssembledLength());
+            EXPECT_EQ(assembled.size(), 4 + payload.size() + 1 + format.checksumLength() + parity);
+
+            // The mode is named in the options byte, so the receiver needs no setup
+            EXPECT_EQ((assembled[1] >> 2) & PacketFormat::EXTENDED_FLAG, PacketFormat::EXTENDED_FLAG);
+            EXPECT_EQ((assembled[3] >> 6) & 0x03, static_cast<int>(integrity));
+
+            uint32_t crc = Checksum::calculate(integrity, payload.data(), payload.size());
+            size_t checksumPosition = assembled.size() - parity - format.checksumLength();
+            EXPECT_EQ(format.readChecksum(assembled.data() + checksumPosition), crc);
+
+            Packet disassembled = Packet::disassemble(assembled);
+            EXPECT_EQ(disassembled.getPayloadVector(), payload);
+            EXPECT_EQ(disassembled.getFormat(), format);
+            EXPECT_EQ(disassembled.assemble(), assembled);
+
+            // Any damaged payload check byte is caught
+            if (parity == 0) {
+                for (size_t i = checksumPosition; i < assembled.size(); ++i) {
+                    std::vector<uint8_t> damaged = assembled;
+                    damaged[i] ^= 0x10;
+                    EXPECT_THROW(Packet::disassemble(damaged), std::runtime_error);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(PacketTest, AssembleBatchMatchesAssemble) {
+    std::vector<std::vector<uint8_t>> payloads = {
+        samplePayload, {}, std::vector<uint8_t>(Packet::MAX_PAYLOAD_LENGTH, Packet::START_BYTE), {0xAA, 0x00, 0xAA}};
+    std::vector<Span<const uint8_t>> spans(payloads.begin(), payloads.end());
+
+    for (uint8_t parity : {uint8_t{0}, uint8_t{4}}) {
+        PacketFormat format{parity};
+        Packet::OutputBuffer out;
+        size_t total = Packet::assembleBatch(spans, out, format);
+
+        std::vector<uint8_t> expected;
+        ASSERT_EQ(out.packetCount(), payloads.size());
+        for (size_t i = 0; i < payloads.size(); ++i) {
+            std::vector<uint8_t> assembled = Packet(payloads[i], format).assemble();
+            EXPECT_EQ(out.offsets[i], expected.size());
+            EXPECT_TRUE(std::equal(assembled.begin(), assembled.end(), out.packet(i).begin(), out.packet(i).end()));
+            expected.insert(expected.end(), assembled.begin(), assembled.end());
+        }
+        EXPECT_EQ(total, expected.size());
+        EXPECT_EQ(out.bytes, expected);
+    }
+}
+
+TEST_F(PacketTest, AssembleBatchReusesBuffer) {
+    std::vector<Span<const uint8_t>> spans(3, Span<const uint8_t>(samplePayload));
+    Packet::OutputBuffer out;
+    Packet::assembleBatch(spans, out);
+    size_t first = out.bytes.size();
+
+    spans.resize(1);
+    EXPECT_EQ(Packet::assembleBatch(spans, out), first / 3);
+    EXPECT_EQ(out.packetCount(), 1u);
+    EXPECT_EQ(Packet::assembleBatch(Span<const Span<const uint8_t>>(), out), 0u);
+    EXPECT_EQ(out.packetCount(), 0u);
+}
+
+TEST_F(PacketTest, AssembleBatchRejectsOversizedPayload) {
+    std::vector<uint8_t> oversized(Packet::MAX_PAYLOAD_LENGTH + 1, 0x01);
+    std::vector<Span<const uint8_t>> spans = {Span<const uint8_t>(samplePayload), Span<const uint8_t>(oversized)};
+    Packet::OutputBuffer out;
+    out.bytes = {0x42};
+    EXPECT_THROW(Packet::assembleBatch(spans, out), std::invalid_argument);
+    EXPECT_EQ(out.bytes, std::vector<uint8_t>{0x42});
+    EXPECT_THROW(Packet::assembleBatch(spans, out, PacketFormat{3}), std::invalid_argument);
+}
+
 }  // namespace
 }  // namespace SCALPEL
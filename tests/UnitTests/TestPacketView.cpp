@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/PacketView.hpp"
+#include <array>
+#include <random>
+
+namespace SCALPEL {
+namespace {
+
+class PacketViewTest : public ::testing::Test {
+protected:
+    const std::vector<uint8_t> samplePayload = {0x01, Packet::START_BYTE, 0x03, Packet::START_BYTE, 0x05};
+
+    static PacketView::Status parse(const std::vector<uint8_t>& data) {
+        PacketView view;
+        return PacketView::parse(data.data(), data.size(), view);
+    }
+};
+
+TEST_F(PacketViewTest, ParseValidPacket) {
+    std::vector<uint8_t> assembled = Packet(samplePayload).assemble();
+    PacketView view;
+    ASSERT_EQ(PacketView::parse(assembled.data(), assembled.size(), view), PacketView::Status::Ok);
+
+    EXPECT_EQ(view.getPayloadLength(), samplePayload.size());
+    EXPECT_EQ(view.getCobsIndex(), 2);
+    EXPECT_EQ(view.getChecksum(), assembled.back());
+    EXPECT_EQ(view.bytes().data(), assembled.data());
+    EXPECT_EQ(view.encodedPayload().size(), assembled.size() - 4);
+}
+
+TEST_F(PacketViewTest, DecodePayloadIntoScratch) {
+    std::vector<uint8_t> assembled = Packet(samplePayload).assemble();
+    PacketView view = PacketView::from(assembled.data(), assembled.size());
+
+    std::array<uint8_t, Packet::MAX_PAYLOAD_LENGTH> scratch;
+    size_t length = view.decodePayload(scratch);
+    EXPECT_EQ(std::vector<uint8_t>(scratch.begin(), scratch.begin() + length), samplePayload);
+
+    std::array<uint8_t, 2> tooSmall;
+    EXPECT_THROW(view.decodePayload(tooSmall), std::length_error);
+}
+
+TEST_F(PacketViewTest, ToPacketMatchesDisassemble) {
+    std::vector<uint8_t> assembled = Packet(samplePayload).assemble();
+    Packet fromView = PacketView::from(assembled.data(), assembled.size()).toPacket();
+    EXPECT_EQ(fromView.getPayloadVector(), samplePayload);
+    EXPECT_EQ(fromView.assemble(), assembled);
+}
+
+TEST_F(PacketViewTest, RejectsFramingErrors) {
+    EXPECT_EQ(parse({Packet::START_BYTE, 0x00, 0x04}), PacketView::Status::TooShort);
+
+    std::vector<uint8_t> assembled = Packet(samplePayload).assemble();
+    assembled[0] = 0x00;
+    EXPECT_EQ(parse(assembled), PacketView::Status::BadStartByte);
+    EXPECT_THROW(PacketView::from(assembled.data(), assembled.size()), std::invalid_argument);
+}
+
+TEST_F(PacketViewTest, RejectsCorruptedFields) {
+    std::vector<uint8_t> assembled = Packet(samplePayload).assemble();
+
+    std::vector<uint8_t> badLength = assembled;
+    badLength[1] ^= 0x01;
+    EXPECT_EQ(parse(badLength), PacketView::Status::BadLengthChecksum);
+
+    std::vector<uint8_t> badCobs = assembled;
+    badCobs[2] ^= 0x01;
+    EXPECT_EQ(parse(badCobs), PacketView::Status::BadCobsChecksum);
+
+    // Change the index while keeping the 2-bit checksum intact
+    std::vector<uint8_t> badIndex = assembled;
+    badIndex[2] = static_cast<uint8_t>(badIndex[2] + (1 << 2));
+    EXPECT_EQ(parse(badIndex), PacketView::Status::BadCobsIndex);
+
+    std::vector<uint8_t> badCrc = assembled;
+    badCrc.back() ^= 0xFF;
+    EXPECT_EQ(parse(badCrc), PacketView::Status::BadPayloadChecksum);
+    EXPECT_THROW(PacketView::from(badCrc.data(), badCrc.size()), std::runtime_error);
+}
+
+TEST_F(PacketViewTest, RejectsLengthMismatch) {
+    // Header claims 4 bytes while the encoded payload carries 3
+    std::vector<uint8_t> assembled = Packet(std::vector<uint8_t>{0x10, 0x20, 0x30}).assemble();
+    uint8_t claimed = 4;
+    assembled[1] = static_cast<uint8_t>(claimed << 2 | Checksum::calculate2BitChecksum(claimed));
+    EXPECT_EQ(parse(assembled), PacketView::Status::LengthMismatch);
+}
+
+TEST_F(PacketViewTest, RejectsBadOptions) {
+    std::vector<uint8_t> assembled = Packet(samplePayload, PacketFormat{8}).assemble();
+
+    std::vector<uint8_t> badChecksum = assembled;
+    badChecksum[3] ^= 0x01;
+    EXPECT_EQ(parse(badChecksum), PacketView::Status::BadOptions);
+
+    // Reserved integrity mode
+    std::vector<uint8_t> reserved = assembled;
+    uint8_t options = 0x30 | 4;
+    reserved[3] = static_cast<uint8_t>(options << 2 | Checksum::calculate2BitChecksum(options));
+    EXPECT_EQ(parse(reserved), PacketView::Status::BadOptions);
+}
+
+TEST_F(PacketViewTest, CorrectRepairsUpToHalfParityErrors) {
+    std::mt19937 rng(11);
+    for (uint8_t parity : {2, 4, 8, 16}) {
+        PacketFormat format{parity};
+        for (int trial = 0; trial < 200; ++trial) {
+            std::vector<uint8_t> payload(rng() % (Packet::MAX_PAYLOAD_LENGTH + 1));
+            for (auto& byte : payload) {
+                byte = static_cast<uint8_t>(rng());
+            }
+            std::vector<uint8_t> assembled = Packet(payload, format).assemble();
+
+            // Damage up to parity / 2 distinct bytes after START_BYTE
+            std::vector<uint8_t> damaged = assembled;
+            std::vector<size_t> positions(assembled.size() - 1);
+            for (size_t i = 0; i < positions.size(); ++i) {
+                positions[i] = i + 1;
+            }
+            std::shuffle(positions.begin(), positions.end(), rng);
+            size_t errors = rng() % (parity / 2 + 1);
+            for (size_t i = 0; i < errors; ++i) {
+                damaged[positions[i]] ^= static_cast<uint8_t>(1 + rng() % 255);
+            }
+
+            ASSERT_EQ(PacketView::correct(damaged.data(), damaged.size(), format), static_cast<int>(errors));
+            ASSERT_EQ(damaged, assembled);
+            EXPECT_EQ(PacketView::from(damaged.data(), damaged.size()).toPacket().getPayloadVector(), payload);
+        }
+    }
+}
+
+TEST_F(PacketViewTest, CorrectLeavesUncorrectablePacketUntouched) {
+    PacketFormat format{4};
+    std::vector<uint8_t> assembled = Packet(samplePayload, format).assemble();
+    std::vector<uint8_t> damaged = assembled;
+    for (size_t i = 4; i < 10; ++i) {
+        damaged[i] ^= 0x5A;
+    }
+    std::vector<uint8_t> before = damaged;
+    EXPECT_EQ(PacketView::correct(damaged.data(), damaged.size(), format), -1);
+    EXPECT_EQ(damaged, before);
+    EXPECT_NE(parse(damaged), PacketView::Status::Ok);
+}
+
+TEST_F(PacketViewTest, ViewPointsIntoLargerBuffer) {
+    std::vector<uint8_t> assembled = Packet(samplePayload).assemble();
+    std::vector<uint8_t> buffer{0xDE, 0xAD};
+    buffer.insert(buffer.end(), assembled.begin(), assembled.end());
+    buffer.push_back(0xEF);
+
+    PacketView view;
+    ASSERT_EQ(PacketView::parse(Span<const uint8_t>(buffer).subspan(2, assembled.size()), view),
+              PacketView::Status::Ok);
+    EXPECT_EQ(view.toPacket().getPayloadVector(), samplePayload);
+}
+
+}  // namespace
+}  // namespace SCALPEL
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "PhysicalLayer/RadioInterface.hpp"
+#include "SCALPEL/FrameParser.hpp"
+#include "SCALPEL/PacketView.hpp"
+
+namespace RocketLink {
+namespace Radio {
+namespace {
+
+// Radio whose frames are kept in memory: the payload of every frame sent
+// through the interleaver is recorded, and receive() passes recorded
+// payloads back through the receive side as a radio's read loop would
+class MemoryRadio : public RadioInterface {
+public:
+    explicit MemoryRadio(size_t maxBatchLength) : maxBatchLength(maxBatchLength) {}
+
+    void initialize() override {}
+    void sendPacket(const SCALPEL::Packet& packet) override {
+        sendPackets(SCALPEL::Span<const SCALPEL::Packet>(&packet, 1));
+    }
+    void sendPackets(SCALPEL::Span<const SCALPEL::Packet> packets) override {
+        if (!interleavePackets(packets)) {
+            for (const SCALPEL::Packet& packet : packets) {
+                frames.push_back(packet.assemble());
+            }
+        }
+    }
+    size_t getMaxBatchLength() const override { return maxBatchLength; }
+    bool receivePacket(SCALPEL::Packet&) override { return false; }
+    void configure(const RadioConfig&) override {}
+    void getStatus(RadioStatus&) override {}
+
+    // Payloads of the radio frames sent
+    std::vector<std::vector<uint8_t>> frames;
+
+    // Payloads of the packets in the given frames, in the order parsed
+    std::vector<std::vector<uint8_t>> receive(const std::vector<std::vector<uint8_t>>& payloads) {
+        std::vector<std::vector<uint8_t>> received;
+        SCALPEL::FrameParser parser([&received](const SCALPEL::PacketView& view, uint64_t) {
+            received.push_back(view.toPacket().getPayloadVector());
+        });
+        for (const std::vector<uint8_t>& payload : payloads) {
+            EXPECT_TRUE(deinterleave(payload, [&parser](SCALPEL::Span<const uint8_t> data) {
+                parser.feed(data);
+            }));
+        }
+        return received;
+    }
+
+protected:
+    void sendPayload(const SCALPEL::GatherFrame& payload) override {
+        EXPECT_LE(payload.size(), maxBatchLength);
+        std::vector<uint8_t> bytes(payload.size());
+        payload.copyTo(bytes.data());
+        frames.push_back(bytes);
+    }
+
+private:
+    size_t maxBatchLength;
+};
+
+std::vector<SCALPEL::Packet> makePackets(size_t count, const SCALPEL::PacketFormat& format = {}) {
+    std::vector<SCALPEL::Packet> packets;
+    for (size_t i = 0; i < count; ++i) {
+        packets.emplace_back(std::vector<uint8_t>(20, static_cast<uint8_t>(i + 1)), format);
+    }
+    return packets;
+}
+
+std::vector<std::vector<uint8_t>> payloadsOf(const std::vector<SCALPEL::Packet>& packets) {
+    std::vector<std::vector<uint8_t>> payloads;
+    for (const SCALPEL::Packet& packet : packets) {
+        payloads.push_back(packet.getPayloadVector());
+    }
+    return payloads;
+}
+
+TEST(RadioInterfaceTest, DepthOneSendsPacketsAsTheyAre) {
+    MemoryRadio radio(64);
+    EXPECT_EQ(radio.getInterleaveDepth(), 1u);
+    std::vector<SCALPEL::Packet> packets = makePackets(3);
+    radio.sendPackets(packets);
+    ASSERT_EQ(radio.frames.size(), 3u);
+    EXPECT_EQ(radio.frames[0], packets[0].assemble());
+    EXPECT_EQ(radio.receive(radio.frames), payloadsOf(packets));
+}
+
+TEST(RadioInterfaceTest, InterleavedBlocksRoundTrip) {
+    MemoryRadio radio(64);
+    radio.setInterleaveDepth(4);
+    std::vector<SCALPEL::Packet> packets = makePackets(6);
+    radio.sendPackets(packets);
+
+    // One full block went out; the last two packets wait for the next
+    size_t chunksPerBlock = (4 * SCALPEL::Packet::MAX_PACKET_LENGTH + 60) / 61;
+    EXPECT_EQ(radio.frames.size(), chunksPerBlock);
+    radio.flushInterleaver();
+    EXPECT_EQ(radio.frames.size(), 2 * chunksPerBlock);
+    EXPECT_EQ(radio.receive(radio.frames), payloadsOf(packets));
+}
+
+TEST(RadioInterfaceTest, LostFrameIsRepairedAcrossTheBlock) {
+    // Each chunk is one column of the block, so losing a frame costs every
+    // packet one byte, which the packets' parity corrects
+    const size_t depth = 8;
+    MemoryRadio radio(depth + 3);
+    radio.setInterleaveDepth(depth);
+    std::vector<SCALPEL::Packet> packets = makePackets(depth, SCALPEL::PacketFormat{2});
+    radio.sendPackets(packets);
+    ASSERT_EQ(radio.frames.size(), SCALPEL::Packet::MAX_PACKET_LENGTH);
+
+    std::vector<std::vector<uint8_t>> frames = radio.frames;
+    frames.erase(frames.begin() + 6);
+    EXPECT_EQ(radio.receive(frames), payloadsOf(packets));
+}
+
+TEST(RadioInterfaceTest, RealignsAfterLosingTheEndOfABlock) {
+    MemoryRadio radio(64);
+    radio.setInterleaveDepth(4);
+    std::vector<SCALPEL::Packet> packets = makePackets(8);
+    radio.sendPackets(packets);
+    size_t chunksPerBlock = radio.frames.size() / 2;
+
+    // Without its tail the first block still goes on, padded with fill, and
+    // the second arrives whole
+    std::vector<std::vector<uint8_t>> frames = radio.frames;
+    frames.erase(frames.begin() + static_cast<std::ptrdiff_t>(chunksPerBlock) - 1);
+    std::vector<std::vector<uint8_t>> received = radio.receive(frames);
+    std::vector<std::vector<uint8_t>> secondBlock = payloadsOf(packets);
+    secondBlock.erase(secondBlock.begin(), secondBlock.begin() + 4);
+    ASSERT_GE(received.size(), 4u);
+    EXPECT_EQ(std::vector<std::vector<uint8_t>>(received.end() - 4, received.end()), secondBlock);
+}
+
+TEST(RadioInterfaceTest, RejectsOutOfRangeDepth) {
+    MemoryRadio radio(64);
+    EXPECT_THROW(radio.setInterleaveDepth(0), std::invalid_argument);
+    EXPECT_THROW(radio.setInterleaveDepth(SCALPEL::Interleaver::MAX_DEPTH + 1), std::invalid_argument);
+    EXPECT_THROW(radio.setInterleaveDepth(2, 0x8000), std::invalid_argument);
+    EXPECT_EQ(radio.getInterleaveDepth(), 1u);
+}
+
+}  // namespace
+}  // namespace Radio
+}  // namespace RocketLink
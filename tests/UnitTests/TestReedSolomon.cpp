@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "SCALPEL/ReedSolomon.hpp"
+#include <random>
+#include <set>
+
+namespace SCALPEL {
+namespace {
+
+class ReedSolomonTest : public ::testing::Test {
+protected:
+    std::mt19937 rng{2024};
+
+    std::vector<uint8_t> randomBytes(size_t length) {
+        std::uniform_int_distribution<int> dist(0, 255);
+        std::vector<uint8_t> bytes(length);
+        for (auto& byte : bytes) {
+            byte = static_cast<uint8_t>(dist(rng));
+        }
+        return bytes;
+    }
+
+    std::vector<uint8_t> makeCodeword(const ReedSolomon& rs, size_t messageLength) {
+        std::vector<uint8_t> codeword = randomBytes(messageLength);
+        codeword.resize(messageLength + rs.getParityBytes());
+        rs.encode(codeword.data(), messageLength, codeword.data() + messageLength);
+        return codeword;
+    }
+
+    // Flip `count` distinct bytes to different values
+    void injectErrors(std::vector<uint8_t>& codeword, size_t count) {
+        std::uniform_int_distribution<size_t> position(0, codeword.size() - 1);
+        std::uniform_int_distribution<int> flip(1, 255);
+        std::set<size_t> used;
+        while (used.size() < count) {
+            size_t p = position(rng);
+            if (used.insert(p).second) {
+                codeword[p] ^= static_cast<uint8_t>(flip(rng));
+            }
+        }
+    }
+};
+
+TEST_F(ReedSolomonTest, RejectsInvalidParity) {
+    EXPECT_THROW(ReedSolomon(0), std::invalid_argument);
+    EXPECT_THROW(ReedSolomon(ReedSolomon::MAX_PARITY + 1), std::invalid_argument);
+}
+
+TEST_F(ReedSolomonTest, EncodedCodewordHasZeroSyndromes) {
+    for (uint8_t parity : {2, 8, 16, 32}) {
+        const ReedSolomon& rs = ReedSolomon::get(parity);
+        for (size_t length : {1u, 15u, 16u, 33u, 100u, 223u}) {
+            std::vector<uint8_t> codeword = makeCodeword(rs, length);
+            std::vector<uint8_t> syndromes(parity);
+            EXPECT_FALSE(rs.computeSyndromes(codeword.data(), codeword.size(), syndromes.data()));
+            EXPECT_EQ(rs.decode(codeword.data(), codeword.size()), 0);
+        }
+    }
+}
+
+TEST_F(ReedSolomonTest, EncodeRejectsOversizedCodeword) {
+    const ReedSolomon& rs = ReedSolomon::get(8);
+    std::vector<uint8_t> data(ReedSolomon::MAX_CODEWORD_LENGTH - 7);
+    std::vector<uint8_t> parity(8);
+    EXPECT_THROW(rs.encode(data.data(), data.size(), parity.data()), std::length_error);
+}
+
+TEST_F(ReedSolomonTest, VectorSyndromesMatchScalar) {
+    const ReedSolomon& rs = ReedSolomon::get(16);
+    for (size_t length = 17; length <= ReedSolomon::MAX_CODEWORD_LENGTH; length += 7) {
+        std::vector<uint8_t> data = randomBytes(length);
+        std::vector<uint8_t> fast(16), scalar(16);
+        rs.computeSyndromes(data.data(), data.size(), fast.data());
+        rs.computeSyndromesScalar(data.data(), data.size(), scalar.data());
+        EXPECT_EQ(fast, scalar) << "length " << length;
+    }
+}
+
+TEST_F(ReedSolomonTest, CorrectsUpToHalfParityErrors) {
+    for (uint8_t parity : {2, 4, 8, 16}) {
+        const ReedSolomon& rs = ReedSolomon::get(parity);
+        for (int trial = 0; trial < 200; ++trial) {
+            std::vector<uint8_t> original = makeCodeword(rs, 30);
+            std::vector<uint8_t> received = original;
+            size_t errors = static_cast<size_t>(trial) % (parity / 2 + 1);
+            injectErrors(received, errors);
+
+            EXPECT_EQ(rs.decode(received.data(), received.size()), static_cast<int>(errors));
+            EXPECT_EQ(received, original);
+        }
+    }
+}
+
+TEST_F(ReedSolomonTest, UncorrectableCodewordIsLeftUntouched) {
+    const ReedSolomon& rs = ReedSolomon::get(4);
+    int failures = 0;
+    for (int trial = 0; trial < 200; ++trial) {
+        std::vector<uint8_t> received = makeCodeword(rs, 30);
+        injectErrors(received, 5);
+        std::vector<uint8_t> before = received;
+        int result = rs.decode(received.data(), received.size());
+        if (result < 0) {
+            failures++;
+            EXPECT_EQ(received, before);
+        }
+    }
+    // Beyond the correction radius most patterns are detected as uncorrectable
+    EXPECT_GT(failures, 150);
+}
+
+}  // namespace
+}  // namespace SCALPEL
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "PhysicalLayer/TransportRadio.hpp"
+#include "SCALPEL/LoopbackTransport.hpp"
+#include <chrono>
+
+namespace RocketLink {
+namespace Radio {
+namespace {
+
+// Two radios joined by a loopback pair
+struct Radios {
+    Radios() {
+        auto pair = SCALPEL::LoopbackTransport::createPair();
+        ground = std::make_unique<TransportRadio>(std::move(pair.first));
+        rocket = std::make_unique<TransportRadio>(std::move(pair.second));
+        ground->initialize();
+        rocket->initialize();
+    }
+
+    std::unique_ptr<TransportRadio> ground;
+    std::unique_ptr<TransportRadio> rocket;
+};
+
+// Payloads of the next count packets the radio receives, waiting up to a few seconds
+std::vector<std::vector<uint8_t>> receive(TransportRadio& radio, size_t count) {
+    std::vector<std::vector<uint8_t>> payloads;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (payloads.size() < count && std::chrono::steady_clock::now() < deadline) {
+        SCALPEL::Packet packet;
+        if (radio.receivePacket(packet)) {
+            payloads.push_back(packet.getPayloadVector());
+        }
+    }
+    return payloads;
+}
+
+TEST(TransportRadioTest, PacketsCrossTheLink) {
+    Radios radios;
+    std::vector<SCALPEL::Packet> packets;
+    std::vector<std::vector<uint8_t>> payloads;
+    for (uint8_t i = 0; i < 20; ++i) {
+        payloads.emplace_back(std::vector<uint8_t>(1 + i % SCALPEL::Packet::MAX_PAYLOAD_LENGTH, i));
+        packets.emplace_back(payloads.back());
+    }
+    radios.rocket->sendPackets(packets);
+    radios.ground->sendPacket(packets[0]);
+
+    EXPECT_EQ(receive(*radios.ground, packets.size()), payloads);
+    EXPECT_EQ(receive(*radios.rocket, 1), std::vector<std::vector<uint8_t>>{payloads[0]});
+
+    RadioStatus status;
+    radios.rocket->getStatus(status);
+    EXPECT_TRUE(status.isInitialized);
+    EXPECT_EQ(status.packetsSent, packets.size());
+    EXPECT_EQ(status.packetsReceived, 1u);
+}
+
+TEST(TransportRadioTest, ReceiveTimesOutWithoutTraffic) {
+    Radios radios;
+    SCALPEL::Packet packet;
+    EXPECT_FALSE(radios.ground->receivePacket(packet));
+}
+
+TEST(TransportRadioTest, RefusesToInterleave) {
+    Radios radios;
+    radios.rocket->setInterleaveDepth(2);
+    SCALPEL::Packet packet(std::vector<uint8_t>{1, 2, 3});
+    EXPECT_THROW(radios.rocket->sendPacket(packet), RadioException);
+}
+
+}  // namespace
+}  // namespace Radio
+}  // namespace RocketLink
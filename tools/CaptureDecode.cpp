@@ -0,0 +1,93 @@
+// Decodes a recorded link capture on all cores, e.g.
+//   CaptureDecode capture.bin --threads 8 --chunks
+// Prints the statistics of each chunk with --chunks and every packet, as
+// its capture offset and hex payload, with --packets.
+
+#include "SCALPEL/CaptureDecoder.hpp"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " <capture> [--threads N] [--chunk-mb N] [--chunks] [--packets]" << std::endl;
+}
+
+void printStats(std::ostream& out, const SCALPEL::FrameParser::Stats& stats) {
+    out << stats.framesParsed << " packets, " << stats.bytesConsumed << " bytes, " << stats.bytesDiscarded
+        << " discarded, " << stats.resyncs << " resyncs, " << stats.bytesCorrected << " corrected";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string path;
+    SCALPEL::CaptureDecoder::Options options;
+    bool printChunks = false;
+    bool printPackets = false;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                options.threads = std::stoul(argv[++i]);
+            } else if (std::strcmp(argv[i], "--chunk-mb") == 0 && i + 1 < argc) {
+                options.chunkLength = std::stoul(argv[++i]) << 20;
+            } else if (std::strcmp(argv[i], "--chunks") == 0) {
+                printChunks = true;
+            } else if (std::strcmp(argv[i], "--packets") == 0) {
+                printPackets = true;
+            } else if (argv[i][0] != '-' && path.empty()) {
+                path = argv[i];
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (path.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        SCALPEL::CaptureDecoder decoder(options);
+        auto start = std::chrono::steady_clock::now();
+        SCALPEL::FrameParser::Stats total = decoder.decodeFile(path, [&](SCALPEL::CaptureDecoder::ChunkResult& chunk) {
+            if (printChunks) {
+                std::cout << "chunk " << chunk.index << " @" << chunk.offset << ": ";
+                printStats(std::cout, chunk.stats);
+                std::cout << '\n';
+            }
+            if (printPackets) {
+                for (size_t i = 0; i < chunk.packets.size(); ++i) {
+                    std::cout << chunk.packetOffsets[i] << ':' << std::hex << std::setfill('0');
+                    for (uint8_t byte : chunk.packets[i].getPayload()) {
+                        std::cout << ' ' << std::setw(2) << static_cast<int>(byte);
+                    }
+                    std::cout << std::dec << '\n';
+                }
+            }
+        });
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cerr << "total: ";
+        printStats(std::cerr, total);
+        std::cerr << "\n" << decoder.getThreadCount() << " threads, " << std::fixed << std::setprecision(3)
+                  << seconds << " s, " << static_cast<double>(total.bytesConsumed) / seconds / 1e6 << " MB/s"
+                  << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}